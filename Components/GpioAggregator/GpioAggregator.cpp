@@ -0,0 +1,105 @@
+// ======================================================================
+// \title  GpioAggregator.cpp
+// \brief  cpp file for GpioAggregator component implementation class
+// ======================================================================
+
+#include <Components/GpioAggregator/GpioAggregator.hpp>
+#include <FpConfig.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Utils/PortTrace/PortTrace.hpp>
+
+namespace Components {
+
+static_assert(GpioAggregator::MAX_LINES == GpioAggregator::NUM_GPIOWRITENOW_INPUT_PORTS,
+              "Immediate and batched writes must cover the same lines");
+static_assert(GpioAggregator::MAX_LINES <= 64, "Lines must fit a batched write mask");
+
+// ----------------------------------------------------------------------
+// Construction, initialization, and destruction
+// ----------------------------------------------------------------------
+
+GpioAggregator ::GpioAggregator(const char* const compName)
+    : GpioAggregatorComponentBase(compName),
+      requested(0),
+      pending(0),
+      shadow(0),
+      writes(0),
+      dropped(0),
+      driverWrites(0) {}
+
+GpioAggregator ::~GpioAggregator() {}
+
+// ----------------------------------------------------------------------
+// Handler implementations for user-defined typed input ports
+// ----------------------------------------------------------------------
+
+void GpioAggregator ::gpioWrite_handler(const NATIVE_INT_TYPE portNum, const Fw::Logic& state) {
+    PORT_TRACE_SCOPE("GpioAggregator.gpioWrite", static_cast<U32>(portNum));
+    const U64 line = static_cast<U64>(1) << portNum;
+    const U64 before = this->request(portNum, state);
+    if (((before & line) != 0) == (Fw::Logic::HIGH == state)) {
+        this->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // A line changed back before the flush is filtered out by the flush
+    this->pending.fetch_or(line, std::memory_order_release);
+}
+
+void GpioAggregator ::gpioWriteNow_handler(const NATIVE_INT_TYPE portNum, const Fw::Logic& state) {
+    PORT_TRACE_SCOPE("GpioAggregator.gpioWriteNow", static_cast<U32>(portNum));
+    const U64 line = static_cast<U64>(1) << portNum;
+    (void)this->request(portNum, state);
+    if (!this->writeLines(line, (Fw::Logic::HIGH == state) ? line : 0)) {
+        this->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void GpioAggregator ::flush_handler(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+    PORT_TRACE_SCOPE("GpioAggregator.flush", static_cast<U32>(context));
+    // Only lines whose requested level differs from the driver's are written
+    const U64 mask = this->pending.exchange(0, std::memory_order_acq_rel);
+    if (mask != 0) {
+        (void)this->writeLines(mask, this->requested.load(std::memory_order_acquire));
+    }
+
+    const U32 received = this->writes.load(std::memory_order_relaxed);
+    const U32 written = this->driverWrites.load(std::memory_order_relaxed);
+    this->tlmWrite_GpioWrites(received);
+    this->tlmWrite_GpioWritesDropped(this->dropped.load(std::memory_order_relaxed));
+    this->tlmWrite_GpioDriverWrites(written);
+    this->tlmWrite_GpioWritesSaved(received - written);
+}
+
+// ----------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------
+
+U64 GpioAggregator ::request(const NATIVE_INT_TYPE portNum, const Fw::Logic& state) {
+    FW_ASSERT(portNum >= 0 && static_cast<U32>(portNum) < MAX_LINES, portNum);
+    const U64 line = static_cast<U64>(1) << portNum;
+    this->writes.fetch_add(1, std::memory_order_relaxed);
+    return (Fw::Logic::HIGH == state) ? this->requested.fetch_or(line, std::memory_order_acq_rel)
+                                      : this->requested.fetch_and(~line, std::memory_order_acq_rel);
+}
+
+bool GpioAggregator ::writeLines(U64 mask, U64 values) {
+    // The PWM thread and the flush both write, without locking. The changed lines are claimed in the shadow with a
+    // compare-and-swap, so a concurrent write to other lines is never lost, and only the claimed lines are written.
+    // Masked writes of different lines leave the driver in the same state whatever order they arrive in.
+    U64 levels = this->shadow.load(std::memory_order_acquire);
+    U64 changed = 0;
+    do {
+        changed = mask & (values ^ levels);
+        if (0 == changed) {
+            return false;
+        }
+    } while (!this->shadow.compare_exchange_weak(levels, (levels & ~changed) | (values & changed),
+                                                 std::memory_order_acq_rel, std::memory_order_acquire));
+    if (this->isConnected_gpioBatchWrite_OutputPort(0)) {
+        this->gpioBatchWrite_out(0, changed, values & changed);
+    }
+    this->driverWrites.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+}  // end namespace Components
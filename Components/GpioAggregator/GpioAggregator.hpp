@@ -0,0 +1,81 @@
+// ======================================================================
+// \title  GpioAggregator.hpp
+// \brief  hpp file for GpioAggregator component implementation class
+// ======================================================================
+
+#ifndef GpioAggregator_HPP
+#define GpioAggregator_HPP
+
+#include "Components/GpioAggregator/GpioAggregatorComponentAc.hpp"
+
+#include <atomic>
+
+namespace Components {
+
+class GpioAggregator : public GpioAggregatorComponentBase {
+  public:
+    //! Number of lines aggregated, bit N of a batched write being line N
+    static const U32 MAX_LINES = NUM_GPIOWRITE_INPUT_PORTS;
+
+    // ----------------------------------------------------------------------
+    // Construction, initialization, and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct object GpioAggregator. Lines are assumed low, as left by the GPIO driver when it opens them.
+    //!
+    GpioAggregator(const char* const compName /*!< The component name*/
+    );
+
+    //! Destroy object GpioAggregator
+    //!
+    ~GpioAggregator();
+
+  PRIVATE:
+    // ----------------------------------------------------------------------
+    // Handler implementations for user-defined typed input ports
+    // ----------------------------------------------------------------------
+
+    //! Handler implementation for gpioWrite
+    //!
+    void gpioWrite_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                           const Fw::Logic& state         /*!< The line state*/
+    );
+
+    //! Handler implementation for gpioWriteNow
+    //!
+    void gpioWriteNow_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                              const Fw::Logic& state         /*!< The line state*/
+    );
+
+    //! Handler implementation for flush
+    //!
+    void flush_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                       NATIVE_UINT_TYPE context       /*!< The call order*/
+    );
+
+    //! Record the level requested for a line
+    //!
+    //! \return requested levels before the update
+    U64 request(const NATIVE_INT_TYPE portNum, const Fw::Logic& state);
+
+    //! Write the lines whose level differs from the shadow to the driver, and update the shadow. Never blocks. A line
+    //! must not be written from two threads at once: it is handed from one writer to the other, as the Led hands its
+    //! line between the PWM timer thread and the rate group.
+    //!
+    //! \return true when the driver was written, false when every line was already at its level
+    bool writeLines(U64 mask,   /*!< Lines written*/
+                    U64 values  /*!< Line states, only the bits in mask are used*/
+    );
+
+    // Written from the rate group thread and any immediate producer's thread, so every member is atomic
+    std::atomic<U64> requested;      //! Levels last requested for each line, bit N for line N
+    std::atomic<U64> pending;        //! Lines written through gpioWrite since the last flush
+    std::atomic<U64> shadow;         //! Levels written to the driver, updated before the driver write
+    std::atomic<U32> writes;         //! Line writes received
+    std::atomic<U32> dropped;        //! Line writes that left the line at its current level
+    std::atomic<U32> driverWrites;   //! Writes made to the driver
+};
+
+}  // end namespace Components
+
+#endif
@@ -0,0 +1,25 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "Tester.hpp"
+
+TEST(Nominal, TestRedundantWrites) {
+    Components::Tester tester;
+    tester.testRedundantWrites();
+}
+
+TEST(Nominal, TestBatchedFlush) {
+    Components::Tester tester;
+    tester.testBatchedFlush();
+}
+
+TEST(Nominal, TestImmediateWrites) {
+    Components::Tester tester;
+    tester.testImmediateWrites();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
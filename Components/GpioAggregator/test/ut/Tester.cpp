@@ -0,0 +1,106 @@
+// ======================================================================
+// \title  GpioAggregator/test/ut/Tester.cpp
+// \brief  cpp file for GpioAggregator test harness implementation class
+// ======================================================================
+
+#include "Tester.hpp"
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+// Construction and destruction
+// ----------------------------------------------------------------------
+
+Tester ::Tester() : GpioAggregatorGTestBase("Tester", Tester::MAX_HISTORY_SIZE), component("GpioAggregator") {
+    this->initComponents();
+    this->connectPorts();
+}
+
+Tester ::~Tester() {}
+
+// ----------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------
+
+void Tester ::testRedundantWrites() {
+    // Line 0 high twice, line 1 low while already low, then line 0 low and back high within the cycle
+    this->invoke_to_gpioWrite(0, Fw::Logic::HIGH);
+    this->invoke_to_gpioWrite(0, Fw::Logic::HIGH);
+    this->invoke_to_gpioWrite(1, Fw::Logic::LOW);
+    this->invoke_to_gpioWrite(0, Fw::Logic::LOW);
+    this->invoke_to_gpioWrite(0, Fw::Logic::HIGH);
+    ASSERT_from_gpioBatchWrite_SIZE(0);
+
+    this->invoke_to_flush(0, 0);
+    ASSERT_from_gpioBatchWrite_SIZE(1);
+    ASSERT_from_gpioBatchWrite(0, 0x1, 0x1);
+    ASSERT_TLM_GpioWrites(0, 5);
+    ASSERT_TLM_GpioWritesDropped(0, 2);
+    ASSERT_TLM_GpioDriverWrites(0, 1);
+    ASSERT_TLM_GpioWritesSaved(0, 4);
+
+    // A cycle without changes writes nothing
+    this->invoke_to_gpioWrite(0, Fw::Logic::HIGH);
+    this->invoke_to_flush(0, 0);
+    ASSERT_from_gpioBatchWrite_SIZE(1);
+    ASSERT_TLM_GpioWritesDropped(1, 3);
+    ASSERT_TLM_GpioWritesSaved(1, 5);
+}
+
+void Tester ::testBatchedFlush() {
+    // Every line set high in one cycle is one driver write
+    for (NATIVE_INT_TYPE line = 0; line < static_cast<NATIVE_INT_TYPE>(GpioAggregator::MAX_LINES); line++) {
+        this->invoke_to_gpioWrite(line, Fw::Logic::HIGH);
+    }
+    this->invoke_to_flush(0, 0);
+    ASSERT_from_gpioBatchWrite_SIZE(1);
+    ASSERT_from_gpioBatchWrite(0, 0xFF, 0xFF);
+
+    // A line toggled and restored within a cycle is not written
+    this->invoke_to_gpioWrite(3, Fw::Logic::LOW);
+    this->invoke_to_gpioWrite(3, Fw::Logic::HIGH);
+    this->invoke_to_flush(0, 0);
+    ASSERT_from_gpioBatchWrite_SIZE(1);
+
+    // Only the changed lines are in the mask
+    this->invoke_to_gpioWrite(2, Fw::Logic::LOW);
+    this->invoke_to_gpioWrite(5, Fw::Logic::LOW);
+    this->invoke_to_flush(0, 0);
+    ASSERT_from_gpioBatchWrite_SIZE(2);
+    ASSERT_from_gpioBatchWrite(1, 0x24, 0x0);
+    ASSERT_TLM_GpioWrites(2, 12);
+    ASSERT_TLM_GpioDriverWrites(2, 2);
+    ASSERT_TLM_GpioWritesSaved(2, 10);
+}
+
+void Tester ::testImmediateWrites() {
+    this->invoke_to_gpioWriteNow(0, Fw::Logic::HIGH);
+    ASSERT_from_gpioBatchWrite_SIZE(1);
+    ASSERT_from_gpioBatchWrite(0, 0x1, 0x1);
+    this->invoke_to_gpioWriteNow(0, Fw::Logic::HIGH);
+    ASSERT_from_gpioBatchWrite_SIZE(1);
+
+    // A batched write of the level just set immediately is dropped
+    this->invoke_to_gpioWrite(0, Fw::Logic::HIGH);
+
+    // A pending batched change overtaken by an immediate write is not written again at the flush
+    this->invoke_to_gpioWrite(0, Fw::Logic::LOW);
+    this->invoke_to_gpioWriteNow(0, Fw::Logic::LOW);
+    ASSERT_from_gpioBatchWrite_SIZE(2);
+    ASSERT_from_gpioBatchWrite(1, 0x1, 0x0);
+    this->invoke_to_flush(0, 0);
+    ASSERT_from_gpioBatchWrite_SIZE(2);
+    ASSERT_TLM_GpioWrites(0, 5);
+    ASSERT_TLM_GpioWritesDropped(0, 2);
+    ASSERT_TLM_GpioDriverWrites(0, 2);
+}
+
+// ----------------------------------------------------------------------
+// Handlers for typed from ports
+// ----------------------------------------------------------------------
+
+void Tester ::from_gpioBatchWrite_handler(const NATIVE_INT_TYPE portNum, U64 mask, U64 values) {
+    this->pushFromPortEntry_gpioBatchWrite(mask, values);
+}
+
+}  // end namespace Components
@@ -0,0 +1,87 @@
+// ======================================================================
+// \title  GpioAggregator/test/ut/Tester.hpp
+// \brief  hpp file for GpioAggregator test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "Components/GpioAggregator/GpioAggregator.hpp"
+#include "GTestBase.hpp"
+
+namespace Components {
+
+class Tester : public GpioAggregatorGTestBase {
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+  public:
+    // Maximum size of histories storing events, telemetry, and port outputs
+    static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 10;
+    // Instance ID supplied to the component instance under test
+    static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+
+    //! Construct object Tester
+    //!
+    Tester();
+
+    //! Destroy object Tester
+    //!
+    ~Tester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    //! Writes leaving a line at its level are dropped and counted as saved
+    //!
+    void testRedundantWrites();
+
+    //! Lines changed during a cycle are set by one driver write at the flush
+    //!
+    void testBatchedFlush();
+
+    //! Immediate writes reach the driver at once and keep the shadow used by the flush
+    //!
+    void testImmediateWrites();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handlers for typed from ports
+    // ----------------------------------------------------------------------
+
+    //! Handler for from_gpioBatchWrite
+    //!
+    void from_gpioBatchWrite_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                                     U64 mask,                      /*!< Lines written*/
+                                     U64 values                     /*!< Line states*/
+    );
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper methods
+    // ----------------------------------------------------------------------
+
+    //! Connect ports
+    //!
+    void connectPorts();
+
+    //! Initialize components
+    //!
+    void initComponents();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Variables
+    // ----------------------------------------------------------------------
+
+    //! The component under test
+    //!
+    GpioAggregator component;
+};
+
+}  // end namespace Components
+
+#endif
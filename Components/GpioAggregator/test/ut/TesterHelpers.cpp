@@ -0,0 +1,45 @@
+// ======================================================================
+// \title  GpioAggregator/test/ut/TesterHelpers.cpp
+// \author Auto-generated
+// \brief  cpp file for GpioAggregator component test harness base class
+//
+// NOTE: this file was automatically generated
+//
+// ======================================================================
+#include "Tester.hpp"
+
+namespace Components {
+// ----------------------------------------------------------------------
+// Helper methods
+// ----------------------------------------------------------------------
+
+void Tester ::connectPorts() {
+    // gpioWrite
+    for (NATIVE_INT_TYPE i = 0; i < 8; ++i) {
+        this->connect_to_gpioWrite(i, this->component.get_gpioWrite_InputPort(i));
+    }
+
+    // gpioWriteNow
+    for (NATIVE_INT_TYPE i = 0; i < 8; ++i) {
+        this->connect_to_gpioWriteNow(i, this->component.get_gpioWriteNow_InputPort(i));
+    }
+
+    // flush
+    this->connect_to_flush(0, this->component.get_flush_InputPort(0));
+
+    // gpioBatchWrite
+    this->component.set_gpioBatchWrite_OutputPort(0, this->get_from_gpioBatchWrite(0));
+
+    // timeCaller
+    this->component.set_timeCaller_OutputPort(0, this->get_from_timeCaller(0));
+
+    // tlmOut
+    this->component.set_tlmOut_OutputPort(0, this->get_from_tlmOut(0));
+}
+
+void Tester ::initComponents() {
+    this->init();
+    this->component.init(Tester::TEST_INSTANCE_ID);
+}
+
+}  // end namespace Components
@@ -0,0 +1,51 @@
+// ======================================================================
+// \title  EdgeRing.cpp
+// \brief  cpp file for a lock-free ring of timestamped GPIO edges
+// ======================================================================
+
+#include <Components/GpioChipDriver/EdgeRing.hpp>
+
+namespace Components {
+
+static_assert((EdgeRing::CAPACITY & (EdgeRing::CAPACITY - 1)) == 0, "EdgeRing capacity must be a power of two");
+
+EdgeRing ::EdgeRing() : m_next(0) {
+    for (U32 i = 0; i < CAPACITY; i++) {
+        this->m_slots[i].sequence.store(0, std::memory_order_relaxed);
+        this->m_slots[i].timestamp.store(0, std::memory_order_relaxed);
+        this->m_slots[i].line.store(0, std::memory_order_relaxed);
+        this->m_slots[i].level.store(0, std::memory_order_relaxed);
+    }
+}
+
+void EdgeRing ::push(const Edge& edge) {
+    const U64 sequence = this->m_next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = this->m_slots[sequence & (CAPACITY - 1)];
+
+    // Slot sequence is 2n + 1 while edge n is written and 2n + 2 once it is complete
+    slot.sequence.store((2 * sequence) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp.store(edge.timestamp, std::memory_order_relaxed);
+    slot.line.store(edge.line, std::memory_order_relaxed);
+    slot.level.store(edge.level, std::memory_order_relaxed);
+    slot.sequence.store((2 * sequence) + 2, std::memory_order_release);
+}
+
+U64 EdgeRing ::getTotal() const {
+    return this->m_next.load(std::memory_order_acquire);
+}
+
+bool EdgeRing ::read(U64 sequence, Edge& edge) const {
+    const Slot& slot = this->m_slots[sequence & (CAPACITY - 1)];
+    const U64 complete = (2 * sequence) + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != complete) {
+        return false;
+    }
+    edge.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+    edge.line = slot.line.load(std::memory_order_relaxed);
+    edge.level = slot.level.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return (slot.sequence.load(std::memory_order_relaxed) == complete);
+}
+
+}  // end namespace Components
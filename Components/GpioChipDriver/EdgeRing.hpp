@@ -0,0 +1,64 @@
+// ======================================================================
+// \title  EdgeRing.hpp
+// \brief  hpp file for a lock-free ring of timestamped GPIO edges
+// ======================================================================
+
+#ifndef EdgeRing_HPP
+#define EdgeRing_HPP
+
+#include <FpConfig.hpp>
+
+#include <atomic>
+
+namespace Components {
+
+//! \class EdgeRing
+//! \brief Lock-free, fixed-capacity ring of GPIO edges
+//!
+//! Any number of threads may push concurrently without locking: each claims a slot with one atomic increment. Once
+//! full, the oldest edges are overwritten. Readers copy edges out with a per-slot sequence check, skipping any slot
+//! being rewritten while it is read.
+class EdgeRing {
+  public:
+    //! Number of edges retained, a power of two
+    static const U32 CAPACITY = 4096;
+
+    //! An edge of one line
+    struct Edge {
+        U64 timestamp;  //!< Monotonic time of the edge in nanoseconds
+        U32 line;       //!< Index of the line
+        U32 level;      //!< Level after the edge: 1 high, 0 low
+    };
+
+    EdgeRing();
+
+    //! Append an edge, overwriting the oldest when full
+    //!
+    void push(const Edge& edge);
+
+    //! \return total number of edges pushed, including any since overwritten
+    U64 getTotal() const;
+
+    //! Copy out the edge with the given sequence number (0 for the first edge pushed)
+    //!
+    //! \return true when the edge is still retained and was read consistently
+    bool read(U64 sequence, /*!< Sequence number of the edge*/
+              Edge& edge    /*!< Out: the edge*/
+    ) const;
+
+  PRIVATE:
+    //! Storage of one edge. The sequence is odd while the slot is being written.
+    struct Slot {
+        std::atomic<U64> sequence;
+        std::atomic<U64> timestamp;
+        std::atomic<U32> line;
+        std::atomic<U32> level;
+    };
+
+    std::atomic<U64> m_next;  //!< Sequence number of the next edge pushed
+    Slot m_slots[CAPACITY];   //!< Ring storage
+};
+
+}  // end namespace Components
+
+#endif
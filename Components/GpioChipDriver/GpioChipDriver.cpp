@@ -0,0 +1,188 @@
+// ======================================================================
+// \title  GpioChipDriver.cpp
+// \brief  cpp file for GpioChipDriver component implementation class
+// ======================================================================
+
+#include <Components/GpioChipDriver/GpioChipDriver.hpp>
+#include <FpConfig.hpp>
+#include <Os/File.hpp>
+#include <Utils/PortTrace/PortTrace.hpp>
+
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <time.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+// Construction, initialization, and destruction
+// ----------------------------------------------------------------------
+
+GpioChipDriver ::GpioChipDriver(const char* const compName)
+    : GpioChipDriverComponentBase(compName), lineFd(-1), numLines(0), simulated(false), simLevels(0) {}
+
+GpioChipDriver ::~GpioChipDriver() {
+    this->close();
+}
+
+bool GpioChipDriver ::open(const char* chip, const U32* offsets, U32 count) {
+    FW_ASSERT(chip != nullptr);
+    FW_ASSERT(offsets != nullptr);
+    FW_ASSERT((count > 0) && (count <= MAX_LINES), count);
+    this->close();
+
+    int chipFd = ::open(chip, O_RDWR | O_CLOEXEC);
+    if (chipFd < 0) {
+        Fw::LogStringArg chipArg(chip);
+        this->log_WARNING_HI_OpenError(chipArg, errno);
+        return false;
+    }
+
+    // Request every line as an output in one request so that they share a single file descriptor
+    gpio_v2_line_request request;
+    memset(&request, 0, sizeof(request));
+    for (U32 i = 0; i < count; i++) {
+        request.offsets[i] = offsets[i];
+    }
+    (void)strncpy(request.consumer, "fprime", sizeof(request.consumer) - 1);
+    request.config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+    request.num_lines = count;
+
+    int status = ::ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &request);
+    int error = errno;
+    (void)::close(chipFd);
+    if (status < 0) {
+        Fw::LogStringArg chipArg(chip);
+        this->log_WARNING_HI_OpenError(chipArg, error);
+        return false;
+    }
+    this->lineFd = request.fd;
+    this->numLines = count;
+    return true;
+}
+
+void GpioChipDriver ::openSimulated(U32 count) {
+    FW_ASSERT((count > 0) && (count <= MAX_LINES), count);
+    this->close();
+    this->simLevels.store(0);
+    this->numLines = count;
+    this->simulated = true;
+}
+
+void GpioChipDriver ::close() {
+    if (this->lineFd >= 0) {
+        (void)::close(this->lineFd);
+    }
+    this->lineFd = -1;
+    this->numLines = 0;
+    this->simulated = false;
+}
+
+const EdgeRing& GpioChipDriver ::getEdges() const {
+    return this->edges;
+}
+
+bool GpioChipDriver ::setLines(U64 mask, U64 values) {
+    PORT_TRACE_SCOPE("GpioChipDriver.setLines", static_cast<U32>(mask));
+    // Lines outside the request are ignored
+    const U64 valid = (this->numLines >= 64) ? ~static_cast<U64>(0) : ((static_cast<U64>(1) << this->numLines) - 1);
+    gpio_v2_line_values lineValues;
+    lineValues.mask = mask & valid;
+    lineValues.bits = values & lineValues.mask;
+    if (this->simulated) {
+        this->simulateLines(lineValues.mask, lineValues.bits);
+        return true;
+    }
+    if ((this->lineFd < 0) || (0 == lineValues.mask)) {
+        return (0 == lineValues.mask);
+    }
+    if (::ioctl(this->lineFd, GPIO_V2_LINE_SET_VALUES_IOCTL, &lineValues) < 0) {
+        this->log_WARNING_HI_WriteError(errno);
+        return false;
+    }
+    return true;
+}
+
+void GpioChipDriver ::simulateLines(U64 mask, U64 values) {
+    timespec now;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    // Update the levels without locking so that concurrent writers never block each other
+    U64 previous = this->simLevels.load(std::memory_order_relaxed);
+    U64 updated = 0;
+    do {
+        updated = (previous & ~mask) | (values & mask);
+    } while (!this->simLevels.compare_exchange_weak(previous, updated, std::memory_order_relaxed));
+
+    EdgeRing::Edge edge;
+    edge.timestamp = (static_cast<U64>(now.tv_sec) * 1000000000) + static_cast<U64>(now.tv_nsec);
+    const U64 changed = previous ^ updated;
+    for (U32 line = 0; line < this->numLines; line++) {
+        if ((changed >> line) & 1) {
+            edge.line = line;
+            edge.level = static_cast<U32>((updated >> line) & 1);
+            this->edges.push(edge);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+// Command handler implementations
+// ----------------------------------------------------------------------
+
+void GpioChipDriver ::DUMP_EDGES_cmdHandler(const FwOpcodeType opCode,
+                                            const U32 cmdSeq,
+                                            const Fw::CmdStringArg& fileName) {
+    Fw::LogStringArg fileArg(fileName.toChar());
+    Os::File file;
+    if (Os::File::OP_OK != file.open(fileName.toChar(), Os::File::OPEN_WRITE)) {
+        this->log_WARNING_HI_EdgeDumpError(fileArg);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+
+    // Only the most recent CAPACITY edges are retained; any being overwritten during the dump are skipped
+    const U64 total = this->edges.getTotal();
+    const U64 first = (total > EdgeRing::CAPACITY) ? (total - EdgeRing::CAPACITY) : 0;
+    U32 count = 0;
+    bool ok = true;
+    for (U64 sequence = first; ok && (sequence < total); sequence++) {
+        EdgeRing::Edge edge;
+        if (this->edges.read(sequence, edge)) {
+            char row[64];
+            NATIVE_INT_TYPE length = snprintf(row, sizeof(row), "%llu,%u,%u\n",
+                                              static_cast<unsigned long long>(edge.timestamp), edge.line, edge.level);
+            ok = (Os::File::OP_OK == file.write(row, length));
+            count++;
+        }
+    }
+    file.close();
+
+    if (!ok) {
+        this->log_WARNING_HI_EdgeDumpError(fileArg);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->log_ACTIVITY_HI_EdgesDumped(count, fileArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+// ----------------------------------------------------------------------
+// Handler implementations for user-defined typed input ports
+// ----------------------------------------------------------------------
+
+void GpioChipDriver ::gpioWrite_handler(const NATIVE_INT_TYPE portNum, const Fw::Logic& state) {
+    const U64 line = static_cast<U64>(1) << portNum;
+    (void)this->setLines(line, (Fw::Logic::HIGH == state) ? line : 0);
+}
+
+void GpioChipDriver ::gpioBatchWrite_handler(const NATIVE_INT_TYPE portNum, U64 mask, U64 values) {
+    (void)this->setLines(mask, values);
+}
+
+}  // end namespace Components
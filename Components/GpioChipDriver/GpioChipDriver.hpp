@@ -0,0 +1,105 @@
+// ======================================================================
+// \title  GpioChipDriver.hpp
+// \brief  hpp file for GpioChipDriver component implementation class
+// ======================================================================
+
+#ifndef GpioChipDriver_HPP
+#define GpioChipDriver_HPP
+
+#include "Components/GpioChipDriver/EdgeRing.hpp"
+#include "Components/GpioChipDriver/GpioChipDriverComponentAc.hpp"
+
+#include <atomic>
+
+namespace Components {
+
+class GpioChipDriver : public GpioChipDriverComponentBase {
+  public:
+    //! Maximum number of lines held by the request
+    static const U32 MAX_LINES = NUM_GPIOWRITE_INPUT_PORTS;
+
+    // ----------------------------------------------------------------------
+    // Construction, initialization, and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct object GpioChipDriver
+    //!
+    GpioChipDriver(const char* const compName /*!< The component name*/
+    );
+
+    //! Destroy object GpioChipDriver, releasing the lines
+    //!
+    ~GpioChipDriver();
+
+    //! Request lines of a GPIO chip as outputs, initially low. Line index N of the request (port number N of gpioWrite,
+    //! bit N of gpioBatchWrite) is the line at offsets[N].
+    //!
+    //! \return true when all lines were requested
+    bool open(const char* chip,      /*!< Path of the chip device, e.g. /dev/gpiochip0*/
+              const U32* offsets,    /*!< Offsets of the lines on the chip*/
+              U32 count              /*!< Number of lines, at most MAX_LINES*/
+    );
+
+    //! Simulate lines instead of driving a device. Every change of a line's level is captured in the edge ring with a
+    //! monotonic timestamp. Lines start low.
+    //!
+    void openSimulated(U32 count /*!< Number of lines, at most MAX_LINES*/
+    );
+
+    //! Release the lines
+    //!
+    void close();
+
+    //! \return ring of edges captured by simulated lines
+    const EdgeRing& getEdges() const;
+
+    //! Set several lines with a single ioctl
+    //!
+    //! \return true on success
+    bool setLines(U64 mask,   /*!< Lines written: bit N selects line index N*/
+                  U64 values  /*!< Line states: bit N set drives line index N high*/
+    );
+
+  PRIVATE:
+    // ----------------------------------------------------------------------
+    // Command handler implementations
+    // ----------------------------------------------------------------------
+
+    //! Implementation for DUMP_EDGES command handler
+    //! Write the edges captured by simulated lines to a file
+    void DUMP_EDGES_cmdHandler(const FwOpcodeType opCode,       /*!< The opcode*/
+                               const U32 cmdSeq,                /*!< The command sequence number*/
+                               const Fw::CmdStringArg& fileName /*!< Path of the file written*/
+    );
+
+  PRIVATE:
+    // ----------------------------------------------------------------------
+    // Handler implementations for user-defined typed input ports
+    // ----------------------------------------------------------------------
+
+    //! Handler implementation for gpioWrite
+    //!
+    void gpioWrite_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                           const Fw::Logic& state         /*!< The line state*/
+    );
+
+    //! Handler implementation for gpioBatchWrite
+    //!
+    void gpioBatchWrite_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                                U64 mask,                      /*!< Lines written*/
+                                U64 values                     /*!< Line states*/
+    );
+
+    //! Set simulated lines, capturing an edge for each line whose level changes
+    void simulateLines(U64 mask, U64 values);
+
+    int lineFd;                     //! File descriptor of the line request, -1 when closed
+    U32 numLines;                   //! Number of lines held by the request
+    bool simulated;                 //! Flag: if true lines are simulated rather than driven
+    std::atomic<U64> simLevels;     //! Levels of the simulated lines, bit N for line index N
+    EdgeRing edges;                 //! Edges captured by simulated lines
+};
+
+}  // end namespace Components
+
+#endif
@@ -0,0 +1,30 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "Tester.hpp"
+
+TEST(OffNominal, TestOpenError) {
+    Components::Tester tester;
+    tester.testOpenError();
+}
+
+TEST(OffNominal, TestWriteClosed) {
+    Components::Tester tester;
+    tester.testWriteClosed();
+}
+
+TEST(Nominal, TestSimulatedEdges) {
+    Components::Tester tester;
+    tester.testSimulatedEdges();
+}
+
+TEST(Performance, TestLatency) {
+    Components::Tester tester;
+    tester.testLatency();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,154 @@
+// ======================================================================
+// \title  GpioChipDriver/test/ut/Tester.cpp
+// \brief  cpp file for GpioChipDriver test harness implementation class
+// ======================================================================
+
+#include "Tester.hpp"
+
+#include <Utils/TestFile/TestFile.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Components {
+
+namespace {
+//! Average nanoseconds per iteration of a timed loop
+template <typename Body>
+double timePerIteration(U32 iterations, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < iterations; i++) {
+        body(i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return static_cast<double>(elapsed.count()) / iterations;
+}
+}  // namespace
+
+// ----------------------------------------------------------------------
+// Construction and destruction
+// ----------------------------------------------------------------------
+
+Tester ::Tester() : GpioChipDriverGTestBase("Tester", Tester::MAX_HISTORY_SIZE), component("GpioChipDriver") {
+    this->initComponents();
+    this->connectPorts();
+}
+
+Tester ::~Tester() {}
+
+// ----------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------
+
+void Tester ::testOpenError() {
+    const U32 offsets[] = {13};
+    ASSERT_FALSE(this->component.open("/dev/does-not-exist", offsets, 1));
+    ASSERT_EVENTS_OpenError_SIZE(1);
+}
+
+void Tester ::testWriteClosed() {
+    this->invoke_to_gpioWrite(0, Fw::Logic::HIGH);
+    ASSERT_FALSE(this->component.setLines(0x1, 0x1));
+    // An empty mask is trivially satisfied
+    ASSERT_TRUE(this->component.setLines(0x0, 0x0));
+    ASSERT_EVENTS_WriteError_SIZE(0);
+}
+
+void Tester ::testSimulatedEdges() {
+    this->component.openSimulated(2);
+
+    // Line 0: low->high, repeated high (no edge), high->low. Then both lines high in one batched write.
+    this->invoke_to_gpioWrite(0, Fw::Logic::HIGH);
+    this->invoke_to_gpioWrite(0, Fw::Logic::HIGH);
+    this->invoke_to_gpioWrite(0, Fw::Logic::LOW);
+    this->invoke_to_gpioBatchWrite(0, 0x3, 0x3);
+
+    const EdgeRing& edges = this->component.getEdges();
+    ASSERT_EQ(edges.getTotal(), 4u);
+    const U32 expected[][2] = {{0, 1}, {0, 0}, {0, 1}, {1, 1}};
+    U64 previous = 0;
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(expected); i++) {
+        EdgeRing::Edge edge;
+        ASSERT_TRUE(edges.read(i, edge));
+        ASSERT_EQ(edge.line, expected[i][0]);
+        ASSERT_EQ(edge.level, expected[i][1]);
+        ASSERT_GE(edge.timestamp, previous);
+        previous = edge.timestamp;
+    }
+
+    // Dump the edges as one row each
+    const Utils::TestFile dumpFile("GpioChipDriverEdges.csv");
+    const char* const dump = dumpFile.get();
+    this->sendCmd_DUMP_EDGES(0, 0, Fw::CmdStringArg(dump));
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, GpioChipDriver::OPCODE_DUMP_EDGES, 0, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_EdgesDumped_SIZE(1);
+    ASSERT_EVENTS_EdgesDumped(0, 4, dump);
+
+    FILE* file = fopen(dump, "r");
+    ASSERT_NE(file, nullptr);
+    unsigned long long timestamp = 0;
+    U32 line = 0;
+    U32 level = 0;
+    U32 rows = 0;
+    while (fscanf(file, "%llu,%u,%u\n", &timestamp, &line, &level) == 3) {
+        ASSERT_EQ(line, expected[rows][0]);
+        ASSERT_EQ(level, expected[rows][1]);
+        rows++;
+    }
+    (void)fclose(file);
+    ASSERT_EQ(rows, 4u);
+
+    // A file that cannot be created fails the command
+    this->sendCmd_DUMP_EDGES(0, 1, Fw::CmdStringArg("/does-not-exist/edges.csv"));
+    ASSERT_CMD_RESPONSE(1, GpioChipDriver::OPCODE_DUMP_EDGES, 1, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_EdgeDumpError_SIZE(1);
+}
+
+void Tester ::testLatency() {
+    const char* chip = getenv("GPIO_SIM_CHIP");
+    if (chip == nullptr) {
+        GTEST_SKIP() << "GPIO_SIM_CHIP not set, e.g. GPIO_SIM_CHIP=/dev/gpiochip1 for a gpio-sim chip with 4 lines";
+    }
+    const U32 offsets[] = {0, 1, 2, 3};
+    ASSERT_TRUE(this->component.open(chip, offsets, FW_NUM_ARRAY_ELEMENTS(offsets)));
+
+    // One line toggled per write, through the port as Led drives it
+    double single = timePerIteration(LATENCY_ITERATIONS, [this](U32 i) {
+        this->invoke_to_gpioWrite(0, (i & 1) ? Fw::Logic::HIGH : Fw::Logic::LOW);
+    });
+    // Four lines updated one write at a time, against four lines updated with one batched write
+    double fourSingle = timePerIteration(LATENCY_ITERATIONS, [this](U32 i) {
+        for (NATIVE_INT_TYPE line = 0; line < 4; line++) {
+            this->invoke_to_gpioWrite(line, (i & 1) ? Fw::Logic::HIGH : Fw::Logic::LOW);
+        }
+    });
+    double fourBatched = timePerIteration(LATENCY_ITERATIONS, [this](U32 i) {
+        this->invoke_to_gpioBatchWrite(0, 0xF, (i & 1) ? 0xF : 0x0);
+    });
+    ASSERT_EVENTS_WriteError_SIZE(0);
+
+    (void)printf("[GPIO LATENCY] chardev 1 line:          %10.1f ns/update\n", single);
+    (void)printf("[GPIO LATENCY] chardev 4 lines, 4 ioctl: %10.1f ns/update\n", fourSingle);
+    (void)printf("[GPIO LATENCY] chardev 4 lines, 1 ioctl: %10.1f ns/update\n", fourBatched);
+
+    // The legacy sysfs path formats the value and writes it to the line's value file
+    const char* sysfs = getenv("GPIO_SIM_SYSFS_VALUE");
+    if (sysfs != nullptr) {
+        int fd = ::open(sysfs, O_WRONLY);
+        ASSERT_GE(fd, 0) << "Failed to open " << sysfs;
+        double legacy = timePerIteration(LATENCY_ITERATIONS, [fd](U32 i) {
+            char buffer[4];
+            int length = snprintf(buffer, sizeof(buffer), "%d", static_cast<int>(i & 1));
+            (void)::lseek(fd, 0, SEEK_SET);
+            ssize_t written = ::write(fd, buffer, static_cast<size_t>(length));
+            (void)written;
+        });
+        (void)::close(fd);
+        (void)printf("[GPIO LATENCY] sysfs 1 line:            %10.1f ns/update\n", legacy);
+    }
+}
+
+}  // end namespace Components
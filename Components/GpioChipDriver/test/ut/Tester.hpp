@@ -0,0 +1,82 @@
+// ======================================================================
+// \title  GpioChipDriver/test/ut/Tester.hpp
+// \brief  hpp file for GpioChipDriver test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "Components/GpioChipDriver/GpioChipDriver.hpp"
+#include "GTestBase.hpp"
+
+namespace Components {
+
+class Tester : public GpioChipDriverGTestBase {
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+  public:
+    // Maximum size of histories storing events, telemetry, and port outputs
+    static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 10;
+    // Instance ID supplied to the component instance under test
+    static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+    // Writes timed per measurement in the latency comparison
+    static const U32 LATENCY_ITERATIONS = 10000;
+
+    //! Construct object Tester
+    //!
+    Tester();
+
+    //! Destroy object Tester
+    //!
+    ~Tester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    //! Opening a missing chip fails and reports an error
+    //!
+    void testOpenError();
+
+    //! Writes before open fail without touching any device
+    //!
+    void testWriteClosed();
+
+    //! Simulated lines capture one timestamped edge per level change and dump them to a file
+    //!
+    void testSimulatedEdges();
+
+    //! Compare write latency of single-line, batched and sysfs writes. Requires a gpio-sim chip named by the
+    //! GPIO_SIM_CHIP environment variable, and optionally a sysfs value file named by GPIO_SIM_SYSFS_VALUE.
+    //!
+    void testLatency();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper methods
+    // ----------------------------------------------------------------------
+
+    //! Connect ports
+    //!
+    void connectPorts();
+
+    //! Initialize components
+    //!
+    void initComponents();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Variables
+    // ----------------------------------------------------------------------
+
+    //! The component under test
+    //!
+    GpioChipDriver component;
+};
+
+}  // end namespace Components
+
+#endif
@@ -0,0 +1,188 @@
+// ======================================================================
+// \title  BlinkPattern.cpp
+// \brief  cpp file for blink patterns compiled to a run-length table
+// ======================================================================
+
+#include <Components/Led/BlinkPattern.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <cctype>
+#include <limits>
+
+namespace Components {
+
+namespace {
+//! Morse codes of A to Z
+const char* const MORSE_LETTERS[] = {".-",   "-...", "-.-.", "-..",  ".",   "..-.", "--.",  "....", "..",
+                                     ".---", "-.-",  ".-..", "--",   "-.",  "---",  ".--.", "--.-", ".-.",
+                                     "...",  "-",    "..-",  "...-", ".--", "-..-", "-.--", "--.."};
+//! Morse codes of 0 to 9
+const char* const MORSE_DIGITS[] = {"-----", ".----", "..---", "...--", "....-",
+                                    ".....", "-....", "--...", "---..", "----."};
+}  // namespace
+
+BlinkPattern ::BlinkPattern()
+    : m_count(0), m_index(0), m_status(OK), m_number(0), m_digits(false) {}
+
+BlinkPattern::Status BlinkPattern ::compileMorse(const char* text, U32 unit) {
+    FW_ASSERT(text != nullptr);
+    this->m_count = 0;
+    this->m_status = (unit == 0) ? INVALID : OK;
+
+    bool letters = false;
+    bool word = false;
+    for (const char* c = text; (*c != '\0') && (OK == this->m_status); c++) {
+        const int upper = toupper(static_cast<unsigned char>(*c));
+        if (' ' == upper) {
+            word = letters;
+            continue;
+        }
+        const char* code = nullptr;
+        if ((upper >= 'A') && (upper <= 'Z')) {
+            code = MORSE_LETTERS[upper - 'A'];
+        } else if ((upper >= '0') && (upper <= '9')) {
+            code = MORSE_DIGITS[upper - '0'];
+        } else {
+            this->m_status = INVALID;
+            break;
+        }
+        if (letters) {
+            this->append(false, (word ? 7 : 3) * unit);
+        }
+        for (const char* symbol = code; *symbol != '\0'; symbol++) {
+            if (symbol != code) {
+                this->append(false, unit);
+            }
+            this->append(true, (('-' == *symbol) ? 3 : 1) * unit);
+        }
+        letters = true;
+        word = false;
+    }
+    if (letters) {
+        this->append(false, 7 * unit);
+    }
+    return this->finish();
+}
+
+BlinkPattern::Status BlinkPattern ::compileHeartbeat(U32 unit) {
+    this->m_count = 0;
+    this->m_status = (unit == 0) ? INVALID : OK;
+    this->append(true, unit);
+    this->append(false, unit);
+    this->append(true, unit);
+    this->append(false, 7 * unit);
+    return this->finish();
+}
+
+BlinkPattern::Status BlinkPattern ::compileRuns(const char* text) {
+    FW_ASSERT(text != nullptr);
+    this->beginRuns();
+    U32 length = 0;
+    while (text[length] != '\0') {
+        length++;
+    }
+    this->parseRuns(text, length);
+    return this->endRuns();
+}
+
+void BlinkPattern ::beginRuns() {
+    this->m_count = 0;
+    this->m_status = OK;
+    this->m_number = 0;
+    this->m_digits = false;
+}
+
+void BlinkPattern ::parseRuns(const char* text, U32 length) {
+    FW_ASSERT(text != nullptr);
+    for (U32 i = 0; (i < length) && (OK == this->m_status); i++) {
+        const char c = text[i];
+        if ((c >= '0') && (c <= '9')) {
+            const U32 digit = static_cast<U32>(c - '0');
+            if (this->m_number > ((std::numeric_limits<U32>::max() - digit) / 10)) {
+                this->m_status = INVALID;
+            }
+            this->m_number = (this->m_number * 10) + digit;
+            this->m_digits = true;
+        } else if ((',' == c) || isspace(static_cast<unsigned char>(c))) {
+            if (this->m_digits) {
+                // Runs alternate, so each number has the level its position implies and is never merged
+                this->m_status = (0 == this->m_number) ? INVALID : this->m_status;
+                this->append((this->m_count % 2) == 0, this->m_number);
+            }
+            this->m_number = 0;
+            this->m_digits = false;
+        } else {
+            this->m_status = INVALID;
+        }
+    }
+}
+
+BlinkPattern::Status BlinkPattern ::endRuns() {
+    this->parseRuns(",", 1);
+    return this->finish();
+}
+
+void BlinkPattern ::clear() {
+    this->m_count = 0;
+    this->rewind();
+}
+
+void BlinkPattern ::rewind() {
+    this->m_index = 0;
+}
+
+U32 BlinkPattern ::nextRun(bool& level) {
+    FW_ASSERT(this->m_count > 0);
+    const U32 run = this->m_runs[this->m_index];
+    level = (this->m_index % 2) == 0;
+    this->m_index = ((this->m_index + 1) >= this->m_count) ? 0 : (this->m_index + 1);
+    return run;
+}
+
+U32 BlinkPattern ::getCount() const {
+    return this->m_count;
+}
+
+U32 BlinkPattern ::getRun(U32 index) const {
+    FW_ASSERT(index < this->m_count, index, this->m_count);
+    return this->m_runs[index];
+}
+
+U64 BlinkPattern ::getLength() const {
+    U64 length = 0;
+    for (U32 i = 0; i < this->m_count; i++) {
+        length = length + this->m_runs[i];
+    }
+    return length;
+}
+
+void BlinkPattern ::append(bool level, U32 ticks) {
+    if (OK != this->m_status) {
+        return;
+    }
+    if ((this->m_count > 0) && (((this->m_count - 1) % 2 == 0) == level)) {
+        const U32 last = this->m_runs[this->m_count - 1];
+        this->m_status = (ticks > (std::numeric_limits<U32>::max() - last)) ? INVALID : OK;
+        this->m_runs[this->m_count - 1] = last + ticks;
+    } else if (this->m_count >= MAX_RUNS) {
+        this->m_status = TOO_LONG;
+    } else {
+        // Patterns built here always start on, so run 0 is never an off run
+        FW_ASSERT((this->m_count > 0) || level);
+        this->m_runs[this->m_count] = ticks;
+        this->m_count = this->m_count + 1;
+    }
+}
+
+BlinkPattern::Status BlinkPattern ::finish() {
+    if ((OK == this->m_status) && (0 == this->m_count)) {
+        this->m_status = EMPTY;
+    }
+    if (OK != this->m_status) {
+        this->m_count = 0;
+    }
+    this->rewind();
+    return this->m_status;
+}
+
+}  // end namespace Components
@@ -0,0 +1,108 @@
+// ======================================================================
+// \title  BlinkPattern.hpp
+// \brief  hpp file for blink patterns compiled to a run-length table
+// ======================================================================
+
+#ifndef BlinkPattern_HPP
+#define BlinkPattern_HPP
+
+#include <FpConfig.hpp>
+
+namespace Components {
+
+//! \class BlinkPattern
+//! \brief A repeating on/off pattern compiled once into a run-length table and replayed a run at a time
+//!
+//! Runs alternate between on and off, starting on: run 0 is on, run 1 off, and so on. Compiling merges adjacent runs of
+//! the same level, so moving to the next run only advances an index whatever the pattern length.
+class BlinkPattern {
+  public:
+    //! Maximum number of runs in a table
+    static const U32 MAX_RUNS = 1024;
+
+    //! Result of compiling a pattern. On any error the table is left empty.
+    enum Status {
+        OK,        //!< Pattern compiled
+        EMPTY,     //!< Pattern has no on time
+        TOO_LONG,  //!< Pattern needs more than MAX_RUNS runs
+        INVALID    //!< Pattern text or arguments cannot be compiled
+    };
+
+    BlinkPattern();
+
+    //! Compile Morse code: dot 1 unit on, dash 3 on, 1 off between symbols, 3 between letters, 7 between words and
+    //! before repeating. Letters, digits and spaces are accepted.
+    //!
+    //! \return status of compiling
+    Status compileMorse(const char* text, /*!< Text to send, null terminated*/
+                        U32 unit          /*!< Ticks per Morse unit*/
+    );
+
+    //! Compile a heartbeat: two 1 unit flashes 1 unit apart, then 7 units off
+    //!
+    //! \return status of compiling
+    Status compileHeartbeat(U32 unit /*!< Ticks per unit*/
+    );
+
+    //! Compile a run-length list of tick counts separated by commas or whitespace, starting with an on run
+    //!
+    //! \return status of compiling
+    Status compileRuns(const char* text /*!< The list, null terminated*/
+    );
+
+    //! Start compiling a run-length list supplied in pieces, e.g. while reading a file
+    //!
+    void beginRuns();
+
+    //! Compile the next piece of a run-length list. A number may be split across pieces.
+    //!
+    void parseRuns(const char* text, /*!< The piece*/
+                   U32 length        /*!< Number of characters in the piece*/
+    );
+
+    //! Finish compiling a run-length list supplied in pieces
+    //!
+    //! \return status of compiling
+    Status endRuns();
+
+    //! Discard the table
+    //!
+    void clear();
+
+    //! Restart the pattern from run 0
+    //!
+    void rewind();
+
+    //! Move past the current run. Table must not be empty.
+    //!
+    //! \return length of the run in ticks
+    U32 nextRun(bool& level /*!< Out: level of the run, true for on*/
+    );
+
+    //! \return number of runs in the table, 0 when empty
+    U32 getCount() const;
+
+    //! \return length of a run in ticks
+    U32 getRun(U32 index) const;
+
+    //! \return ticks in one repetition of the pattern
+    U64 getLength() const;
+
+  PRIVATE:
+    //! Append a run, merging it into the previous run when both have the same level
+    void append(bool level, U32 ticks);
+
+    //! Finish compiling, emptying the table on error
+    Status finish();
+
+    U32 m_runs[MAX_RUNS];  //!< Run lengths in ticks
+    U32 m_count;           //!< Number of runs
+    U32 m_index;           //!< Current run
+    Status m_status;       //!< Status of the compile in progress
+    U32 m_number;          //!< Number being parsed from a run-length list
+    bool m_digits;         //!< Flag: if true m_number holds at least one digit
+};
+
+}  // end namespace Components
+
+#endif
@@ -6,32 +6,174 @@
 
 #include <Components/Led/Led.hpp>
 #include <FpConfig.hpp>
+#include <Os/File.hpp>
+#include <Utils/PortTrace/PortTrace.hpp>
+
+#include <time.h>
+#include <cerrno>
+#include <limits>
 
 namespace Components {
 
+namespace {
+//! Saturate a timing error in microseconds to the range of telemetry
+I32 saturate(I64 value) {
+    return static_cast<I32>((value > std::numeric_limits<I32>::max())   ? std::numeric_limits<I32>::max()
+                            : (value < std::numeric_limits<I32>::min()) ? std::numeric_limits<I32>::min()
+                                                                         : value);
+}
+
+//! Convert running statistics to their telemetry representation
+LedJitterStats toJitterStats(const RunningStats& stats) {
+    return LedJitterStats(stats.getCount(), saturate(stats.getMin()), saturate(stats.getMax()),
+                          static_cast<F32>(stats.getMean()), static_cast<F32>(stats.getStdDev()));
+}
+
+//! Read a clock in nanoseconds
+U64 readClock(clockid_t clock) {
+    struct timespec now;
+    (void)clock_gettime(clock, &now);
+    return (static_cast<U64>(now.tv_sec) * 1000000000) + static_cast<U64>(now.tv_nsec);
+}
+
+//! Sleep until an absolute monotonic time in nanoseconds
+void sleepUntil(U64 deadline) {
+    struct timespec wake;
+    wake.tv_sec = static_cast<time_t>(deadline / 1000000000);
+    wake.tv_nsec = static_cast<long>(deadline % 1000000000);
+    while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr)) {
+    }
+}
+}  // namespace
+
 // ----------------------------------------------------------------------
 // Construction, initialization, and destruction
 // ----------------------------------------------------------------------
 
 Led ::Led(const char* const compName)
-    : LedComponentBase(compName), state(Fw::On::OFF), transitions(0), count(0), blinking(false) {}
+    : LedComponentBase(compName), state(Fw::On::OFF),
+      transitions(0),
+      blinking(false),
+      recorder(nullptr),
+      ticks(0),
+      lastCycle(0),
+      nextEdgeTick(0),
+      phaseStartTick(0),
+      nextPhase(Fw::On::ON),
+      intervalChanged(false),
+      wakePending(false),
+      edgeAnchored(false),
+      anchorTime(0),
+      anchorTick(0),
+      lastEdgeTime(0),
+      lastEdgeTick(0),
+      histogram(0),
+      patternLoading(false),
+      patternOpCode(0),
+      patternCmdSeq(0),
+      pwm(false),
+      pwmDuty(0),
+      pwmFrequency(0),
+      pwmPriority(Os::Task::TASK_DEFAULT),
+      pwmStackSize(Os::Task::TASK_DEFAULT),
+      pwmCpuAffinity(Os::Task::TASK_DEFAULT),
+      pwmThreadState(PWM_IDLE),
+      pwmEdges(0),
+      pwmOverruns(0),
+      pwmCpuTime(0) {}
 
-Led ::~Led() {}
+Led ::~Led() {
+    this->stopPwm();
+    if (this->patternLoading) {
+        this->patternFile.close();
+    }
+}
 
 void Led ::parameterUpdated(FwPrmIdType id) {
-    // Read back the parameter value
-    Fw::ParamValid isValid;
-    U32 interval = this->paramGet_BLINK_INTERVAL(isValid);
-    // NOTE: isValid is always
-    FW_ASSERT(isValid == Fw::ParamValid::VALID, isValid);
-
+    if (this->recorder != nullptr) {
+        this->recordParameter(id);
+    }
     // Check the parameter ID is expected
     if (PARAMID_BLINK_INTERVAL == id) {
+        // Read back the parameter value
+        Fw::ParamValid isValid;
+        U32 interval = this->paramGet_BLINK_INTERVAL(isValid);
+        // NOTE: isValid is always
+        FW_ASSERT(isValid == Fw::ParamValid::VALID, isValid);
         {
             // Emit the blink set event
             this->log_ACTIVITY_HI_BlinkIntervalSet(interval);
         }
     }
+    // Parameters may be set from another thread, so the rate group thread is only told to reschedule the next edge
+    if (PARAMID_BLINK_INTERVAL == id) {
+        this->intervalChanged.store(true, std::memory_order_release);
+        this->requestWakeup();
+    }
+    // Both the interval and the tick period change the ideal edge schedule, which is anchored again at the next edge
+    if ((PARAMID_BLINK_INTERVAL == id) || (PARAMID_TICK_PERIOD == id)) {
+        this->edgeAnchored.store(false, std::memory_order_release);
+    }
+}
+
+void Led ::setRecorder(Utils::PortRecorder* recorder) {
+    this->recorder = recorder;
+}
+
+template <typename... Args>
+void Led ::recordCommand(FwOpcodeType opCode, U32 cmdSeq, const Args&... args) {
+    if (this->recorder == nullptr) {
+        return;
+    }
+    // Arguments are serialized in order, as the ground serializes them into the command argument buffer. The autocoded
+    // cmdIn callback is not reachable from here, so each command handler records itself through this one helper.
+    Fw::CmdArgBuffer buffer;
+    const Fw::SerializeStatus statuses[] = {Fw::FW_SERIALIZE_OK, buffer.serialize(args)...};
+    static_cast<void>(statuses);
+    Utils::PortArgs record;
+    (void)record.serialize(static_cast<U32>(opCode - this->getIdBase()));
+    (void)record.serialize(cmdSeq);
+    (void)record.serialize(buffer);
+    this->recorder->record(RECORDED_COMMAND, this->getTime(), record);
+}
+
+void Led ::recordParameter(FwPrmIdType id) {
+    // Parameter updates arrive as set commands, which are not dispatched to a handler
+    const FwOpcodeType idBase = this->getIdBase();
+    Fw::ParamValid isValid;
+    switch (id) {
+        case PARAMID_BLINK_INTERVAL:
+            this->recordCommand(idBase + OPCODE_BLINK_INTERVAL_SET, 0, this->paramGet_BLINK_INTERVAL(isValid));
+            break;
+        case PARAMID_TICK_PERIOD:
+            this->recordCommand(idBase + OPCODE_TICK_PERIOD_SET, 0, this->paramGet_TICK_PERIOD(isValid));
+            break;
+        case PARAMID_PWM_DUTY:
+            this->recordCommand(idBase + OPCODE_PWM_DUTY_SET, 0, this->paramGet_PWM_DUTY(isValid));
+            break;
+        case PARAMID_PWM_FREQUENCY:
+            this->recordCommand(idBase + OPCODE_PWM_FREQUENCY_SET, 0, this->paramGet_PWM_FREQUENCY(isValid));
+            break;
+        default:
+            // Every parameter in Led.fpp must be recorded
+            FW_ASSERT(0, id);
+            break;
+    }
+}
+
+void Led ::configurePwm(NATIVE_UINT_TYPE priority, NATIVE_UINT_TYPE stackSize, NATIVE_UINT_TYPE cpuAffinity) {
+    this->pwmPriority = priority;
+    this->pwmStackSize = stackSize;
+    this->pwmCpuAffinity = cpuAffinity;
+}
+
+void Led ::stopPwm() {
+    U8 expected = PWM_RUNNING;
+    (void)this->pwmThreadState.compare_exchange_strong(expected, PWM_STOPPING, std::memory_order_acq_rel);
+    if (PWM_IDLE != this->pwmThreadState.load(std::memory_order_acquire)) {
+        (void)this->pwmThread.join(nullptr);
+        this->pwmThreadState.store(PWM_IDLE, std::memory_order_release);
+    }
 }
 
 // ----------------------------------------------------------------------
@@ -39,6 +181,155 @@ void Led ::parameterUpdated(FwPrmIdType id) {
 // ----------------------------------------------------------------------
 
 void Led ::run_handler(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+    PORT_TRACE_SCOPE("Led.run", static_cast<U32>(context));
+    // Tick of this call. A rate group skipping idle cycles passes the cycle number, from which skipped ticks are counted.
+    if (this->isConnected_wakeup_OutputPort(0)) {
+        this->ticks = this->ticks + (static_cast<U32>(context) - this->lastCycle);
+        this->lastCycle = static_cast<U32>(context);
+    } else {
+        this->ticks = this->ticks + 1;
+    }
+
+    // Drain commands queued since the last tick. They execute here on the rate group thread, so the state below is
+    // only ever touched by one thread and needs no lock. Wakeups requested from here on are checked again below.
+    this->wakePending.store(false, std::memory_order_relaxed);
+    while (Fw::QueuedComponentBase::MSG_DISPATCH_OK == this->doDispatch()) {
+    }
+    this->joinPwm();
+
+    // Record the tick after the commands it dispatched so that replay preserves their order
+    if (this->recorder != nullptr) {
+        Utils::PortArgs args;
+        (void)args.serialize(static_cast<U32>(context));
+        this->recorder->record(RECORDED_RUN, this->getTime(), args);
+    }
+
+    if (this->patternLoading) {
+        this->loadPatternChunks();
+    }
+
+    if (this->pwm) {
+        this->updatePwm();
+    }
+
+    // Only perform actions when set to blinking and the PWM timer thread is not driving the LED
+    if (this->blinking && !this->pwm && this->pwmReleased()) {
+        // An interval change moves the end of the current square wave phase, to now at the earliest
+        if (this->intervalChanged.load(std::memory_order_acquire)) {
+            this->intervalChanged.store(false, std::memory_order_relaxed);
+            if ((0 == this->pattern.getCount()) && (this->nextEdgeTick > this->phaseStartTick)) {
+                const Fw::On phase = (Fw::On::ON == this->nextPhase) ? Fw::On::OFF : Fw::On::ON;
+                const U64 end = this->phaseStartTick + this->phaseLength(phase);
+                this->nextEdgeTick = (end > this->ticks) ? end : this->ticks;
+            }
+        }
+
+        // Ticks before the next edge only count. Parameters and the pattern are read once per edge.
+        if (this->ticks >= this->nextEdgeTick) {
+            Fw::On new_state = this->nextPhase;
+            U32 length = 0;
+            if (this->pattern.getCount() > 0) {
+                bool level = false;
+                length = this->pattern.nextRun(level);
+                new_state = level ? Fw::On::ON : Fw::On::OFF;
+            } else {
+                length = this->phaseLength(new_state);
+                this->nextPhase = (Fw::On::ON == new_state) ? Fw::On::OFF : Fw::On::ON;
+            }
+            this->phaseStartTick = this->ticks;
+            this->nextEdgeTick = this->ticks + length;
+
+            // A transition has occurred
+            if (this->state != new_state) {
+                this->transitions = this->transitions + 1;
+                this->tlmWrite_LedTransitions(this->transitions);
+
+                // Port may not be connected, so check before sending output
+                if (this->isConnected_gpioSet_OutputPort(0)) {
+                    this->gpioSet_out(0, (Fw::On::ON == new_state) ? Fw::Logic::HIGH : Fw::Logic::LOW);
+                }
+                this->recordEdgeTiming();
+
+                this->log_ACTIVITY_LO_LedState(new_state);
+                this->state = new_state;
+            }
+        }
+    }
+
+    // Declare the next tick with work due: the next edge while blinking, every tick in PWM mode or while a pattern file
+    // loads, otherwise none. A preMsgHook runs before its message is queued, so a wakeup it requested while the queue
+    // was drained may have been overridden by the delay sent here: the next tick is kept while one is pending.
+    // Declaring none cancels any wakeup pending on the rate group, including one requested since the check, so the
+    // check is made again.
+    if (this->isConnected_wakeup_OutputPort(0)) {
+        U32 delay = WAKEUP_NEVER;
+        const bool wake = this->wakePending.exchange(false, std::memory_order_acq_rel) ||
+                          (this->m_queue.getNumMsgs() > 0);
+        if (wake || this->pwm || !this->pwmReleased() || this->patternLoading) {
+            delay = 1;
+        } else if (this->blinking) {
+            const U64 remaining = this->nextEdgeTick - this->ticks;
+            delay = (remaining < WAKEUP_NEVER) ? static_cast<U32>(remaining) : (WAKEUP_NEVER - 1);
+        }
+        this->wakeup_out(0, delay);
+        if ((WAKEUP_NEVER == delay) && this->wakePending.exchange(false, std::memory_order_acq_rel)) {
+            this->wakeup_out(0, 1);
+        }
+    }
+}
+
+void Led ::loadPatternChunks() {
+    // A bounded part of the file is read per tick so that a long pattern file cannot overrun the rate group cycle
+    char chunk[PATTERN_FILE_CHUNK];
+    for (U32 i = 0; i < PATTERN_FILE_CHUNKS_PER_TICK; i++) {
+        NATIVE_INT_TYPE size = sizeof(chunk);
+        const Os::File::Status readStatus = this->patternFile.read(chunk, size);
+        if (Os::File::OP_OK != readStatus) {
+            this->patternFile.close();
+            this->patternLoading = false;
+            this->pattern.clear();
+            this->log_WARNING_LO_PatternRejected(LedPatternError::FILE_ERROR);
+            this->cmdResponse_out(this->patternOpCode, this->patternCmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+            return;
+        }
+        if (size <= 0) {
+            // The finished pattern replaces the one in use, which is emptied when the file was rejected
+            const BlinkPattern::Status status = this->patternStaging.endRuns();
+            this->patternFile.close();
+            this->patternLoading = false;
+            this->pattern = this->patternStaging;
+            this->cmdResponse_out(this->patternOpCode, this->patternCmdSeq, this->patternCompiled(status));
+            return;
+        }
+        this->patternStaging.parseRuns(chunk, static_cast<U32>(size));
+    }
+}
+
+void Led ::cancelPatternFile() {
+    if (this->patternLoading) {
+        this->patternFile.close();
+        this->patternLoading = false;
+        this->log_WARNING_LO_PatternRejected(LedPatternError::CANCELLED);
+        this->cmdResponse_out(this->patternOpCode, this->patternCmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+    }
+}
+
+void Led ::requestWakeup() {
+    this->wakePending.store(true, std::memory_order_release);
+    if (this->isConnected_wakeup_OutputPort(0)) {
+        this->wakeup_out(0, 1);
+    }
+}
+
+void Led ::restartSchedule() {
+    this->pattern.rewind();
+    this->nextPhase = Fw::On::ON;
+    this->phaseStartTick = this->ticks;
+    this->nextEdgeTick = this->ticks;
+    this->edgeAnchored.store(false, std::memory_order_release);
+}
+
+U32 Led ::phaseLength(Fw::On phase) {
     // Read back the parameter value
     Fw::ParamValid isValid;
     U32 interval = this->paramGet_BLINK_INTERVAL(isValid);
@@ -46,42 +337,198 @@ void Led ::run_handler(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context)
     // Force interval to be 0 when invalid or not set
     interval = ((Fw::ParamValid::INVALID == isValid) || (Fw::ParamValid::UNINIT == isValid)) ? 0 : interval;
 
-    // Only perform actions when set to blinking
-    this->lock.lock();
-    bool is_blinking = this->blinking;
-    this->lock.unlock();
-    if (is_blinking) {
-        Fw::On new_state = this->state;
-        // Check for transitions
-        if ((0 == this->count) && (this->state == Fw::On::OFF)) {
-            new_state = Fw::On::ON;
-        } else if (((interval / 2) == this->count) && (this->state == Fw::On::ON)) {
-            new_state = Fw::On::OFF;
+    const U32 length = (Fw::On::ON == phase) ? (interval / 2) : (interval - (interval / 2));
+    return (length > 0) ? length : 1;
+}
+
+void Led ::recordEdgeTiming() {
+    const Fw::Time now = this->getTime();
+    const U64 time = (static_cast<U64>(now.getSeconds()) * 1000000) + now.getUSeconds();
+
+    // The first edge after blinking starts, or after the schedule changes, anchors the ideal schedule. The flag is set
+    // in the same step as it is read, so a parameter update clearing it from another thread is never lost.
+    if (this->edgeAnchored.exchange(true, std::memory_order_acq_rel)) {
+        Fw::ParamValid isValid;
+        U32 period = this->paramGet_TICK_PERIOD(isValid);
+        period = ((Fw::ParamValid::INVALID == isValid) || (Fw::ParamValid::UNINIT == isValid)) ? DEFAULT_TICK_PERIOD
+                                                                                                : period;
+
+        const I64 ideal = static_cast<I64>(this->anchorTime + ((this->ticks - this->anchorTick) * period));
+        const I64 deviation = static_cast<I64>(time) - ideal;
+        const I64 expected = static_cast<I64>((this->ticks - this->lastEdgeTick) * period);
+        const I64 actual = static_cast<I64>(time) - static_cast<I64>(this->lastEdgeTime);
+        this->edgeDeviation.update(deviation);
+        this->periodError.update(actual - expected);
+
+        // Histogram bins are decades of deviation magnitude starting at 10us
+        const U64 magnitude = static_cast<U64>((deviation < 0) ? -deviation : deviation);
+        U32 bin = 0;
+        for (U64 limit = 10; (bin < (LedJitterHistogram::SIZE - 1)) && (magnitude >= limit); limit *= 10) {
+            bin++;
         }
+        this->histogram[bin] = this->histogram[bin] + 1;
+
+        this->tlmWrite_EdgeDeviation(toJitterStats(this->edgeDeviation));
+        this->tlmWrite_PeriodError(toJitterStats(this->periodError));
+        this->tlmWrite_EdgeDeviationHistogram(this->histogram);
+    } else {
+        this->anchorTime = time;
+        this->anchorTick = this->ticks;
+    }
+    this->lastEdgeTime = time;
+    this->lastEdgeTick = this->ticks;
+}
+
+void Led ::updatePwm() {
+    Fw::ParamValid isValid;
+    U32 duty = this->paramGet_PWM_DUTY(isValid);
+    duty = ((Fw::ParamValid::INVALID == isValid) || (Fw::ParamValid::UNINIT == isValid)) ? DEFAULT_PWM_DUTY : duty;
+    U32 frequency = this->paramGet_PWM_FREQUENCY(isValid);
+    frequency = ((Fw::ParamValid::INVALID == isValid) || (Fw::ParamValid::UNINIT == isValid)) ? DEFAULT_PWM_FREQUENCY
+                                                                                               : frequency;
+
+    // Compile only on change so the timer thread replays a fixed table
+    if ((duty != this->pwmDuty) || (frequency != this->pwmFrequency)) {
+        PwmSchedule::Table table;
+        PwmSchedule::compile(frequency, duty, table);
+        this->pwmSchedule.publish(table);
+        this->pwmDuty = duty;
+        this->pwmFrequency = frequency;
+    }
+
+    this->tlmWrite_PwmEdges(this->pwmEdges.load(std::memory_order_relaxed));
+    this->tlmWrite_PwmOverruns(this->pwmOverruns.load(std::memory_order_relaxed));
+    this->tlmWrite_PwmCpuTime(this->pwmCpuTime.load(std::memory_order_relaxed) / 1000);
+}
+
+void Led ::setPwmLevel(const Fw::Logic& level) {
+    if (this->isConnected_gpioSetNow_OutputPort(0)) {
+        this->gpioSetNow_out(0, level);
+    } else if (this->isConnected_gpioSet_OutputPort(0)) {
+        this->gpioSet_out(0, level);
+    }
+}
+
+void Led ::pwmTask(void* led) {
+    FW_ASSERT(led != nullptr);
+    static_cast<Led*>(led)->pwmLoop();
+}
 
-        // A transition has occurred
-        if (this->state != new_state) {
-            this->transitions = this->transitions + 1;
-            this->tlmWrite_LedTransitions(this->transitions);
+void Led ::pwmLoop() {
+    // Runs on the PWM timer thread: no allocation and no locks while driving the LED, and only gpioSetNow or gpioSet is
+    // invoked
+    PwmSchedule::Table table;
+    bool level = false;
+    // The first edge after taking over the LED is always written, whatever level was left behind
+    bool takeover = true;
+    U64 start = readClock(CLOCK_MONOTONIC);
+    while (true) {
+        if (PWM_STOPPING == this->pwmThreadState.load(std::memory_order_acquire)) {
+            // Hand the LED back low so that blinking resumes from a known level, then exit unless switched on again
+            this->setPwmLevel(Fw::Logic::LOW);
+            U8 expected = PWM_STOPPING;
+            if (this->pwmThreadState.compare_exchange_strong(expected, PWM_EXITED, std::memory_order_acq_rel)) {
+                return;
+            }
+            takeover = true;
+            start = readClock(CLOCK_MONOTONIC);
+        }
 
-            // Port may not be connected, so check before sending output
-            if (this->isConnected_gpioSet_OutputPort(0)) {
-                this->gpioSet_out(0, (Fw::On::ON == new_state) ? Fw::Logic::HIGH : Fw::Logic::LOW);
+        // Schedule changes take effect at the start of a period
+        this->pwmSchedule.load(table);
+        for (U32 i = 0; i < table.count; i++) {
+            sleepUntil(start + table.offsets[i]);
+            if ((takeover && (0 == i)) || (table.levels[i] != level)) {
+                level = table.levels[i];
+                this->setPwmLevel(level ? Fw::Logic::HIGH : Fw::Logic::LOW);
+                this->pwmEdges.fetch_add(1, std::memory_order_relaxed);
             }
+        }
+        takeover = false;
 
-            this->log_ACTIVITY_LO_LedState(new_state);
-            this->state = new_state;
+        // A period that ran past the start of the next one shifts the schedule rather than bursting to catch up
+        start = start + table.period;
+        const U64 now = readClock(CLOCK_MONOTONIC);
+        if (now > start) {
+            this->pwmOverruns.fetch_add(1, std::memory_order_relaxed);
+            start = now;
         }
+        this->pwmCpuTime.store(readClock(CLOCK_THREAD_CPUTIME_ID), std::memory_order_relaxed);
+    }
+}
+
+bool Led ::enablePwm() {
+    // A thread that has not yet handed the LED back keeps driving it
+    U8 expected = PWM_STOPPING;
+    if (this->pwmThreadState.compare_exchange_strong(expected, PWM_RUNNING, std::memory_order_acq_rel)) {
+        return true;
+    }
+    if (PWM_RUNNING == expected) {
+        return true;
+    }
+    this->joinPwm();
+    this->pwmThreadState.store(PWM_RUNNING, std::memory_order_release);
+    Os::TaskString name("PwmTimer");
+    if (Os::Task::TASK_OK != this->pwmThread.start(name, Led::pwmTask, this, this->pwmPriority, this->pwmStackSize,
+                                                   this->pwmCpuAffinity)) {
+        this->pwmThreadState.store(PWM_IDLE, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
 
-        this->count = ((this->count + 1) >= interval) ? 0 : (this->count + 1);
+void Led ::joinPwm() {
+    // The thread has returned, or is returning, once it has moved itself to PWM_EXITED
+    if (PWM_EXITED == this->pwmThreadState.load(std::memory_order_acquire)) {
+        (void)this->pwmThread.join(nullptr);
+        this->pwmThreadState.store(PWM_IDLE, std::memory_order_release);
     }
 }
 
+bool Led ::pwmReleased() const {
+    const U8 state = this->pwmThreadState.load(std::memory_order_acquire);
+    return (PWM_IDLE == state) || (PWM_EXITED == state);
+}
+
+// ----------------------------------------------------------------------
+// Pre-message hooks for async commands
+// ----------------------------------------------------------------------
+
+void Led ::BLINKING_ON_OFF_preMsgHook(FwOpcodeType opCode, U32 cmdSeq) {
+    this->requestWakeup();
+}
+
+void Led ::PATTERN_MORSE_preMsgHook(FwOpcodeType opCode, U32 cmdSeq) {
+    this->requestWakeup();
+}
+
+void Led ::PATTERN_HEARTBEAT_preMsgHook(FwOpcodeType opCode, U32 cmdSeq) {
+    this->requestWakeup();
+}
+
+void Led ::PATTERN_RUNS_preMsgHook(FwOpcodeType opCode, U32 cmdSeq) {
+    this->requestWakeup();
+}
+
+void Led ::PATTERN_FILE_preMsgHook(FwOpcodeType opCode, U32 cmdSeq) {
+    this->requestWakeup();
+}
+
+void Led ::PATTERN_CLEAR_preMsgHook(FwOpcodeType opCode, U32 cmdSeq) {
+    this->requestWakeup();
+}
+
+void Led ::PWM_ON_OFF_preMsgHook(FwOpcodeType opCode, U32 cmdSeq) {
+    this->requestWakeup();
+}
+
 // ----------------------------------------------------------------------
 // Command handler implementations
 // ----------------------------------------------------------------------
 
 void Led ::BLINKING_ON_OFF_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, Fw::On on_off) {
+    PORT_TRACE_SCOPE("Led.BLINKING_ON_OFF", cmdSeq);
+    this->recordCommand(opCode, cmdSeq, on_off);
     // Create a variable to represent the command response
     auto cmdResp = Fw::CmdResponse::OK;
 
@@ -94,10 +541,8 @@ void Led ::BLINKING_ON_OFF_cmdHandler(const FwOpcodeType opCode, const U32 cmdSe
         // Update command response with a validation error
         cmdResp = Fw::CmdResponse::VALIDATION_ERROR;
     } else {
-        this->count = 0;  // Reset count on any successful command
-        this->lock.lock();
+        this->restartSchedule();                // Restart blinking, or any pattern, from its beginning
         this->blinking = Fw::On::ON == on_off;  // Update blinking state
-        this->lock.unlock();
         // NOTE: This event will be added during the "Events" exercise.
         this->log_ACTIVITY_HI_SetBlinkingState(on_off);
 
@@ -108,4 +553,113 @@ void Led ::BLINKING_ON_OFF_cmdHandler(const FwOpcodeType opCode, const U32 cmdSe
     this->cmdResponse_out(opCode, cmdSeq, cmdResp);
 }
 
+void Led ::PATTERN_MORSE_cmdHandler(const FwOpcodeType opCode,
+                                    const U32 cmdSeq,
+                                    const Fw::CmdStringArg& text,
+                                    U16 unit) {
+    PORT_TRACE_SCOPE("Led.PATTERN_MORSE", cmdSeq);
+    this->recordCommand(opCode, cmdSeq, text, unit);
+    this->cancelPatternFile();
+    const BlinkPattern::Status status = this->pattern.compileMorse(text.toChar(), unit);
+    this->cmdResponse_out(opCode, cmdSeq, this->patternCompiled(status));
+}
+
+void Led ::PATTERN_HEARTBEAT_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, U16 unit) {
+    PORT_TRACE_SCOPE("Led.PATTERN_HEARTBEAT", cmdSeq);
+    this->recordCommand(opCode, cmdSeq, unit);
+    this->cancelPatternFile();
+    const BlinkPattern::Status status = this->pattern.compileHeartbeat(unit);
+    this->cmdResponse_out(opCode, cmdSeq, this->patternCompiled(status));
+}
+
+void Led ::PATTERN_RUNS_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, const Fw::CmdStringArg& runs) {
+    PORT_TRACE_SCOPE("Led.PATTERN_RUNS", cmdSeq);
+    this->recordCommand(opCode, cmdSeq, runs);
+    this->cancelPatternFile();
+    const BlinkPattern::Status status = this->pattern.compileRuns(runs.toChar());
+    this->cmdResponse_out(opCode, cmdSeq, this->patternCompiled(status));
+}
+
+void Led ::PATTERN_FILE_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, const Fw::CmdStringArg& fileName) {
+    PORT_TRACE_SCOPE("Led.PATTERN_FILE", cmdSeq);
+    this->recordCommand(opCode, cmdSeq, fileName);
+    this->cancelPatternFile();
+    if (Os::File::OP_OK != this->patternFile.open(fileName.toChar(), Os::File::OPEN_READ)) {
+        this->pattern.clear();
+        this->log_WARNING_LO_PatternRejected(LedPatternError::FILE_ERROR);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+
+    // The file is compiled a few chunks per tick, from this tick on, so patterns of any length are read without a
+    // file-sized buffer or a long stall of the rate group. The pattern in use is kept until the file is read, and the
+    // command completes then.
+    this->patternStaging.beginRuns();
+    this->patternLoading = true;
+    this->patternOpCode = opCode;
+    this->patternCmdSeq = cmdSeq;
+}
+
+void Led ::PATTERN_CLEAR_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq) {
+    PORT_TRACE_SCOPE("Led.PATTERN_CLEAR", cmdSeq);
+    this->recordCommand(opCode, cmdSeq);
+    this->cancelPatternFile();
+    this->pattern.clear();
+    this->restartSchedule();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+Fw::CmdResponse Led ::patternCompiled(BlinkPattern::Status status) {
+    // Blinking restarts on the new pattern, or on the square wave when it was rejected
+    this->restartSchedule();
+    switch (status) {
+        case BlinkPattern::OK:
+            this->log_ACTIVITY_HI_PatternLoaded(this->pattern.getCount(), this->pattern.getLength());
+            return Fw::CmdResponse::OK;
+        case BlinkPattern::EMPTY:
+            this->log_WARNING_LO_PatternRejected(LedPatternError::EMPTY);
+            break;
+        case BlinkPattern::TOO_LONG:
+            this->log_WARNING_LO_PatternRejected(LedPatternError::TOO_LONG);
+            break;
+        default:
+            this->log_WARNING_LO_PatternRejected(LedPatternError::INVALID);
+            break;
+    }
+    return Fw::CmdResponse::VALIDATION_ERROR;
+}
+
+void Led ::PWM_ON_OFF_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, Fw::On on_off) {
+    PORT_TRACE_SCOPE("Led.PWM_ON_OFF", cmdSeq);
+    this->recordCommand(opCode, cmdSeq, on_off);
+    auto cmdResp = Fw::CmdResponse::OK;
+
+    if (!on_off.isValid()) {
+        this->log_WARNING_LO_InvalidBlinkArgument(on_off);
+        cmdResp = Fw::CmdResponse::VALIDATION_ERROR;
+    } else if (Fw::On::ON == on_off) {
+        // Publish the current parameters before the timer thread first reads the schedule
+        this->pwmFrequency = 0;
+        this->updatePwm();
+        if (this->enablePwm()) {
+            this->pwm = true;
+            this->log_ACTIVITY_HI_SetPwmState(on_off);
+            this->tlmWrite_PwmState(on_off);
+        } else {
+            cmdResp = Fw::CmdResponse::EXECUTION_ERROR;
+        }
+    } else {
+        // The timer thread leaves the LED low, so blinking restarts with a turn-on edge
+        U8 expected = PWM_RUNNING;
+        (void)this->pwmThreadState.compare_exchange_strong(expected, PWM_STOPPING, std::memory_order_acq_rel);
+        this->pwm = false;
+        this->state = Fw::On::OFF;
+        this->restartSchedule();
+        this->log_ACTIVITY_HI_SetPwmState(on_off);
+        this->tlmWrite_PwmState(on_off);
+    }
+
+    this->cmdResponse_out(opCode, cmdSeq, cmdResp);
+}
+
 }  // end namespace Components
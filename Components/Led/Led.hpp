@@ -6,13 +6,49 @@
 
 #ifndef Led_HPP
 #define Led_HPP
-#include <Os/Mutex.hpp>
+#include "Components/Led/BlinkPattern.hpp"
 #include "Components/Led/LedComponentAc.hpp"
+#include "Components/Led/PwmSchedule.hpp"
+#include "Components/Led/RunningStats.hpp"
+#include "Utils/PortRecorder/PortRecorder.hpp"
+
+#include <Os/File.hpp>
+#include <Os/Task.hpp>
+#include <atomic>
 
 namespace Components {
 
 class Led : public LedComponentBase {
   public:
+    //! Tick period assumed when TICK_PERIOD is not available, matching its default
+    static const U32 DEFAULT_TICK_PERIOD = 1000000;
+    //! PWM duty cycle assumed when PWM_DUTY is not available, matching its default
+    static const U32 DEFAULT_PWM_DUTY = 50;
+    //! PWM frequency assumed when PWM_FREQUENCY is not available, matching its default
+    static const U32 DEFAULT_PWM_FREQUENCY = 1000;
+    //! Wakeup delay declaring nothing is due until a command or parameter update arrives
+    static const U32 WAKEUP_NEVER = 0xFFFFFFFF;
+    //! Bytes of a pattern file read at a time
+    static const U32 PATTERN_FILE_CHUNK = 256;
+    //! Chunks of a pattern file read per tick, bounding the file I/O done on the rate group thread
+    static const U32 PATTERN_FILE_CHUNKS_PER_TICK = 4;
+
+    //! States of the PWM timer thread. Only the rate group thread moves it to PWM_RUNNING, PWM_STOPPING or PWM_IDLE, and
+    //! only the timer thread moves it from PWM_STOPPING to PWM_EXITED.
+    enum PwmThreadState : U8 {
+        PWM_IDLE = 0,      //!< No thread: the LED belongs to blinking
+        PWM_RUNNING = 1,   //!< The thread drives the LED
+        PWM_STOPPING = 2,  //!< PWM brightness mode was switched off. The thread hands the LED back at the next period.
+        PWM_EXITED = 3     //!< The thread left the LED low and returned. It is joined on the next tick.
+    };
+
+    //! Identifiers of the input port invocations written to a PortRecorder
+    enum RecordedPort : U8 {
+        RECORDED_RUN = 0,     //!< run port call. Arguments: U32 context
+        RECORDED_COMMAND = 1  //!< Command, or parameter update as its set command. Arguments: U32 opcode less the base
+                              //!< id, U32 cmdSeq, and the command argument buffer
+    };
+
     // ----------------------------------------------------------------------
     // Construction, initialization, and destruction
     // ----------------------------------------------------------------------
@@ -31,6 +67,25 @@ class Led : public LedComponentBase {
     void parameterUpdated(FwPrmIdType id /*!< The parameter ID*/
     );
 
+    //! Record run calls, every command dispatched and every parameter update to the supplied recorder, in the form
+    //! they arrive on cmdIn, so that a session can be replayed with raw commands
+    //!
+    void setRecorder(Utils::PortRecorder* recorder /*!< Recorder to use, nullptr to stop recording*/
+    );
+
+    //! Configure the PWM timer thread. No thread exists until PWM brightness mode is commanded on: PWM_ON_OFF ON starts
+    //! it, and once PWM_ON_OFF OFF is seen it hands the LED back and exits, to be joined on the next tick. While driving
+    //! the LED the thread does not allocate and takes no locks.
+    //!
+    void configurePwm(NATIVE_UINT_TYPE priority = Os::Task::TASK_DEFAULT,    /*!< Thread priority*/
+                      NATIVE_UINT_TYPE stackSize = Os::Task::TASK_DEFAULT,   /*!< Thread stack size*/
+                      NATIVE_UINT_TYPE cpuAffinity = Os::Task::TASK_DEFAULT  /*!< Thread CPU affinity*/
+    );
+
+    //! Stop the PWM timer thread, if any, and wait for it to exit. Waits up to one PWM period.
+    //!
+    void stopPwm();
+
   PRIVATE:
     // ----------------------------------------------------------------------
     // Command handler implementations
@@ -45,6 +100,88 @@ class Led : public LedComponentBase {
                                                  */
     );
 
+    //! Implementation for PWM_ON_OFF command handler
+    //! Command to turn on or off PWM brightness mode
+    void PWM_ON_OFF_cmdHandler(const FwOpcodeType opCode, /*!< The opcode*/
+                               const U32 cmdSeq,          /*!< The command sequence number*/
+                               Fw::On on_off              /*!< Indicates whether PWM mode should be on or off*/
+    );
+
+    //! Implementation for PATTERN_MORSE command handler
+    //! Blink Morse code instead of a square wave while blinking
+    void PATTERN_MORSE_cmdHandler(const FwOpcodeType opCode,   /*!< The opcode*/
+                                  const U32 cmdSeq,            /*!< The command sequence number*/
+                                  const Fw::CmdStringArg& text, /*!< Letters, digits and spaces to send*/
+                                  U16 unit                     /*!< Rate group ticks per Morse unit*/
+    );
+
+    //! Implementation for PATTERN_HEARTBEAT command handler
+    //! Blink a heartbeat double flash instead of a square wave while blinking
+    void PATTERN_HEARTBEAT_cmdHandler(const FwOpcodeType opCode, /*!< The opcode*/
+                                      const U32 cmdSeq,          /*!< The command sequence number*/
+                                      U16 unit                   /*!< Rate group ticks per flash*/
+    );
+
+    //! Implementation for PATTERN_RUNS command handler
+    //! Blink a run-length list of alternating on and off tick counts
+    void PATTERN_RUNS_cmdHandler(const FwOpcodeType opCode,  /*!< The opcode*/
+                                 const U32 cmdSeq,           /*!< The command sequence number*/
+                                 const Fw::CmdStringArg& runs /*!< Tick counts separated by commas or whitespace*/
+    );
+
+    //! Implementation for PATTERN_FILE command handler
+    //! Blink a run-length list read from a file
+    void PATTERN_FILE_cmdHandler(const FwOpcodeType opCode,      /*!< The opcode*/
+                                 const U32 cmdSeq,               /*!< The command sequence number*/
+                                 const Fw::CmdStringArg& fileName /*!< Path of the file*/
+    );
+
+    //! Implementation for PATTERN_CLEAR command handler
+    //! Discard the blink pattern, returning to a square wave
+    void PATTERN_CLEAR_cmdHandler(const FwOpcodeType opCode, /*!< The opcode*/
+                                  const U32 cmdSeq           /*!< The command sequence number*/
+    );
+
+  PRIVATE:
+    // ----------------------------------------------------------------------
+    // Pre-message hooks for async commands, called on the sending thread
+    // ----------------------------------------------------------------------
+
+    //! Wake the Led to dispatch BLINKING_ON_OFF
+    void BLINKING_ON_OFF_preMsgHook(FwOpcodeType opCode, /*!< The opcode*/
+                                    U32 cmdSeq           /*!< The command sequence number*/
+    );
+
+    //! Wake the Led to dispatch PATTERN_MORSE
+    void PATTERN_MORSE_preMsgHook(FwOpcodeType opCode, /*!< The opcode*/
+                                  U32 cmdSeq           /*!< The command sequence number*/
+    );
+
+    //! Wake the Led to dispatch PATTERN_HEARTBEAT
+    void PATTERN_HEARTBEAT_preMsgHook(FwOpcodeType opCode, /*!< The opcode*/
+                                      U32 cmdSeq           /*!< The command sequence number*/
+    );
+
+    //! Wake the Led to dispatch PATTERN_RUNS
+    void PATTERN_RUNS_preMsgHook(FwOpcodeType opCode, /*!< The opcode*/
+                                 U32 cmdSeq           /*!< The command sequence number*/
+    );
+
+    //! Wake the Led to dispatch PATTERN_FILE
+    void PATTERN_FILE_preMsgHook(FwOpcodeType opCode, /*!< The opcode*/
+                                 U32 cmdSeq           /*!< The command sequence number*/
+    );
+
+    //! Wake the Led to dispatch PATTERN_CLEAR
+    void PATTERN_CLEAR_preMsgHook(FwOpcodeType opCode, /*!< The opcode*/
+                                  U32 cmdSeq           /*!< The command sequence number*/
+    );
+
+    //! Wake the Led to dispatch PWM_ON_OFF
+    void PWM_ON_OFF_preMsgHook(FwOpcodeType opCode, /*!< The opcode*/
+                               U32 cmdSeq           /*!< The command sequence number*/
+    );
+
   PRIVATE:
     // ----------------------------------------------------------------------
     // Handler implementations for user-defined typed input ports
@@ -58,11 +195,122 @@ class Led : public LedComponentBase {
                        */
     );
 
-    Os::Mutex lock;   //! Protects our data from thread race conditions
-    Fw::On state;     //! Keeps track if LED is on or off
-    U64 transitions;  //! The number of on/off transitions that have occurred from FSW boot up
-    U32 count;        //! Keeps track of how many ticks the LED has been on for
-    bool blinking;    //! Flag: if true then LED blinking will occur else no blinking will happen
+    //! Record a command as cmdIn received it: its opcode and its arguments serialized into a command argument buffer
+    //!
+    template <typename... Args>
+    void recordCommand(FwOpcodeType opCode, /*!< The opcode*/
+                       U32 cmdSeq,          /*!< The command sequence number*/
+                       const Args&... args  /*!< The command arguments, in order*/
+    );
+
+    //! Record a parameter update as the command setting the parameter to its new value
+    //!
+    void recordParameter(FwPrmIdType id /*!< The parameter ID*/
+    );
+
+    //! Timestamp an edge and update the timing error statistics against the ideal schedule
+    //!
+    void recordEdgeTiming();
+
+    //! Report the outcome of compiling a blink pattern and restart blinking on it
+    //!
+    //! \return command response for the outcome
+    Fw::CmdResponse patternCompiled(BlinkPattern::Status status /*!< Status of compiling*/
+    );
+
+    //! Read and compile the next chunks of the pattern file being loaded. Once the file is read the pattern replaces the
+    //! one in use and the PATTERN_FILE command completes.
+    //!
+    void loadPatternChunks();
+
+    //! Abandon the pattern file being loaded, if any, failing its PATTERN_FILE command
+    //!
+    void cancelPatternFile();
+
+    //! Ask the rate group to call run on the next tick. Safe to call from any thread. The request is also kept
+    //! pending, so a run call that drained the queue before the message arrived still wakes on the next tick.
+    //!
+    void requestWakeup();
+
+    //! Start blinking again from a turn-on edge at the current tick
+    //!
+    void restartSchedule();
+
+    //! Length of a square wave phase for the current BLINK_INTERVAL: the on phase is half the interval rounded down,
+    //! the off phase the remainder, and neither is shorter than one tick
+    //!
+    //! \return length of the phase in ticks
+    U32 phaseLength(Fw::On phase /*!< Level of the phase*/
+    );
+
+    //! Compile and publish the PWM schedule when PWM_DUTY or PWM_FREQUENCY changed, then report PWM telemetry
+    //!
+    void updatePwm();
+
+    //! Set the LED from the PWM timer thread, on gpioSetNow when connected and otherwise on gpioSet
+    //!
+    void setPwmLevel(const Fw::Logic& level /*!< The LED line state*/
+    );
+
+    //! Entry point of the PWM timer thread
+    //!
+    static void pwmTask(void* led /*!< The Led driven*/
+    );
+
+    //! Replay the published PWM schedule until stopped
+    //!
+    void pwmLoop();
+
+    //! Switch PWM brightness mode on: keep the thread driving when it has not yet handed the LED back, and otherwise
+    //! start a new one
+    //!
+    //! \return true when a thread drives the LED
+    bool enablePwm();
+
+    //! Join the PWM timer thread once it has exited
+    //!
+    void joinPwm();
+
+    //! \return true when no PWM timer thread drives the LED, so blinking may
+    bool pwmReleased() const;
+
+    Fw::On state;                    //! Keeps track if LED is on or off
+    U64 transitions;                 //! The number of on/off transitions that have occurred from FSW boot up
+    bool blinking;                   //! Flag: if true then LED blinking will occur else no blinking will happen
+    Utils::PortRecorder* recorder;   //! Records input port invocations when set
+    U64 ticks;                       //! Tick of the current run call, numbering edges on the ideal schedule
+    U32 lastCycle;                   //! Cycle passed by a rate group skipping idle cycles on the previous call
+    U64 nextEdgeTick;                //! Tick at which the next phase starts. Nothing is done on the ticks before it.
+    U64 phaseStartTick;              //! Tick at which the current phase started
+    Fw::On nextPhase;                //! Level of the square wave phase starting at nextEdgeTick
+    std::atomic<bool> intervalChanged;  //! Flag: if true BLINK_INTERVAL changed and the next edge is rescheduled
+    std::atomic<bool> wakePending;   //! Flag: if true a wakeup was requested since the queue was last drained
+    std::atomic<bool> edgeAnchored;  //! Flag: if true the ideal schedule is anchored. Cleared from any thread.
+    U64 anchorTime;                  //! Time of the edge anchoring the ideal schedule, in microseconds
+    U64 anchorTick;                  //! Tick of the edge anchoring the ideal schedule
+    U64 lastEdgeTime;                //! Time of the previous edge, in microseconds
+    U64 lastEdgeTick;                //! Tick of the previous edge
+    RunningStats edgeDeviation;      //! Deviation of edges from the ideal schedule
+    RunningStats periodError;        //! Error of the time between consecutive edges
+    LedJitterHistogram histogram;    //! Counts of edges by deviation magnitude
+    BlinkPattern pattern;            //! Blink pattern used instead of the square wave when not empty
+    BlinkPattern patternStaging;     //! Blink pattern compiled from a file over several ticks, then swapped in
+    Os::File patternFile;            //! Pattern file being loaded
+    bool patternLoading;             //! Flag: if true a pattern file is being loaded
+    FwOpcodeType patternOpCode;      //! Opcode of the PATTERN_FILE command loading the file
+    U32 patternCmdSeq;               //! Sequence number of the PATTERN_FILE command loading the file
+    bool pwm;                        //! Flag: if true PWM brightness mode drives the LED instead of blinking
+    U32 pwmDuty;                     //! Duty cycle of the published PWM schedule
+    U32 pwmFrequency;                //! Frequency of the published PWM schedule, 0 before the first publish
+    PwmSchedule pwmSchedule;         //! Schedule replayed by the PWM timer thread
+    Os::Task pwmThread;              //! PWM timer thread
+    NATIVE_UINT_TYPE pwmPriority;    //! Priority of the PWM timer thread
+    NATIVE_UINT_TYPE pwmStackSize;   //! Stack size of the PWM timer thread
+    NATIVE_UINT_TYPE pwmCpuAffinity;  //! CPU affinity of the PWM timer thread
+    std::atomic<U8> pwmThreadState;  //! PwmThreadState of the PWM timer thread
+    std::atomic<U64> pwmEdges;       //! Edges driven by the PWM timer thread
+    std::atomic<U32> pwmOverruns;    //! PWM periods started late
+    std::atomic<U64> pwmCpuTime;     //! CPU time of the PWM timer thread in nanoseconds
 };
 
 }  // end namespace Components
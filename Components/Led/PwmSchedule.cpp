@@ -0,0 +1,63 @@
+// ======================================================================
+// \title  PwmSchedule.cpp
+// \brief  cpp file for the precalculated edge schedule of one PWM period
+// ======================================================================
+
+#include <Components/Led/PwmSchedule.hpp>
+
+namespace Components {
+
+PwmSchedule ::PwmSchedule() : m_sequence(0), m_period(0), m_count(0) {
+    for (U32 i = 0; i < MAX_EDGES; i++) {
+        this->m_offsets[i].store(0, std::memory_order_relaxed);
+        this->m_levels[i].store(false, std::memory_order_relaxed);
+    }
+}
+
+void PwmSchedule ::compile(U32 frequency, U32 duty, Table& table) {
+    frequency = (frequency < MIN_FREQUENCY) ? MIN_FREQUENCY : frequency;
+    frequency = (frequency > MAX_FREQUENCY) ? MAX_FREQUENCY : frequency;
+    duty = (duty > 100) ? 100 : duty;
+
+    table.period = 1000000000u / frequency;
+    table.offsets[0] = 0;
+    table.levels[0] = (duty != 0);
+    if ((0 == duty) || (100 == duty)) {
+        table.count = 1;
+    } else {
+        table.count = 2;
+        table.offsets[1] = static_cast<U32>((static_cast<U64>(table.period) * duty) / 100);
+        table.levels[1] = false;
+    }
+}
+
+void PwmSchedule ::publish(const Table& table) {
+    const U32 sequence = this->m_sequence.load(std::memory_order_relaxed);
+    this->m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    this->m_period.store(table.period, std::memory_order_relaxed);
+    this->m_count.store(table.count, std::memory_order_relaxed);
+    for (U32 i = 0; i < MAX_EDGES; i++) {
+        this->m_offsets[i].store(table.offsets[i], std::memory_order_relaxed);
+        this->m_levels[i].store(table.levels[i], std::memory_order_relaxed);
+    }
+    this->m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void PwmSchedule ::load(Table& table) const {
+    U32 before = 0;
+    U32 after = 0;
+    do {
+        before = this->m_sequence.load(std::memory_order_acquire);
+        table.period = this->m_period.load(std::memory_order_relaxed);
+        table.count = this->m_count.load(std::memory_order_relaxed);
+        for (U32 i = 0; i < MAX_EDGES; i++) {
+            table.offsets[i] = this->m_offsets[i].load(std::memory_order_relaxed);
+            table.levels[i] = this->m_levels[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = this->m_sequence.load(std::memory_order_relaxed);
+    } while ((before != after) || ((before & 1) != 0));
+}
+
+}  // end namespace Components
@@ -0,0 +1,66 @@
+// ======================================================================
+// \title  PwmSchedule.hpp
+// \brief  hpp file for the precalculated edge schedule of one PWM period
+// ======================================================================
+
+#ifndef PwmSchedule_HPP
+#define PwmSchedule_HPP
+
+#include <FpConfig.hpp>
+
+#include <atomic>
+
+namespace Components {
+
+//! \class PwmSchedule
+//! \brief Edge schedule of one PWM period, published by one thread and read lock-free by the PWM timer thread
+//!
+//! The schedule is compiled from a frequency and duty cycle whenever either changes, so the timer thread only replays
+//! offsets. Publishing uses a sequence counter that is odd while a publish is in progress; readers retry until they
+//! copy a schedule with the same even sequence before and after.
+class PwmSchedule {
+  public:
+    //! Edges within one period: rising at the start, falling after the high time
+    static const U32 MAX_EDGES = 2;
+    //! Lowest frequency accepted, in Hz
+    static const U32 MIN_FREQUENCY = 1;
+    //! Highest frequency accepted, in Hz
+    static const U32 MAX_FREQUENCY = 20000;
+
+    //! A compiled schedule
+    struct Table {
+        U32 period;                //!< Length of the period in nanoseconds
+        U32 count;                 //!< Number of edges in the period
+        U32 offsets[MAX_EDGES];    //!< Offset of each edge from the start of the period in nanoseconds
+        bool levels[MAX_EDGES];    //!< Level after each edge: true high, false low
+    };
+
+    PwmSchedule();
+
+    //! Compile the schedule of a period. Frequency is clamped to [MIN_FREQUENCY, MAX_FREQUENCY] and duty to 100.
+    //! Duty 0 and 100 compile to a single edge holding the line low or high.
+    //!
+    static void compile(U32 frequency, /*!< PWM frequency in Hz*/
+                        U32 duty,      /*!< Duty cycle in percent*/
+                        Table& table   /*!< Out: the schedule*/
+    );
+
+    //! Publish a schedule. Only one thread may publish.
+    //!
+    void publish(const Table& table);
+
+    //! Copy out the latest published schedule without locking
+    //!
+    void load(Table& table) const;
+
+  PRIVATE:
+    std::atomic<U32> m_sequence;              //!< Publish count, doubled. Odd while publishing.
+    std::atomic<U32> m_period;                //!< Published period
+    std::atomic<U32> m_count;                 //!< Published edge count
+    std::atomic<U32> m_offsets[MAX_EDGES];    //!< Published edge offsets
+    std::atomic<bool> m_levels[MAX_EDGES];    //!< Published edge levels
+};
+
+}  // end namespace Components
+
+#endif
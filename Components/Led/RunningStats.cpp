@@ -0,0 +1,43 @@
+// ======================================================================
+// \title  RunningStats.cpp
+// \brief  cpp file for streaming min/max/mean/standard deviation of a signed sample
+// ======================================================================
+
+#include <Components/Led/RunningStats.hpp>
+
+#include <cmath>
+
+namespace Components {
+
+RunningStats ::RunningStats() : m_count(0), m_min(0), m_max(0), m_mean(0.0), m_m2(0.0) {}
+
+void RunningStats ::update(I64 sample) {
+    this->m_min = ((0 == this->m_count) || (sample < this->m_min)) ? sample : this->m_min;
+    this->m_max = ((0 == this->m_count) || (sample > this->m_max)) ? sample : this->m_max;
+    this->m_count = this->m_count + 1;
+    const F64 delta = static_cast<F64>(sample) - this->m_mean;
+    this->m_mean = this->m_mean + (delta / this->m_count);
+    this->m_m2 = this->m_m2 + (delta * (static_cast<F64>(sample) - this->m_mean));
+}
+
+U32 RunningStats ::getCount() const {
+    return this->m_count;
+}
+
+I64 RunningStats ::getMin() const {
+    return this->m_min;
+}
+
+I64 RunningStats ::getMax() const {
+    return this->m_max;
+}
+
+F64 RunningStats ::getMean() const {
+    return this->m_mean;
+}
+
+F64 RunningStats ::getStdDev() const {
+    return (0 == this->m_count) ? 0.0 : std::sqrt(this->m_m2 / this->m_count);
+}
+
+}  // end namespace Components
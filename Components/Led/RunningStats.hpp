@@ -0,0 +1,48 @@
+// ======================================================================
+// \title  RunningStats.hpp
+// \brief  hpp file for streaming min/max/mean/standard deviation of a signed sample
+// ======================================================================
+
+#ifndef RunningStats_HPP
+#define RunningStats_HPP
+
+#include <FpConfig.hpp>
+
+namespace Components {
+
+//! \class RunningStats
+//! \brief Streaming statistics of a signed sample, computed in constant memory (Welford's algorithm)
+class RunningStats {
+  public:
+    RunningStats();
+
+    //! Add a sample
+    //!
+    void update(I64 sample);
+
+    //! \return number of samples
+    U32 getCount() const;
+
+    //! \return smallest sample, 0 without samples
+    I64 getMin() const;
+
+    //! \return largest sample, 0 without samples
+    I64 getMax() const;
+
+    //! \return mean of the samples
+    F64 getMean() const;
+
+    //! \return population standard deviation of the samples
+    F64 getStdDev() const;
+
+  PRIVATE:
+    U32 m_count;  //!< Number of samples
+    I64 m_min;    //!< Smallest sample
+    I64 m_max;    //!< Largest sample
+    F64 m_mean;   //!< Running mean
+    F64 m_m2;     //!< Running sum of squared differences from the mean
+};
+
+}  // end namespace Components
+
+#endif
@@ -0,0 +1,277 @@
+// ----------------------------------------------------------------------
+// LedBenchmark.cpp
+// ----------------------------------------------------------------------
+
+#include "Components/Led/Led.hpp"
+
+#include <Fw/Cmd/CmdArgBuffer.hpp>
+#include <Fw/Cmd/CmdResponsePortAc.hpp>
+#include <Fw/Comp/PassiveComponentBase.hpp>
+#include <Fw/Prm/PrmGetPortAc.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace {
+//! Allocations made through operator new by any thread
+std::atomic<U64> allocations(0);
+
+void* allocate(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc((size > 0) ? size : 1);
+}
+}  // namespace
+
+// Counting replacements of the global allocation functions, so each benchmark reports allocations per operation
+void* operator new(size_t size) {
+    void* memory = allocate(size);
+    FW_ASSERT(memory != nullptr);
+    return memory;
+}
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+void operator delete[](void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+namespace Components {
+namespace {
+
+//! Interval long enough that no edge falls within a benchmark
+const U32 INTERVAL_NO_EDGE = 0xFFFFFFFE;
+//! Interval placing an edge on every tick
+const U32 INTERVAL_EVERY_TICK = 2;
+//! Instances ticked together by the idle scale benchmark
+const U32 SCALE_INSTANCES = 1000;
+//! Interval of the idle scale benchmark leaving almost every tick idle
+const U32 SCALE_IDLE_INTERVAL = 1000;
+
+//! \class LedFleet
+//! \brief Led instances run side by side, with parameters and command responses served by sinks that keep no history
+//!
+//! Instances are created on first use and reused by every benchmark. Output ports not connected here are checked
+//! and skipped by the Led, as on a topology that leaves them unconnected.
+class LedFleet : public Fw::PassiveComponentBase {
+  public:
+    //! Largest number of instances benchmarked
+    static const U32 MAX_INSTANCES = 10000;
+    //! Queue depth of each instance, matching the deployment
+    static const NATIVE_INT_TYPE QUEUE_DEPTH = 10;
+
+    LedFleet() : Fw::PassiveComponentBase("LedFleet"), created(0), interval(0), commandSeq(0), failures(0) {
+        this->init(0);
+        this->responsePort.init();
+        this->responsePort.addCallComp(this, LedFleet::cmdResponseIn);
+        this->prmGetPort.init();
+        this->prmGetPort.addCallComp(this, LedFleet::prmGetIn);
+    }
+
+    //! Ready the first count instances: blink interval loaded, blinking on or off, and no command queued
+    void prepare(U32 count, U32 blinkInterval, bool blinking) {
+        FW_ASSERT(count <= MAX_INSTANCES, count);
+        for (; this->created < count; this->created++) {
+            std::unique_ptr<Led>& led = this->leds[this->created];
+            led.reset(new Led("led"));
+            led->init(QUEUE_DEPTH, static_cast<NATIVE_INT_TYPE>(this->created));
+            led->set_prmGetOut_OutputPort(0, &this->prmGetPort);
+            led->set_cmdResponseOut_OutputPort(0, &this->responsePort);
+        }
+        this->interval = blinkInterval;
+        Fw::CmdArgBuffer args;
+        const Fw::SerializeStatus status = args.serialize(Fw::On(blinking ? Fw::On::ON : Fw::On::OFF));
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+        for (U32 i = 0; i < count; i++) {
+            this->leds[i]->loadParameters();
+            this->command(i, Led::OPCODE_BLINKING_ON_OFF, args);
+            this->run(i, 0);
+        }
+        this->failures = 0;
+    }
+
+    //! Call the run port of an instance
+    void run(U32 index, U32 context) { this->leds[index]->get_run_InputPort(0)->invoke(context); }
+
+    //! Send a command to an instance
+    void command(U32 index, FwOpcodeType opCode, Fw::CmdArgBuffer& args) {
+        args.resetDeser();
+        this->leds[index]->get_cmdIn_InputPort(0)->invoke(opCode, this->commandSeq++, args);
+    }
+
+    //! \return command responses other than OK since prepare
+    U32 getFailures() const { return this->failures; }
+
+  private:
+    static void cmdResponseIn(Fw::PassiveComponentBase* callComp,
+                              NATIVE_INT_TYPE portNum,
+                              FwOpcodeType opCode,
+                              U32 cmdSeq,
+                              const Fw::CmdResponse& response) {
+        LedFleet* fleet = static_cast<LedFleet*>(callComp);
+        fleet->failures += (Fw::CmdResponse::OK == response) ? 0 : 1;
+    }
+
+    static Fw::ParamValid prmGetIn(Fw::PassiveComponentBase* callComp,
+                                   NATIVE_INT_TYPE portNum,
+                                   FwPrmIdType id,
+                                   Fw::ParamBuffer& val) {
+        // Instances keep the default base id, so only BLINK_INTERVAL is served and the rest take their defaults
+        LedFleet* fleet = static_cast<LedFleet*>(callComp);
+        if (Led::PARAMID_BLINK_INTERVAL != id) {
+            return Fw::ParamValid::INVALID;
+        }
+        val.resetSer();
+        const Fw::SerializeStatus status = val.serialize(fleet->interval);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+        return Fw::ParamValid::VALID;
+    }
+
+    Fw::InputCmdResponsePort responsePort;     //! Receives command responses, counting failures
+    Fw::InputPrmGetPort prmGetPort;            //! Serves BLINK_INTERVAL
+    std::unique_ptr<Led> leds[MAX_INSTANCES];  //! Instances created so far
+    U32 created;                               //! Number of instances created
+    U32 interval;                              //! BLINK_INTERVAL served to the instances
+    U32 commandSeq;                            //! Sequence number of the next command
+    U32 failures;                              //! Command responses other than OK
+};
+
+LedFleet& fleet() {
+    static LedFleet instances;
+    return instances;
+}
+
+//! Serialize the argument of a command
+template <typename T>
+void argument(Fw::CmdArgBuffer& args, const T& value) {
+    const Fw::SerializeStatus status = args.serialize(value);
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+}
+
+//! Report allocations per operation, and fail the benchmark if any command was refused
+void report(benchmark::State& state, U64 before) {
+    state.counters["allocs/op"] =
+        benchmark::Counter(static_cast<double>(allocations.load() - before), benchmark::Counter::kAvgIterations);
+    if (fleet().getFailures() > 0) {
+        state.SkipWithError("command failed");
+    }
+}
+
+//! One operation is one run call. Calls go round the instances so the working set grows with their count.
+void runTicks(benchmark::State& state, U32 interval, bool blinking) {
+    const U32 count = static_cast<U32>(state.range(0));
+    fleet().prepare(count, interval, blinking);
+    U32 index = 0;
+    U32 context = 1;
+    const U64 before = allocations.load();
+    for (auto _ : state) {
+        fleet().run(index, context);
+        if (++index == count) {
+            index = 0;
+            context++;
+        }
+    }
+    report(state, before);
+}
+
+//! run_handler with blinking off
+void runIdle(benchmark::State& state) {
+    runTicks(state, INTERVAL_NO_EDGE, false);
+}
+
+//! run_handler while blinking, on ticks between edges
+void runBlinking(benchmark::State& state) {
+    runTicks(state, INTERVAL_NO_EDGE, true);
+}
+
+//! run_handler while blinking, with a transition on every tick
+void runTransition(benchmark::State& state) {
+    runTicks(state, INTERVAL_EVERY_TICK, true);
+}
+
+//! One operation is one tick of SCALE_INSTANCES blinking instances, all called in turn as the rate group calls them.
+//! The interval is the argument: a long one leaves almost every tick idle and one of 2 has an edge on every tick.
+void idleScale(benchmark::State& state) {
+    fleet().prepare(SCALE_INSTANCES, static_cast<U32>(state.range(0)), true);
+    U32 context = 1;
+    const U64 before = allocations.load();
+    for (auto _ : state) {
+        for (U32 i = 0; i < SCALE_INSTANCES; i++) {
+            fleet().run(i, context);
+        }
+        context++;
+    }
+    // Reported per instance tick
+    state.SetItemsProcessed(state.iterations() * SCALE_INSTANCES);
+    report(state, before);
+}
+
+//! One operation is a BLINKING_ON_OFF command queued to an instance and dispatched by its next run call
+void blinkingOnOff(benchmark::State& state) {
+    const U32 count = static_cast<U32>(state.range(0));
+    fleet().prepare(count, INTERVAL_NO_EDGE, false);
+    Fw::CmdArgBuffer args[2];
+    argument(args[0], Fw::On(Fw::On::ON));
+    argument(args[1], Fw::On(Fw::On::OFF));
+    U32 index = 0;
+    U32 context = 1;
+    const U64 before = allocations.load();
+    for (auto _ : state) {
+        fleet().command(index, Led::OPCODE_BLINKING_ON_OFF, args[context & 1]);
+        fleet().run(index, context);
+        if (++index == count) {
+            index = 0;
+            context++;
+        }
+    }
+    report(state, before);
+}
+
+//! One operation is a BLINK_INTERVAL update through the parameter set command
+void blinkIntervalSet(benchmark::State& state) {
+    const U32 count = static_cast<U32>(state.range(0));
+    fleet().prepare(count, INTERVAL_NO_EDGE, false);
+    Fw::CmdArgBuffer args[2];
+    argument(args[0], static_cast<U32>(4));
+    argument(args[1], static_cast<U32>(6));
+    U32 index = 0;
+    U32 round = 0;
+    const U64 before = allocations.load();
+    for (auto _ : state) {
+        fleet().command(index, Led::OPCODE_BLINK_INTERVAL_SET, args[round & 1]);
+        if (++index == count) {
+            index = 0;
+            round++;
+        }
+    }
+    report(state, before);
+}
+
+}  // namespace
+}  // namespace Components
+
+BENCHMARK(Components::runIdle)->RangeMultiplier(10)->Range(1, Components::LedFleet::MAX_INSTANCES);
+BENCHMARK(Components::runBlinking)->RangeMultiplier(10)->Range(1, Components::LedFleet::MAX_INSTANCES);
+BENCHMARK(Components::runTransition)->RangeMultiplier(10)->Range(1, Components::LedFleet::MAX_INSTANCES);
+BENCHMARK(Components::idleScale)->Arg(Components::SCALE_IDLE_INTERVAL)->Arg(Components::INTERVAL_EVERY_TICK);
+BENCHMARK(Components::blinkingOnOff)->RangeMultiplier(10)->Range(1, Components::LedFleet::MAX_INSTANCES);
+BENCHMARK(Components::blinkIntervalSet)->RangeMultiplier(10)->Range(1, Components::LedFleet::MAX_INSTANCES);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,157 @@
+"""Command path latency of the led component on a running LedBlinker deployment
+
+Measures, over repeated BLINKING_ON_OFF commands:
+
+- command to SetBlinkingState: from sending the command to the event arriving at the ground
+- command to first LedState: from sending the command to the first LedState ON event arriving at the ground
+- LedTransitions staleness: from a LedTransitions value being written on board to it arriving at the ground
+
+Arrival is stamped when the GDS decodes each event and channel, and staleness compares that stamp with the channel's
+time tag, so the deployment and the GDS must share a clock (i.e. run on the same machine). The led is drained once per
+rateGroup1 cycle and telemetry is sent once per cycle, so budgets are expressed in 1 Hz cycles plus a margin.
+LATENCY_BUDGET_SCALE scales every budget, e.g. for a slow CI machine.
+
+Each distribution is written to LATENCY_ARTIFACT_DIR (default latency_artifacts) as latency.json and latency.csv:
+
+    LATENCY_ARTIFACT_DIR=/tmp/latency pytest Components/Led/test/int/led_latency_tests.py
+"""
+import csv
+import json
+import math
+import os
+import threading
+import time
+from pathlib import Path
+
+from fprime_gds.common.testing_fw import predicates
+
+# Commands sent to collect each distribution
+ITERATIONS = 10
+
+# Budgets in milliseconds: median and worst case. The led drains commands at the start of its run call and tlmSend
+# runs before it in the same cycle, so each path may wait up to one 1 Hz cycle before adding its own delay.
+BUDGETS_MS = {
+    "command_to_set_blinking": {"p50": 1100, "max": 1500},
+    "command_to_first_led_state": {"p50": 1100, "max": 1500},
+    "led_transitions_staleness": {"p50": 1100, "max": 1500},
+}
+
+
+class ArrivalRecorder:
+    """GDS consumer stamping each decoded event or channel with the host time it arrived"""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.arrivals = []
+
+    def data_callback(self, data, sender=None):
+        """Called by the GDS decoders for each event or channel, as soon as it is decoded"""
+        stamp = time.time()
+        with self.lock:
+            self.arrivals.append((stamp, data))
+
+    def since(self, start):
+        """Arrivals stamped at or after start, oldest first"""
+        with self.lock:
+            return [(stamp, data) for stamp, data in self.arrivals if stamp >= start]
+
+    def clear(self):
+        with self.lock:
+            self.arrivals.clear()
+
+
+def percentile(samples, fraction):
+    """Nearest rank percentile of a non-empty list"""
+    ordered = sorted(samples)
+    index = min(len(ordered) - 1, max(0, math.ceil(fraction * len(ordered)) - 1))
+    return ordered[index]
+
+
+def summarize(samples):
+    return {
+        "count": len(samples),
+        "min": min(samples),
+        "p50": percentile(samples, 0.50),
+        "p95": percentile(samples, 0.95),
+        "max": max(samples),
+    }
+
+
+def write_artifacts(distributions, budgets):
+    """Write every distribution with its summary and budget, returning the directory written to"""
+    directory = Path(os.environ.get("LATENCY_ARTIFACT_DIR", "latency_artifacts"))
+    directory.mkdir(parents=True, exist_ok=True)
+    report = {
+        name: {"samples_ms": samples, "summary_ms": summarize(samples), "budget_ms": budgets[name]}
+        for name, samples in distributions.items()
+    }
+    with open(directory / "latency.json", "w") as output:
+        json.dump(report, output, indent=2)
+    with open(directory / "latency.csv", "w", newline="") as output:
+        writer = csv.writer(output)
+        writer.writerow(["metric", "sample", "latency_ms"])
+        for name, samples in distributions.items():
+            for index, sample in enumerate(samples):
+                writer.writerow([name, index, f"{sample:.3f}"])
+    return directory
+
+
+def test_command_path_latency(fprime_test_api):
+    """Time BLINKING_ON_OFF to its events and LedTransitions to the ground, and hold each to its budget"""
+    scale = float(os.environ.get("LATENCY_BUDGET_SCALE", "1.0"))
+    budgets = {name: {key: value * scale for key, value in budget.items()} for name, budget in BUDGETS_MS.items()}
+
+    recorder = ArrivalRecorder()
+    fprime_test_api.pipeline.coders.register_event_consumer(recorder)
+    fprime_test_api.pipeline.coders.register_channel_consumer(recorder)
+
+    blink_start_evr = fprime_test_api.get_event_pred("led.SetBlinkingState", ["ON"])
+    blink_stop_evr = fprime_test_api.get_event_pred("led.SetBlinkingState", ["OFF"])
+    led_on_evr = fprime_test_api.get_event_pred("led.LedState", ["ON"])
+    transitions_tlm = fprime_test_api.get_telemetry_pred("led.LedTransitions")
+    distributions = {name: [] for name in BUDGETS_MS}
+    try:
+        # Start from a led that is not blinking, so each command begins a new blink
+        fprime_test_api.send_and_assert_event("led.BLINKING_ON_OFF", args=["OFF"], events=[blink_stop_evr])
+        for _ in range(ITERATIONS):
+            recorder.clear()
+            sent = time.time()
+            fprime_test_api.send_and_assert_event(
+                "led.BLINKING_ON_OFF", args=["ON"], events=[blink_start_evr, led_on_evr], timeout=5
+            )
+            fprime_test_api.assert_telemetry_count(
+                predicates.greater_than(1), "led.LedTransitions", start="NOW", timeout=5
+            )
+            arrivals = recorder.since(sent)
+
+            blink_start = next(stamp for stamp, data in arrivals if blink_start_evr(data))
+            led_on = next(stamp for stamp, data in arrivals if led_on_evr(data))
+            distributions["command_to_set_blinking"].append((blink_start - sent) * 1000)
+            distributions["command_to_first_led_state"].append((led_on - sent) * 1000)
+            for stamp, data in arrivals:
+                if transitions_tlm(data):
+                    distributions["led_transitions_staleness"].append((stamp - data.get_time().get_float()) * 1000)
+
+            fprime_test_api.send_and_assert_event("led.BLINKING_ON_OFF", args=["OFF"], events=[blink_stop_evr])
+    finally:
+        fprime_test_api.pipeline.coders.remove_event_consumer(recorder)
+        fprime_test_api.pipeline.coders.remove_channel_consumer(recorder)
+
+    directory = write_artifacts(distributions, budgets)
+    fprime_test_api.log(f"Latency distributions written to {directory}")
+    for name, samples in distributions.items():
+        summary = summarize(samples)
+        fprime_test_api.log(
+            f"{name}: p50 {summary['p50']:.1f} ms, p95 {summary['p95']:.1f} ms, max {summary['max']:.1f} ms"
+            f" over {summary['count']} (budget p50 {budgets[name]['p50']:.0f} ms, max {budgets[name]['max']:.0f} ms)"
+        )
+        assert fprime_test_api.test_assert(
+            summary["p50"] <= budgets[name]["p50"],
+            f"{name} median {summary['p50']:.1f} ms over its {budgets[name]['p50']:.0f} ms budget",
+            True,
+        )
+        assert fprime_test_api.test_assert(
+            summary["max"] <= budgets[name]["max"],
+            f"{name} worst case {summary['max']:.1f} ms over its {budgets[name]['max']:.0f} ms budget",
+            True,
+        )
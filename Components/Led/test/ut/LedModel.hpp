@@ -0,0 +1,85 @@
+// ======================================================================
+// \title  Led/test/ut/LedModel.hpp
+// \brief  Reference model of the Led square wave, checked against the component tick by tick
+// ======================================================================
+
+#ifndef LED_MODEL_HPP
+#define LED_MODEL_HPP
+
+#include <FpConfig.hpp>
+
+namespace Components {
+
+//! \class LedModel
+//! \brief What the Led should do on each tick, written from its specification rather than its implementation
+//!
+//! While blinking, the LED is on for half the interval, rounded down, and off for the rest, each phase lasting at
+//! least one tick. Turning blinking on, even when already on, starts a new on phase at the next tick. A phase ends
+//! once it has lasted as long as the interval in force says, so changing the interval mid-phase ends the phase where
+//! the new interval puts it, or at the next tick if that has passed. Turning blinking off leaves the LED at its level.
+//!
+//! The model only counts how long the current phase has lasted; it keeps no schedule of edges.
+class LedModel {
+  public:
+    LedModel() : level(false), blinking(false), restart(false), interval(0), on(false), age(0), transitions(0) {}
+
+    //! A BLINKING_ON_OFF command, dispatched at the start of the next tick
+    void setBlinking(bool value) {
+        this->blinking = value;
+        this->restart = value;
+    }
+
+    //! A BLINK_INTERVAL update, in force from the next tick
+    void setInterval(U32 value) { this->interval = value; }
+
+    //! Advance one tick
+    //!
+    //! \return true when the LED changes level on this tick
+    bool step() {
+        if (!this->blinking) {
+            return false;
+        }
+        if (this->restart) {
+            this->restart = false;
+            this->on = true;
+            this->age = 0;
+        } else {
+            this->age++;
+            if (this->age >= this->length(this->on)) {
+                this->on = !this->on;
+                this->age = 0;
+            }
+        }
+        if (this->on == this->level) {
+            return false;
+        }
+        this->level = this->on;
+        this->transitions++;
+        return true;
+    }
+
+    //! \return level of the LED: true when on
+    bool getLevel() const { return this->level; }
+
+    //! \return number of level changes
+    U64 getTransitions() const { return this->transitions; }
+
+  private:
+    //! \return ticks a phase lasts under the interval in force
+    U32 length(bool phaseOn) const {
+        const U32 ticks = phaseOn ? (this->interval / 2) : (this->interval - (this->interval / 2));
+        return (ticks > 0) ? ticks : 1;
+    }
+
+    bool level;        //!< LED level: true when on
+    bool blinking;     //!< Blinking is on
+    bool restart;      //!< Blinking was turned on since the last tick
+    U32 interval;      //!< Blink interval in ticks
+    bool on;           //!< The current phase is an on phase
+    U64 age;           //!< Ticks the current phase has lasted
+    U64 transitions;   //!< Level changes so far
+};
+
+}  // end namespace Components
+
+#endif
@@ -14,6 +14,51 @@ TEST(Nominal, TestBlinkInterval) {
     tester.testBlinkInterval();
 }
 
+TEST(Nominal, TestRunDrainsCommands) {
+    Components::Tester tester;
+    tester.testRunDrainsCommands();
+}
+
+TEST(Nominal, TestRecordReplay) {
+    Components::Tester tester;
+    tester.testRecordReplay();
+}
+
+TEST(Nominal, TestEdgeJitter) {
+    Components::Tester tester;
+    tester.testEdgeJitter();
+}
+
+TEST(Nominal, TestPwmEdges) {
+    Components::Tester tester;
+    tester.testPwmEdges();
+}
+
+TEST(Nominal, TestPatternCompile) {
+    Components::Tester tester;
+    tester.testPatternCompile();
+}
+
+TEST(Nominal, TestPatternLong) {
+    Components::Tester tester;
+    tester.testPatternLong();
+}
+
+TEST(Nominal, TestIntervalChange) {
+    Components::Tester tester;
+    tester.testIntervalChange();
+}
+
+TEST(Nominal, TestWakeup) {
+    Components::Tester tester;
+    tester.testWakeup();
+}
+
+TEST(Nominal, TestRandomLongRun) {
+    Components::Tester tester;
+    tester.testRandomLongRun();
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
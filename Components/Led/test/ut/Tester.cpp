@@ -5,6 +5,16 @@
 // ======================================================================
 
 #include "Tester.hpp"
+#include "Components/GpioChipDriver/GpioChipDriver.hpp"
+#include "LedModel.hpp"
+
+#include <Os/IntervalTimer.hpp>
+#include <Utils/TestFile/TestFile.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
 
 namespace Components {
 
@@ -12,7 +22,7 @@ namespace Components {
 // Construction and destruction
 // ----------------------------------------------------------------------
 
-Tester ::Tester() : LedGTestBase("Tester", Tester::MAX_HISTORY_SIZE), component("Led") {
+Tester ::Tester() : LedGTestBase("Tester", Tester::MAX_HISTORY_SIZE), component("Led"), stopOnEdge(false) {
     this->initComponents();
     this->connectPorts();
 }
@@ -87,12 +97,614 @@ void Tester ::testBlinkInterval() {
     ASSERT_TLM_LedTransitions(this->tlmHistory_LedTransitions->size() - 1, 4);
 }
 
+void Tester ::testRunDrainsCommands() {
+    // Queue both commands without dispatching; the run port is responsible for draining them
+    this->sendCmd_BLINKING_ON_OFF(0, 0, Fw::On::OFF);
+    this->sendCmd_BLINKING_ON_OFF(0, 1, Fw::On::ON);
+    ASSERT_EVENTS_SetBlinkingState_SIZE(0);
+
+    // A single tick dispatches both commands in order, then blinks with the final state
+    this->invoke_to_run(0, 0);
+    ASSERT_CMD_RESPONSE_SIZE(2);
+    ASSERT_CMD_RESPONSE(0, Led::OPCODE_BLINKING_ON_OFF, 0, Fw::CmdResponse::OK);
+    ASSERT_CMD_RESPONSE(1, Led::OPCODE_BLINKING_ON_OFF, 1, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_SetBlinkingState_SIZE(2);
+    ASSERT_EVENTS_SetBlinkingState(0, Fw::On::OFF);
+    ASSERT_EVENTS_SetBlinkingState(1, Fw::On::ON);
+    ASSERT_from_gpioSet_SIZE(1);
+    ASSERT_from_gpioSet(0, Fw::Logic::HIGH);
+
+    // Nothing remains queued for the following tick
+    this->invoke_to_run(0, 0);
+    ASSERT_EVENTS_SetBlinkingState_SIZE(2);
+    ASSERT_from_gpioSet_SIZE(2);
+}
+
+void Tester ::testRecordReplay() {
+    const Utils::TestFile logFile("LedRecordReplay.bin");
+    const char* const log = logFile.get();
+    // Edges are captured on simulated lines, as the session outgrows the harness histories
+    GpioChipDriver gpio("gpio");
+    gpio.init(0);
+    gpio.openSimulated(1);
+    this->component.set_gpioSet_OutputPort(0, gpio.get_gpioWrite_InputPort(0));
+
+    // Record a session updating every parameter and sending every command, except PATTERN_FILE, whose file is not
+    // kept, and PWM_ON_OFF ON, whose edges are timed by its own thread
+    Utils::PortRecorder recorder;
+    ASSERT_TRUE(recorder.open(log));
+    this->component.setRecorder(&recorder);
+    U32 tick = 0;
+    U32 cmdSeq = 0;
+    auto runTicks = [this, &tick](U32 count) {
+        for (U32 i = 0; i < count; i++, tick++) {
+            this->setTestTime(Fw::Time(tick, 0));
+            this->invoke_to_run(0, tick);
+            this->clearHistory();
+        }
+    };
+    this->paramSet_BLINK_INTERVAL(4, Fw::ParamValid::VALID);
+    this->paramSend_BLINK_INTERVAL(0, cmdSeq++);
+    this->paramSet_TICK_PERIOD(1000, Fw::ParamValid::VALID);
+    this->paramSend_TICK_PERIOD(0, cmdSeq++);
+    this->paramSet_PWM_DUTY(20, Fw::ParamValid::VALID);
+    this->paramSend_PWM_DUTY(0, cmdSeq++);
+    this->paramSet_PWM_FREQUENCY(500, Fw::ParamValid::VALID);
+    this->paramSend_PWM_FREQUENCY(0, cmdSeq++);
+    this->sendCmd_BLINKING_ON_OFF(0, cmdSeq++, Fw::On::ON);
+    this->sendCmd_PWM_ON_OFF(0, cmdSeq++, Fw::On::OFF);
+    runTicks(8);
+    this->sendCmd_PATTERN_MORSE(0, cmdSeq++, Fw::CmdStringArg("sos"), 1);
+    runTicks(40);
+    this->sendCmd_PATTERN_HEARTBEAT(0, cmdSeq++, 2);
+    runTicks(30);
+    this->sendCmd_PATTERN_RUNS(0, cmdSeq++, Fw::CmdStringArg("3, 1, 2"));
+    runTicks(20);
+    this->sendCmd_PATTERN_CLEAR(0, cmdSeq++);
+    runTicks(8);
+    this->component.setRecorder(nullptr);
+    recorder.close();
+    const EdgeRing& edges = gpio.getEdges();
+    ASSERT_GT(edges.getTotal(), 0u);
+
+    // Replaying the whole log reproduces every GPIO output: one record per command or parameter update and per tick
+    GpioChipDriver fullGpio("fullGpio");
+    fullGpio.init(0);
+    fullGpio.openSimulated(1);
+    Tester full;
+    full.component.set_gpioSet_OutputPort(0, fullGpio.get_gpioWrite_InputPort(0));
+    ASSERT_EQ(full.replay(log, 0xFFFFFFFF), cmdSeq + tick);
+    const EdgeRing& fullEdges = fullGpio.getEdges();
+    ASSERT_EQ(fullEdges.getTotal(), edges.getTotal());
+    for (U64 i = 0; i < edges.getTotal(); i++) {
+        EdgeRing::Edge recorded;
+        EdgeRing::Edge replayed;
+        ASSERT_TRUE(edges.read(i, recorded));
+        ASSERT_TRUE(fullEdges.read(i, replayed));
+        ASSERT_EQ(replayed.level, recorded.level) << "edge " << i;
+    }
+
+    // Replaying a prefix stops partway: the parameter updates and first commands, then three ticks
+    GpioChipDriver prefixGpio("prefixGpio");
+    prefixGpio.init(0);
+    prefixGpio.openSimulated(1);
+    Tester prefix;
+    prefix.component.set_gpioSet_OutputPort(0, prefixGpio.get_gpioWrite_InputPort(0));
+    ASSERT_EQ(prefix.replay(log, 9), 9u);
+    const EdgeRing& prefixEdges = prefixGpio.getEdges();
+    ASSERT_EQ(prefixEdges.getTotal(), 2u);
+    EdgeRing::Edge edge;
+    ASSERT_TRUE(prefixEdges.read(1, edge));
+    ASSERT_EQ(edge.level, 0u);
+}
+
+void Tester ::testEdgeJitter() {
+    // Toggle every tick of a 1 ms rate group
+    this->paramSet_BLINK_INTERVAL(2, Fw::ParamValid::VALID);
+    this->paramSend_BLINK_INTERVAL(0, 0);
+    this->paramSet_TICK_PERIOD(1000, Fw::ParamValid::VALID);
+    this->paramSend_TICK_PERIOD(0, 0);
+    this->sendCmd_BLINKING_ON_OFF(0, 0, Fw::On::ON);
+
+    // Late and early ticks, in microseconds. The first edge anchors the schedule and is not measured.
+    const I32 jitter[] = {0, 50, -20, 500, 0, 2000};
+    const U32 edges = sizeof(jitter) / sizeof(jitter[0]);
+    for (U32 i = 0; i < edges; i++) {
+        this->setTestTime(Fw::Time(0, (i * 1000) + jitter[i]));
+        this->invoke_to_run(0, 0);
+    }
+    ASSERT_from_gpioSet_SIZE(edges);
+    ASSERT_TLM_EdgeDeviation_SIZE(edges - 1);
+    ASSERT_TLM_PeriodError_SIZE(edges - 1);
+    ASSERT_TLM_EdgeDeviationHistogram_SIZE(edges - 1);
+
+    // Deviations from the schedule are 50, -20, 500, 0 and 2000
+    const LedJitterStats& deviation = this->tlmHistory_EdgeDeviation->at(edges - 2).arg;
+    ASSERT_EQ(deviation.getsamples(), 5u);
+    ASSERT_EQ(deviation.getminimum(), -20);
+    ASSERT_EQ(deviation.getmaximum(), 2000);
+    ASSERT_FLOAT_EQ(deviation.getmean(), 506.0f);
+    ASSERT_NEAR(deviation.getstddev(), 771.07f, 0.01f);
+
+    // Errors of the time between consecutive edges are 50, -70, 520, -500 and 2000
+    const LedJitterStats& period = this->tlmHistory_PeriodError->at(edges - 2).arg;
+    ASSERT_EQ(period.getsamples(), 5u);
+    ASSERT_EQ(period.getminimum(), -500);
+    ASSERT_EQ(period.getmaximum(), 2000);
+    ASSERT_FLOAT_EQ(period.getmean(), 400.0f);
+
+    LedJitterHistogram histogram;
+    histogram[0] = 1;
+    histogram[1] = 2;
+    histogram[2] = 1;
+    histogram[3] = 1;
+    ASSERT_TLM_EdgeDeviationHistogram(edges - 2, histogram);
+
+    // Restarting blinking anchors a new schedule, so a shifted first edge is not counted as jitter
+    this->sendCmd_BLINKING_ON_OFF(0, 0, Fw::On::ON);
+    this->setTestTime(Fw::Time(0, 100333));
+    this->invoke_to_run(0, 0);
+    ASSERT_TLM_EdgeDeviation_SIZE(edges - 1);
+    this->setTestTime(Fw::Time(0, 101333));
+    this->invoke_to_run(0, 0);
+    ASSERT_TLM_EdgeDeviation_SIZE(edges);
+    ASSERT_EQ(this->tlmHistory_EdgeDeviation->at(edges - 1).arg.getsamples(), 6u);
+    ASSERT_EQ(this->tlmHistory_EdgeDeviation->at(edges - 1).arg.getmaximum(), 2000);
+}
+
+void Tester ::testPwmEdges() {
+    // Capture edges on a simulated line: the harness port history is far too short for kHz edges
+    GpioChipDriver gpio("gpio");
+    gpio.init(0);
+    gpio.openSimulated(1);
+    this->component.set_gpioSet_OutputPort(0, gpio.get_gpioWrite_InputPort(0));
+
+    const U32 frequency = 2000;
+    const U32 duty = 25;
+    // PWM periods measured, and the wall clock allowed for them on a loaded host. The first period may start from the
+    // takeover edge, so it is captured but not measured.
+    const U32 periods = 200;
+    const U64 captured = (2 * (periods + 2)) + 1;
+    const U32 timeout = 10000;
+    const U32 poll = 10;
+    this->paramSet_PWM_FREQUENCY(frequency, Fw::ParamValid::VALID);
+    this->paramSend_PWM_FREQUENCY(0, 0);
+    this->paramSet_PWM_DUTY(duty, Fw::ParamValid::VALID);
+    this->paramSend_PWM_DUTY(0, 0);
+    // No timer thread exists until PWM brightness mode is commanded on
+    ASSERT_EQ(this->component.pwmThreadState.load(), Led::PWM_IDLE);
+
+    // The command takes effect on the next tick, then the timer thread runs on its own until the periods are captured.
+    // Completion is judged from the edges themselves, not from elapsed time, so a slow host only takes longer.
+    Os::IntervalTimer elapsed;
+    elapsed.start();
+    this->sendCmd_PWM_ON_OFF(0, 0, Fw::On::ON);
+    this->invoke_to_run(0, 0);
+    ASSERT_EQ(this->component.pwmThreadState.load(), Led::PWM_RUNNING);
+    ASSERT_EVENTS_SetPwmState_SIZE(1);
+    ASSERT_EVENTS_SetPwmState(0, Fw::On::ON);
+    const EdgeRing& edges = gpio.getEdges();
+    for (U32 waited = 0; (edges.getTotal() < captured) && (waited < timeout); waited += poll) {
+        Os::Task::delay(poll);
+    }
+    this->invoke_to_run(0, 0);
+    this->sendCmd_PWM_ON_OFF(0, 1, Fw::On::OFF);
+    this->invoke_to_run(0, 0);
+    elapsed.stop();
+    // The thread hands the LED back within a period and is joined on the tick after it exits
+    for (U32 waited = 0; (Led::PWM_IDLE != this->component.pwmThreadState.load()) && (waited < timeout);
+         waited += poll) {
+        Os::Task::delay(poll);
+        this->invoke_to_run(0, 0);
+    }
+    ASSERT_EQ(this->component.pwmThreadState.load(), Led::PWM_IDLE);
+    ASSERT_CMD_RESPONSE_SIZE(2);
+    ASSERT_CMD_RESPONSE(1, Led::OPCODE_PWM_ON_OFF, 1, Fw::CmdResponse::OK);
+
+    // Every simulated period is one rise followed by one fall, whatever the host load
+    ASSERT_GE(edges.getTotal(), captured);
+    ASSERT_LT(edges.getTotal(), static_cast<U64>(EdgeRing::CAPACITY));
+    U64 periodTimes[periods];
+    U64 highTimes[periods];
+    U32 measured = 0;
+    U64 lastRise = 0;
+    U32 rises = 0;
+    U32 previous = 0;
+    for (U64 i = 0; (i < edges.getTotal()) && (measured < periods); i++) {
+        EdgeRing::Edge edge;
+        ASSERT_TRUE(edges.read(i, edge));
+        if (i > 0) {
+            ASSERT_NE(edge.level, previous) << "edge " << i << " repeats the level of the edge before it";
+        }
+        previous = edge.level;
+        if (1 == edge.level) {
+            if (rises > 1) {
+                periodTimes[measured++] = edge.timestamp - lastRise;
+            }
+            lastRise = edge.timestamp;
+            rises++;
+        } else if ((rises > 1) && (measured < periods)) {
+            highTimes[measured] = edge.timestamp - lastRise;
+        }
+    }
+    ASSERT_EQ(measured, periods);
+
+    // Frequency and duty are taken from the median period, which a preempted period on a loaded host does not move
+    std::sort(periodTimes, periodTimes + periods);
+    std::sort(highTimes, highTimes + periods);
+    const F64 measuredFrequency = 1.0e9 / static_cast<F64>(periodTimes[periods / 2]);
+    const F64 measuredDuty =
+        100.0 * static_cast<F64>(highTimes[periods / 2]) / static_cast<F64>(periodTimes[periods / 2]);
+    ASSERT_NEAR(measuredFrequency, frequency, frequency * 0.02);
+    ASSERT_NEAR(measuredDuty, duty, 5.0);
+
+    // Telemetry taken while running accounts for the edges driven so far, at a CPU cost below the time spent running
+    ASSERT_TLM_PwmEdges_SIZE(3);
+    const U64 driven = this->tlmHistory_PwmEdges->at(1).arg;
+    ASSERT_GT(driven, 0u);
+    ASSERT_LE(driven, edges.getTotal());
+    ASSERT_TLM_PwmCpuTime_SIZE(3);
+    const U64 cpu = this->tlmHistory_PwmCpuTime->at(1).arg;
+    ASSERT_LT(cpu, static_cast<U64>(elapsed.getDiffUsec()));
+    (void)printf("[PWM] %.1f Hz, %.1f%% duty, %llu edges, %llu us CPU, %.0f ns CPU per edge, %u overruns\n",
+                 measuredFrequency, measuredDuty, static_cast<unsigned long long>(driven),
+                 static_cast<unsigned long long>(cpu), (cpu * 1000.0) / driven,
+                 this->tlmHistory_PwmOverruns->at(1).arg);
+}
+
+void Tester ::testPatternCompile() {
+    BlinkPattern pattern;
+
+    // SOS: three dots, three dashes, three dots, with letter gaps and a trailing word gap
+    const U32 sos[] = {1, 1, 1, 1, 1, 3, 3, 1, 3, 1, 3, 3, 1, 1, 1, 1, 1, 7};
+    ASSERT_EQ(pattern.compileMorse("sos", 1), BlinkPattern::OK);
+    ASSERT_EQ(pattern.getCount(), FW_NUM_ARRAY_ELEMENTS(sos));
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(sos); i++) {
+        ASSERT_EQ(pattern.getRun(i), sos[i]);
+    }
+    ASSERT_EQ(pattern.getLength(), 34u);
+
+    // A word gap replaces the letter gap, and units scale every run
+    ASSERT_EQ(pattern.compileMorse("E E", 2), BlinkPattern::OK);
+    ASSERT_EQ(pattern.getCount(), 4u);
+    ASSERT_EQ(pattern.getRun(1), 14u);
+    ASSERT_EQ(pattern.getRun(3), 14u);
+
+    ASSERT_EQ(pattern.compileHeartbeat(5), BlinkPattern::OK);
+    ASSERT_EQ(pattern.getCount(), 4u);
+    ASSERT_EQ(pattern.getLength(), 50u);
+
+    // Run-length lists accept commas and whitespace, and replay their runs repeatedly. With an odd number of runs the
+    // last and first runs are both on.
+    ASSERT_EQ(pattern.compileRuns("2, 1\n3"), BlinkPattern::OK);
+    const U32 runs[] = {2, 1, 3, 2, 1};
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(runs); i++) {
+        bool level = false;
+        ASSERT_EQ(pattern.nextRun(level), runs[i]) << "run " << i;
+        ASSERT_EQ(level, (i % 3) != 1) << "run " << i;
+    }
+
+    // Every rejected pattern leaves the table empty
+    ASSERT_EQ(pattern.compileMorse("SOS!", 1), BlinkPattern::INVALID);
+    ASSERT_EQ(pattern.getCount(), 0u);
+    ASSERT_EQ(pattern.compileMorse("   ", 1), BlinkPattern::EMPTY);
+    ASSERT_EQ(pattern.compileHeartbeat(0), BlinkPattern::INVALID);
+    ASSERT_EQ(pattern.compileRuns("1,0,1"), BlinkPattern::INVALID);
+    ASSERT_EQ(pattern.compileRuns("1,x"), BlinkPattern::INVALID);
+    ASSERT_EQ(pattern.compileRuns("99999999999"), BlinkPattern::INVALID);
+    ASSERT_EQ(pattern.compileRuns(""), BlinkPattern::EMPTY);
+
+    // Long Morse text compiles within the table, merging the gaps between letters
+    const char* const pangram = "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789";
+    ASSERT_EQ(pattern.compileMorse(pangram, 1), BlinkPattern::OK);
+    ASSERT_GT(pattern.getCount(), 200u);
+    ASSERT_LT(pattern.getCount(), BlinkPattern::MAX_RUNS);
+}
+
+void Tester ::testPatternLong() {
+    // Write a pattern filling the table, with runs of 1 to 7 ticks
+    const Utils::TestFile patternFile("LedPatternLong.txt");
+    const char* const fileName = patternFile.get();
+    U64 length = 0;
+    FILE* file = fopen(fileName, "w");
+    ASSERT_NE(file, nullptr);
+    for (U32 i = 0; i < BlinkPattern::MAX_RUNS; i++) {
+        (void)fprintf(file, "%u%s", (i % 7) + 1, ((i % 16) == 15) ? "\n" : ",");
+        length = length + (i % 7) + 1;
+    }
+
+    // The file is read a bounded number of chunks per tick, so the command completes a few ticks after it is sent
+    const U32 bytes = static_cast<U32>(ftell(file));
+    (void)fclose(file);
+    const U32 bytesPerTick = Led::PATTERN_FILE_CHUNK * Led::PATTERN_FILE_CHUNKS_PER_TICK;
+    this->sendCmd_PATTERN_FILE(0, 0, Fw::CmdStringArg(fileName));
+    const U32 ticks = this->runUntilResponse(bytes);
+    ASSERT_GT(ticks, 1u);
+    ASSERT_LE(ticks, (bytes / bytesPerTick) + 2);
+    ASSERT_CMD_RESPONSE(0, Led::OPCODE_PATTERN_FILE, 0, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_PatternLoaded(0, BlinkPattern::MAX_RUNS, length);
+    this->sendCmd_BLINKING_ON_OFF(0, 1, Fw::On::ON);
+    this->component.doDispatch();
+
+    // Two repetitions, compared tick by tick with the runs written. Histories are cleared each tick to stay in bounds.
+    bool level = false;
+    U32 run = 0;
+    U32 tick = 0;
+    U32 edges = 0;
+    for (U64 t = 0; t < (2 * length); t++) {
+        const bool expected = (run % 2) == 0;
+        this->clearHistory();
+        this->invoke_to_run(0, 0);
+        if (expected != level) {
+            ASSERT_from_gpioSet_SIZE(1);
+            ASSERT_from_gpioSet(0, expected ? Fw::Logic::HIGH : Fw::Logic::LOW);
+            level = expected;
+            edges++;
+        } else {
+            ASSERT_from_gpioSet_SIZE(0);
+        }
+        tick++;
+        if (tick >= ((run % 7) + 1)) {
+            tick = 0;
+            run = (run + 1) % BlinkPattern::MAX_RUNS;
+        }
+    }
+    ASSERT_EQ(edges, 2 * BlinkPattern::MAX_RUNS);
+
+    // One run more than the table holds is rejected and blinking falls back to the square wave
+    this->clearHistory();
+    file = fopen(fileName, "a");
+    ASSERT_NE(file, nullptr);
+    (void)fprintf(file, "1\n");
+    (void)fclose(file);
+    this->sendCmd_PATTERN_FILE(0, 2, Fw::CmdStringArg(fileName));
+    ASSERT_GT(this->runUntilResponse(bytes), 1u);
+    ASSERT_CMD_RESPONSE(0, Led::OPCODE_PATTERN_FILE, 2, Fw::CmdResponse::VALIDATION_ERROR);
+    ASSERT_EVENTS_PatternRejected(0, LedPatternError::TOO_LONG);
+
+    this->sendCmd_PATTERN_FILE(0, 3, Fw::CmdStringArg("/does-not-exist/pattern.txt"));
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(1, Led::OPCODE_PATTERN_FILE, 3, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_PatternRejected(1, LedPatternError::FILE_ERROR);
+
+    // A pattern command sent while a file loads cancels the load and takes effect instead
+    this->clearHistory();
+    this->sendCmd_PATTERN_FILE(0, 4, Fw::CmdStringArg(fileName));
+    this->invoke_to_run(0, 0);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+    this->sendCmd_PATTERN_HEARTBEAT(0, 5, 1);
+    this->invoke_to_run(0, 0);
+    ASSERT_CMD_RESPONSE_SIZE(2);
+    ASSERT_CMD_RESPONSE(0, Led::OPCODE_PATTERN_FILE, 4, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_CMD_RESPONSE(1, Led::OPCODE_PATTERN_HEARTBEAT, 5, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_PatternRejected(0, LedPatternError::CANCELLED);
+    ASSERT_EVENTS_PatternLoaded_SIZE(1);
+}
+
+void Tester ::testIntervalChange() {
+    // An odd interval of 3 is on for 1 tick and off for 2
+    this->paramSet_BLINK_INTERVAL(3, Fw::ParamValid::VALID);
+    this->paramSend_BLINK_INTERVAL(0, 0);
+    this->sendCmd_BLINKING_ON_OFF(0, 0, Fw::On::ON);
+    const U32 oddEdges[] = {1, 2, 2, 3, 4, 4};
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(oddEdges); i++) {
+        this->invoke_to_run(0, 0);
+        ASSERT_from_gpioSet_SIZE(oddEdges[i]);
+    }
+    ASSERT_from_gpioSet(3, Fw::Logic::LOW);
+
+    // Interval 10: on at tick 0, due off at tick 5
+    this->clearHistory();
+    this->paramSet_BLINK_INTERVAL(10, Fw::ParamValid::VALID);
+    this->paramSend_BLINK_INTERVAL(0, 0);
+    this->sendCmd_BLINKING_ON_OFF(0, 1, Fw::On::ON);
+    for (U32 i = 0; i < 3; i++) {
+        this->invoke_to_run(0, 0);
+    }
+    ASSERT_from_gpioSet_SIZE(1);
+
+    // Shortening to 4 ends the on phase, already 3 ticks long, now. Off then lasts 2 ticks.
+    this->paramSet_BLINK_INTERVAL(4, Fw::ParamValid::VALID);
+    this->paramSend_BLINK_INTERVAL(0, 0);
+    this->invoke_to_run(0, 0);
+    ASSERT_from_gpioSet_SIZE(2);
+    ASSERT_from_gpioSet(1, Fw::Logic::LOW);
+    this->invoke_to_run(0, 0);
+    ASSERT_from_gpioSet_SIZE(2);
+    this->invoke_to_run(0, 0);
+    ASSERT_from_gpioSet_SIZE(3);
+
+    // Lengthening to 20 during the on phase started at tick 5 moves its end to tick 15
+    this->paramSet_BLINK_INTERVAL(20, Fw::ParamValid::VALID);
+    this->paramSend_BLINK_INTERVAL(0, 0);
+    for (U32 tick = 6; tick < 15; tick++) {
+        this->invoke_to_run(0, 0);
+    }
+    ASSERT_from_gpioSet_SIZE(3);
+    this->invoke_to_run(0, 0);
+    ASSERT_from_gpioSet_SIZE(4);
+    ASSERT_from_gpioSet(3, Fw::Logic::LOW);
+}
+
+void Tester ::testWakeup() {
+    // Left unconnected by connectPorts so the other tests count ticks one per call
+    this->component.set_wakeup_OutputPort(0, this->get_from_wakeup(0));
+
+    // Parameter updates and commands wake the Led on the next tick
+    this->paramSet_BLINK_INTERVAL(10, Fw::ParamValid::VALID);
+    this->paramSend_BLINK_INTERVAL(0, 0);
+    this->sendCmd_BLINKING_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_from_wakeup_SIZE(2);
+    ASSERT_from_wakeup(0, 1);
+    ASSERT_from_wakeup(1, 1);
+
+    // Cycle 1 turns the Led on and declares the off edge 5 ticks away
+    this->invoke_to_run(0, 1);
+    ASSERT_from_gpioSet_SIZE(1);
+    ASSERT_from_gpioSet(0, Fw::Logic::HIGH);
+    ASSERT_from_wakeup_SIZE(3);
+    ASSERT_from_wakeup(2, 5);
+
+    // The rate group skips cycles 2 to 5. Cycle 6 is the off edge.
+    this->invoke_to_run(0, 6);
+    ASSERT_from_gpioSet_SIZE(2);
+    ASSERT_from_gpioSet(1, Fw::Logic::LOW);
+    ASSERT_from_wakeup(3, 5);
+
+    // A call before the edge is due declares the remaining ticks
+    this->invoke_to_run(0, 8);
+    ASSERT_from_gpioSet_SIZE(2);
+    ASSERT_from_wakeup(4, 3);
+
+    // A command queued once run has drained the queue, as one sent from another thread mid-call may be, still wakes
+    // the Led on the next tick: the delay declared at the end of the call does not override its wakeup request
+    this->clearHistory();
+    this->stopOnEdge = true;
+    this->invoke_to_run(0, 11);
+    ASSERT_from_gpioSet_SIZE(1);
+    ASSERT_from_gpioSet(0, Fw::Logic::HIGH);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+    ASSERT_from_wakeup_SIZE(2);
+    ASSERT_from_wakeup(0, 1);
+    ASSERT_from_wakeup(1, 1);
+
+    // Once blinking stops nothing is due
+    this->invoke_to_run(0, 12);
+    ASSERT_CMD_RESPONSE(0, Led::OPCODE_BLINKING_ON_OFF, 1, Fw::CmdResponse::OK);
+    ASSERT_from_wakeup_SIZE(3);
+    ASSERT_from_wakeup(2, Led::WAKEUP_NEVER);
+}
+
+void Tester ::testRandomLongRun() {
+    // Runs are repeatable. LED_PROPERTY_SEED explores other sequences, and a failure is reproduced with the seed printed.
+    const char* seedText = getenv("LED_PROPERTY_SEED");
+    const U32 seed = (seedText != nullptr) ? static_cast<U32>(strtoul(seedText, nullptr, 0)) : PROPERTY_SEED;
+    (void)printf("[PROPERTY] seed %u, %u ticks\n", seed, PROPERTY_TICKS);
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<U32> percent(0, 99);
+    std::uniform_int_distribution<U32> permille(0, 999);
+
+    LedModel model;
+    U32 cmdSeq = 0;
+    U64 edges = 0;
+    Os::IntervalTimer timer;
+    timer.start();
+    for (U32 tick = 1; tick <= PROPERTY_TICKS; tick++) {
+        // Between ticks: occasionally a few commands and interval updates, in random order. Updates take effect when
+        // sent, commands when the next tick dispatches them.
+        for (U32 i = 0; (i < PROPERTY_MAX_CHANGES) && (permille(random) < PROPERTY_CHANGE_PERMILLE); i++) {
+            if (percent(random) < 50) {
+                const bool on = percent(random) < 70;
+                this->sendCmd_BLINKING_ON_OFF(0, cmdSeq++, on ? Fw::On::ON : Fw::On::OFF);
+                model.setBlinking(on);
+            } else {
+                // Mostly short intervals, odd and even, including 0 and 1, with some long ones
+                const U32 kind = percent(random);
+                const U32 interval =
+                    (kind < 60) ? (percent(random) % 13) : ((kind < 95) ? percent(random) : (permille(random) * 5));
+                this->paramSet_BLINK_INTERVAL(interval, Fw::ParamValid::VALID);
+                this->paramSend_BLINK_INTERVAL(0, cmdSeq++);
+                model.setInterval(interval);
+            }
+        }
+
+        // Each tick is checked as it happens, so no history outgrows its bound
+        this->invoke_to_run(0, 0);
+        const bool edge = model.step();
+        const Fw::On level = model.getLevel() ? Fw::On::ON : Fw::On::OFF;
+        ASSERT_EQ(this->fromPortHistory_gpioSet->size(), edge ? 1u : 0u) << "seed " << seed << ", tick " << tick;
+        ASSERT_EQ(this->eventHistory_LedState->size(), edge ? 1u : 0u) << "seed " << seed << ", tick " << tick;
+        if (edge) {
+            ASSERT_EQ(this->fromPortHistory_gpioSet->at(0).state, model.getLevel() ? Fw::Logic::HIGH : Fw::Logic::LOW)
+                << "seed " << seed << ", tick " << tick;
+            ASSERT_EQ(this->eventHistory_LedState->at(0).on_off, level) << "seed " << seed << ", tick " << tick;
+            ASSERT_EQ(this->tlmHistory_LedTransitions->at(0).arg, model.getTransitions())
+                << "seed " << seed << ", tick " << tick;
+            edges++;
+        }
+        for (U32 i = 0; i < this->cmdResponseHistory->size(); i++) {
+            ASSERT_EQ(this->cmdResponseHistory->at(i).response, Fw::CmdResponse::OK)
+                << "seed " << seed << ", tick " << tick;
+        }
+        this->clearHistory();
+    }
+    timer.stop();
+    (void)printf("[PROPERTY] %llu edges matched the model in %u ms\n", static_cast<unsigned long long>(edges),
+                 timer.getDiffUsec() / 1000);
+}
+
+// ----------------------------------------------------------------------
+// Helper methods
+// ----------------------------------------------------------------------
+
+U32 Tester ::replay(const char* fileName, U32 maxRecords) {
+    Utils::PortLogReader reader;
+    EXPECT_TRUE(reader.open(fileName));
+
+    U8 port = 0;
+    Fw::Time time;
+    Utils::PortArgs args;
+    U32 replayed = 0;
+    while ((replayed < maxRecords) && reader.next(port, time, args)) {
+        // Invocations are fed back as fast as possible, with the recorded time supplied to the component
+        this->setTestTime(time);
+        switch (port) {
+            case Led::RECORDED_RUN: {
+                U32 context = 0;
+                EXPECT_EQ(args.deserialize(context), Fw::FW_SERIALIZE_OK);
+                this->invoke_to_run(0, context);
+                this->clearHistory();
+                break;
+            }
+            case Led::RECORDED_COMMAND: {
+                // Commands were recorded as dispatched by the run call recorded after them, which dispatches them again
+                U32 opCode = 0;
+                U32 cmdSeq = 0;
+                Fw::CmdArgBuffer cmdArgs;
+                EXPECT_EQ(args.deserialize(opCode), Fw::FW_SERIALIZE_OK);
+                EXPECT_EQ(args.deserialize(cmdSeq), Fw::FW_SERIALIZE_OK);
+                EXPECT_EQ(args.deserialize(cmdArgs), Fw::FW_SERIALIZE_OK);
+                this->sendRawCmd(this->component.getIdBase() + opCode, cmdSeq, cmdArgs);
+                break;
+            }
+            default:
+                ADD_FAILURE() << "Unknown recorded port " << static_cast<U32>(port);
+                break;
+        }
+        replayed++;
+    }
+    return replayed;
+}
+
+U32 Tester ::runUntilResponse(U32 maxTicks) {
+    U32 ticks = 0;
+    while ((this->cmdResponseHistory->size() == 0) && (ticks < maxTicks)) {
+        this->invoke_to_run(0, 0);
+        ticks++;
+    }
+    EXPECT_GT(this->cmdResponseHistory->size(), 0u);
+    return ticks;
+}
+
 // ----------------------------------------------------------------------
 // Handlers for typed from ports
 // ----------------------------------------------------------------------
 
 void Tester ::from_gpioSet_handler(const NATIVE_INT_TYPE portNum, const Fw::Logic& state) {
     this->pushFromPortEntry_gpioSet(state);
+    // Queued after the run call in progress has drained its commands
+    if (this->stopOnEdge) {
+        this->stopOnEdge = false;
+        this->sendCmd_BLINKING_ON_OFF(0, 1, Fw::On::OFF);
+    }
+}
+
+void Tester ::from_gpioSetNow_handler(const NATIVE_INT_TYPE portNum, const Fw::Logic& state) {
+    this->pushFromPortEntry_gpioSetNow(state);
+}
+
+void Tester ::from_wakeup_handler(const NATIVE_INT_TYPE portNum, U32 delay) {
+    this->pushFromPortEntry_wakeup(delay);
 }
 
 }  // end namespace Components
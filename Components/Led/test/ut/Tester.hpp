@@ -24,6 +24,14 @@ class Tester : public LedGTestBase {
     static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
     // Queue depth supplied to component instance under test
     static const NATIVE_INT_TYPE TEST_INSTANCE_QUEUE_DEPTH = 10;
+    // Ticks run by the randomized long-run test
+    static const U32 PROPERTY_TICKS = 2000000;
+    // Seed of the randomized long-run test, so every run checks the same sequence unless LED_PROPERTY_SEED is set
+    static const U32 PROPERTY_SEED = 20230401;
+    // Chance in 1000 of a command or interval update between two ticks of the randomized long-run test
+    static const U32 PROPERTY_CHANGE_PERMILLE = 10;
+    // Most commands and interval updates between two ticks, well within the queue depth
+    static const U32 PROPERTY_MAX_CHANGES = 3;
 
     //! Construct object Tester
     //!
@@ -43,6 +51,57 @@ class Tester : public LedGTestBase {
     void testBlinking();
     void testBlinkInterval();
 
+    //! Commands queued between ticks are dispatched by the next run call
+    //!
+    void testRunDrainsCommands();
+
+    //! A recorded session replayed into a fresh component produces the same GPIO outputs
+    //!
+    void testRecordReplay();
+
+    //! Edge timing telemetry measures the deviation of injected jitter from the ideal schedule
+    //!
+    void testEdgeJitter();
+
+    //! PWM brightness mode drives edges at the commanded frequency and duty cycle, measured on a simulated line
+    //!
+    void testPwmEdges();
+
+    //! Morse, heartbeat and run-length patterns compile to the expected run-length tables
+    //!
+    void testPatternCompile();
+
+    //! A pattern of the maximum length loaded from a file blinks exactly its runs, repeating
+    //!
+    void testPatternLong();
+
+    //! Odd intervals and interval changes mid-phase move the next edge as the square wave requires
+    //!
+    void testIntervalChange();
+
+    //! Run calls declare the ticks until the next edge and count ticks skipped by the rate group
+    //!
+    void testWakeup();
+
+    //! Millions of ticks with random commands and interval updates match the reference model on every tick
+    //!
+    void testRandomLongRun();
+
+    //! Feed the records of a port log to the component under test, stopping after maxRecords. Commands and parameter
+    //! updates are sent raw on cmdIn. Histories are cleared after each tick so that sessions of any length replay:
+    //! outputs are observed on ports the caller connects.
+    //!
+    //! \return number of records replayed
+    U32 replay(const char* fileName, /*!< Log written by a PortRecorder attached to a Led*/
+               U32 maxRecords        /*!< Records to replay, allowing a session to be bisected*/
+    );
+
+    //! Call run until a command response arrives, as a pattern file is loaded over several ticks
+    //!
+    //! \return number of run calls made
+    U32 runUntilResponse(U32 maxTicks /*!< Run calls allowed*/
+    );
+
   private:
     // ----------------------------------------------------------------------
     // Handlers for typed from ports
@@ -53,6 +112,17 @@ class Tester : public LedGTestBase {
     void from_gpioSet_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
                               const Fw::Logic& state);
 
+    //! Handler for from_gpioSetNow
+    //!
+    void from_gpioSetNow_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                                 const Fw::Logic& state);
+
+    //! Handler for from_wakeup
+    //!
+    void from_wakeup_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                             U32 delay                      /*!< Ticks until the Led next has work due*/
+    );
+
   private:
     // ----------------------------------------------------------------------
     // Helper methods
@@ -74,6 +144,10 @@ class Tester : public LedGTestBase {
     //! The component under test
     //!
     Led component;
+
+    //! Send BLINKING_ON_OFF OFF from the next gpioSet output, in the middle of a run call
+    //!
+    bool stopOnEdge;
 };
 
 }  // end namespace Components
@@ -0,0 +1,68 @@
+// ======================================================================
+// \title  MutexProfiler.cpp
+// \brief  cpp file for MutexProfiler component implementation class
+// ======================================================================
+
+#include <Components/MutexProfiler/MutexProfiler.hpp>
+#include <FpConfig.hpp>
+#include <Utils/MutexProfile/MutexProfile.hpp>
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+// Construction, initialization, and destruction
+// ----------------------------------------------------------------------
+
+MutexProfiler ::MutexProfiler(const char* const compName) : MutexProfilerComponentBase(compName) {}
+
+MutexProfiler ::~MutexProfiler() {}
+
+// ----------------------------------------------------------------------
+// Handler implementations for user-defined typed input ports
+// ----------------------------------------------------------------------
+
+void MutexProfiler ::run_handler(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+    // Totals over every name, and the name waited on longest
+    U64 acquisitions = 0;
+    U64 contended = 0;
+    U64 waitNs = 0;
+    U64 holdNs = 0;
+    Utils::MutexProfile::Stats mostWaited = {};
+    mostWaited.name = "";
+    Utils::MutexProfile::Stats stats;
+    for (U32 i = 0; Utils::MutexProfile::getStats(i, stats); i++) {
+        acquisitions += stats.acquisitions;
+        contended += stats.contended;
+        waitNs += stats.waitNs;
+        holdNs += stats.holdNs;
+        if (stats.waitNs > mostWaited.waitNs) {
+            mostWaited = stats;
+        }
+    }
+    this->tlmWrite_MutexAcquisitions(acquisitions);
+    this->tlmWrite_MutexContended(contended);
+    this->tlmWrite_MutexWaitTime(waitNs / 1000);
+    this->tlmWrite_MutexHoldTime(holdNs / 1000);
+    this->tlmWrite_MutexMostWaited(Fw::TlmString(mostWaited.name));
+    this->tlmWrite_MutexMostWaitedTime(mostWaited.waitNs / 1000);
+}
+
+// ----------------------------------------------------------------------
+// Command handler implementations
+// ----------------------------------------------------------------------
+
+void MutexProfiler ::DUMP_MUTEXES_cmdHandler(const FwOpcodeType opCode,
+                                             const U32 cmdSeq,
+                                             const Fw::CmdStringArg& fileName) {
+    Fw::LogStringArg fileArg(fileName.toChar());
+    U32 mutexes = 0;
+    if (!Utils::MutexProfile::dump(fileName.toChar(), mutexes)) {
+        this->log_WARNING_HI_MutexDumpError(fileArg);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->log_ACTIVITY_HI_MutexesDumped(mutexes, fileArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+}  // end namespace Components
@@ -0,0 +1,54 @@
+// ======================================================================
+// \title  MutexProfiler.hpp
+// \brief  hpp file for MutexProfiler component implementation class
+// ======================================================================
+
+#ifndef MutexProfiler_HPP
+#define MutexProfiler_HPP
+
+#include "Components/MutexProfiler/MutexProfilerComponentAc.hpp"
+
+namespace Components {
+
+class MutexProfiler : public MutexProfilerComponentBase {
+  public:
+    // ----------------------------------------------------------------------
+    // Construction, initialization, and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct object MutexProfiler
+    //!
+    MutexProfiler(const char* const compName /*!< The component name*/
+    );
+
+    //! Destroy object MutexProfiler
+    //!
+    ~MutexProfiler();
+
+  PRIVATE:
+    // ----------------------------------------------------------------------
+    // Handler implementations for user-defined typed input ports
+    // ----------------------------------------------------------------------
+
+    //! Handler implementation for run
+    //!
+    void run_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                     NATIVE_UINT_TYPE context       /*!< The call order*/
+    );
+
+  PRIVATE:
+    // ----------------------------------------------------------------------
+    // Command handler implementations
+    // ----------------------------------------------------------------------
+
+    //! Implementation for DUMP_MUTEXES command handler
+    //! Write the statistics of every profiled mutex to a CSV file, most waited on first
+    void DUMP_MUTEXES_cmdHandler(const FwOpcodeType opCode,       /*!< The opcode*/
+                                 const U32 cmdSeq,                /*!< The command sequence number*/
+                                 const Fw::CmdStringArg& fileName /*!< Path of the file written*/
+    );
+};
+
+}  // end namespace Components
+
+#endif
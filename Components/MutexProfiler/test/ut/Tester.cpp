@@ -0,0 +1,89 @@
+// ======================================================================
+// \title  MutexProfiler/test/ut/Tester.cpp
+// \brief  cpp file for MutexProfiler test harness implementation class
+// ======================================================================
+
+#include "Tester.hpp"
+
+#include <Utils/MutexProfile/MutexProfile.hpp>
+#include <Utils/TestFile/TestFile.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+// Construction and destruction
+// ----------------------------------------------------------------------
+
+Tester ::Tester() : MutexProfilerGTestBase("Tester", Tester::MAX_HISTORY_SIZE), component("MutexProfiler") {
+    this->initComponents();
+    this->connectPorts();
+}
+
+Tester ::~Tester() {}
+
+// ----------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------
+
+void Tester ::testRun() {
+    // Profiled directly, whether or not the repo's mutexes are profiled in this build
+    Utils::ProfiledMutex mutex("MutexProfiler.run");
+    std::atomic<bool> held(false);
+    std::thread holder([&]() {
+        mutex.lock();
+        held.store(true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        mutex.unLock();
+    });
+    while (!held.load()) {
+        std::this_thread::yield();
+    }
+    mutex.lock();
+    mutex.unLock();
+    holder.join();
+
+    this->invoke_to_run(0, 0);
+    ASSERT_TLM_MutexAcquisitions_SIZE(1);
+    ASSERT_GE(this->tlmHistory_MutexAcquisitions->at(0).arg, 2u);
+    ASSERT_GE(this->tlmHistory_MutexContended->at(0).arg, 1u);
+    ASSERT_GE(this->tlmHistory_MutexWaitTime->at(0).arg, 10000u);
+    ASSERT_GE(this->tlmHistory_MutexHoldTime->at(0).arg, 10000u);
+    ASSERT_STREQ(this->tlmHistory_MutexMostWaited->at(0).arg.toChar(), "MutexProfiler.run");
+    ASSERT_GE(this->tlmHistory_MutexMostWaitedTime->at(0).arg, 10000u);
+}
+
+void Tester ::testDump() {
+    Utils::ProfiledMutex mutex("MutexProfiler.dump");
+    mutex.lock();
+    mutex.unLock();
+
+    const Utils::TestFile dumpFile("MutexProfiler.csv");
+
+    const char* const dump = dumpFile.get();
+    this->sendCmd_DUMP_MUTEXES(0, 0, Fw::CmdStringArg(dump));
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MutexProfiler::OPCODE_DUMP_MUTEXES, 0, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_MutexesDumped_SIZE(1);
+    ASSERT_EQ(this->eventHistory_MutexesDumped->at(0).mutexes, Utils::MutexProfile::getCount());
+
+    FILE* file = fopen(dump, "r");
+    ASSERT_NE(file, nullptr);
+    char contents[4096] = {};
+    (void)fread(contents, 1, sizeof(contents) - 1, file);
+    (void)fclose(file);
+    ASSERT_EQ(strncmp(contents, "name,acquisitions,contended,", 28), 0);
+    ASSERT_NE(strstr(contents, "\nMutexProfiler.dump,1,0,"), nullptr);
+}
+
+void Tester ::testDumpError() {
+    this->sendCmd_DUMP_MUTEXES(0, 1, Fw::CmdStringArg("/does-not-exist/mutexes.csv"));
+    ASSERT_CMD_RESPONSE(0, MutexProfiler::OPCODE_DUMP_MUTEXES, 1, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_MutexDumpError_SIZE(1);
+}
+
+}  // end namespace Components
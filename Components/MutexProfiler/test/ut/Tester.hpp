@@ -0,0 +1,75 @@
+// ======================================================================
+// \title  MutexProfiler/test/ut/Tester.hpp
+// \brief  hpp file for MutexProfiler test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "Components/MutexProfiler/MutexProfiler.hpp"
+#include "GTestBase.hpp"
+
+namespace Components {
+
+class Tester : public MutexProfilerGTestBase {
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+  public:
+    // Maximum size of histories storing events, telemetry, and port outputs
+    static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 10;
+    // Instance ID supplied to the component instance under test
+    static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+
+    //! Construct object Tester
+    //!
+    Tester();
+
+    //! Destroy object Tester
+    //!
+    ~Tester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    //! Totals and the mutex waited on longest are reported on each run
+    //!
+    void testRun();
+
+    //! Statistics are written to the commanded file
+    //!
+    void testDump();
+
+    //! A file that cannot be created fails the command
+    //!
+    void testDumpError();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper methods
+    // ----------------------------------------------------------------------
+
+    //! Connect ports
+    //!
+    void connectPorts();
+
+    //! Initialize components
+    //!
+    void initComponents();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Variables
+    // ----------------------------------------------------------------------
+
+    //! The component under test
+    //!
+    MutexProfiler component;
+};
+
+}  // end namespace Components
+
+#endif
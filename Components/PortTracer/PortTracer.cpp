@@ -0,0 +1,38 @@
+// ======================================================================
+// \title  PortTracer.cpp
+// \brief  cpp file for PortTracer component implementation class
+// ======================================================================
+
+#include <Components/PortTracer/PortTracer.hpp>
+#include <FpConfig.hpp>
+#include <Utils/PortTrace/PortTrace.hpp>
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+// Construction, initialization, and destruction
+// ----------------------------------------------------------------------
+
+PortTracer ::PortTracer(const char* const compName) : PortTracerComponentBase(compName) {}
+
+PortTracer ::~PortTracer() {}
+
+// ----------------------------------------------------------------------
+// Command handler implementations
+// ----------------------------------------------------------------------
+
+void PortTracer ::DUMP_TRACE_cmdHandler(const FwOpcodeType opCode,
+                                        const U32 cmdSeq,
+                                        const Fw::CmdStringArg& fileName) {
+    Fw::LogStringArg fileArg(fileName.toChar());
+    U32 events = 0;
+    if (!Utils::PortTrace::dump(fileName.toChar(), events)) {
+        this->log_WARNING_HI_TraceDumpError(fileArg);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->log_ACTIVITY_HI_TraceDumped(events, fileArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+}  // end namespace Components
@@ -0,0 +1,43 @@
+// ======================================================================
+// \title  PortTracer.hpp
+// \brief  hpp file for PortTracer component implementation class
+// ======================================================================
+
+#ifndef PortTracer_HPP
+#define PortTracer_HPP
+
+#include "Components/PortTracer/PortTracerComponentAc.hpp"
+
+namespace Components {
+
+class PortTracer : public PortTracerComponentBase {
+  public:
+    // ----------------------------------------------------------------------
+    // Construction, initialization, and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct object PortTracer
+    //!
+    PortTracer(const char* const compName /*!< The component name*/
+    );
+
+    //! Destroy object PortTracer
+    //!
+    ~PortTracer();
+
+  PRIVATE:
+    // ----------------------------------------------------------------------
+    // Command handler implementations
+    // ----------------------------------------------------------------------
+
+    //! Implementation for DUMP_TRACE command handler
+    //! Write the port calls recorded by every thread to a Chrome trace JSON file
+    void DUMP_TRACE_cmdHandler(const FwOpcodeType opCode,       /*!< The opcode*/
+                               const U32 cmdSeq,                /*!< The command sequence number*/
+                               const Fw::CmdStringArg& fileName /*!< Path of the file written*/
+    );
+};
+
+}  // end namespace Components
+
+#endif
@@ -0,0 +1,20 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "Tester.hpp"
+
+TEST(Nominal, TestDump) {
+    Components::Tester tester;
+    tester.testDump();
+}
+
+TEST(OffNominal, TestDumpError) {
+    Components::Tester tester;
+    tester.testDumpError();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
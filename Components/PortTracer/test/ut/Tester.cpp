@@ -0,0 +1,61 @@
+// ======================================================================
+// \title  PortTracer/test/ut/Tester.cpp
+// \brief  cpp file for PortTracer test harness implementation class
+// ======================================================================
+
+#include "Tester.hpp"
+
+#include <Utils/PortTrace/PortTrace.hpp>
+#include <Utils/TestFile/TestFile.hpp>
+#include <cstdio>
+#include <cstring>
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+// Construction and destruction
+// ----------------------------------------------------------------------
+
+Tester ::Tester() : PortTracerGTestBase("Tester", Tester::MAX_HISTORY_SIZE), component("PortTracer") {
+    this->initComponents();
+    this->connectPorts();
+}
+
+Tester ::~Tester() {}
+
+// ----------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------
+
+void Tester ::testDump() {
+    if (!Utils::PortTrace::isEnabled()) {
+        GTEST_SKIP() << "Built without LEDBLINKER_PORT_TRACE, so no events are recorded";
+    }
+    Utils::PortTrace::begin("PortTracer.test", 7);
+    Utils::PortTrace::end();
+
+    const Utils::TestFile dumpFile("PortTracerTrace.json");
+
+    const char* const dump = dumpFile.get();
+    this->sendCmd_DUMP_TRACE(0, 0, Fw::CmdStringArg(dump));
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, PortTracer::OPCODE_DUMP_TRACE, 0, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_TraceDumped_SIZE(1);
+    ASSERT_GE(this->eventHistory_TraceDumped->at(0).events, 2u);
+
+    FILE* file = fopen(dump, "r");
+    ASSERT_NE(file, nullptr);
+    char contents[4096] = {};
+    (void)fread(contents, 1, sizeof(contents) - 1, file);
+    (void)fclose(file);
+    ASSERT_EQ(strncmp(contents, "{\"traceEvents\":[", 16), 0);
+    ASSERT_NE(strstr(contents, "\"name\":\"PortTracer.test\",\"ph\":\"B\""), nullptr);
+}
+
+void Tester ::testDumpError() {
+    this->sendCmd_DUMP_TRACE(0, 1, Fw::CmdStringArg("/does-not-exist/trace.json"));
+    ASSERT_CMD_RESPONSE(0, PortTracer::OPCODE_DUMP_TRACE, 1, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_TraceDumpError_SIZE(1);
+}
+
+}  // end namespace Components
@@ -0,0 +1,95 @@
+// ======================================================================
+// \title  VirtualClock.cpp
+// \brief  cpp file for VirtualClock component implementation class
+// ======================================================================
+
+#include <Components/VirtualClock/VirtualClock.hpp>
+#include <FpConfig.hpp>
+
+#include <time.h>
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+// Construction, initialization, and destruction
+// ----------------------------------------------------------------------
+
+VirtualClock ::VirtualClock(const char* const compName)
+    : VirtualClockComponentBase(compName),
+      lock("VirtualClock.lock"),
+      isVirtual(false),
+      virtualTime(0),
+      completedCycles() {}
+
+VirtualClock ::~VirtualClock() {}
+
+void VirtualClock ::setVirtual(bool enabled) {
+    timespec stime;
+    (void)clock_gettime(CLOCK_REALTIME, &stime);
+    const U64 now = (static_cast<U64>(stime.tv_sec) * 1000000) + (static_cast<U64>(stime.tv_nsec) / 1000);
+
+    this->lock.lock();
+    if (enabled && !this->isVirtual) {
+        this->virtualTime = (now > this->virtualTime) ? now : this->virtualTime;
+    }
+    this->isVirtual = enabled;
+    this->lock.unLock();
+}
+
+void VirtualClock ::advance(U32 microseconds) {
+    this->lock.lock();
+    this->virtualTime = this->virtualTime + microseconds;
+    this->lock.unLock();
+}
+
+bool VirtualClock ::isVirtualTime() {
+    this->lock.lock();
+    bool is_virtual = this->isVirtual;
+    this->lock.unLock();
+    return is_virtual;
+}
+
+U32 VirtualClock ::getCompletedCycles(NATIVE_INT_TYPE rateGroup) {
+    FW_ASSERT((rateGroup >= 0) && (rateGroup < NUM_CYCLEDONE_INPUT_PORTS), rateGroup);
+    std::lock_guard<std::mutex> guard(this->cycleLock);
+    return this->completedCycles[rateGroup];
+}
+
+void VirtualClock ::waitForCycles(NATIVE_INT_TYPE rateGroup, U32 cycles) {
+    FW_ASSERT((rateGroup >= 0) && (rateGroup < NUM_CYCLEDONE_INPUT_PORTS), rateGroup);
+    std::unique_lock<std::mutex> guard(this->cycleLock);
+    // Counts wrap, so the distance left is compared rather than the counts themselves
+    while (static_cast<I32>(cycles - this->completedCycles[rateGroup]) > 0) {
+        this->cycleSignal.wait(guard);
+    }
+}
+
+// ----------------------------------------------------------------------
+// Handler implementations for user-defined typed input ports
+// ----------------------------------------------------------------------
+
+void VirtualClock ::timeGetPort_handler(const NATIVE_INT_TYPE portNum, Fw::Time& time) {
+    this->lock.lock();
+    bool is_virtual = this->isVirtual;
+    U64 now = this->virtualTime;
+    this->lock.unLock();
+
+    // Wall-clock time is reported exactly as Svc::LinuxTime reports it
+    if (!is_virtual) {
+        timespec stime;
+        (void)clock_gettime(CLOCK_REALTIME, &stime);
+        now = (static_cast<U64>(stime.tv_sec) * 1000000) + (static_cast<U64>(stime.tv_nsec) / 1000);
+    }
+    time.set(TB_WORKSTATION_TIME, 0, static_cast<U32>(now / 1000000), static_cast<U32>(now % 1000000));
+}
+
+void VirtualClock ::cycleDone_handler(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+    FW_ASSERT((portNum >= 0) && (portNum < NUM_CYCLEDONE_INPUT_PORTS), portNum);
+    {
+        std::lock_guard<std::mutex> guard(this->cycleLock);
+        this->completedCycles[portNum] = this->completedCycles[portNum] + 1;
+    }
+    this->cycleSignal.notify_all();
+}
+
+}  // end namespace Components
@@ -0,0 +1,91 @@
+// ======================================================================
+// \title  VirtualClock.hpp
+// \brief  hpp file for VirtualClock component implementation class
+// ======================================================================
+
+#ifndef VirtualClock_HPP
+#define VirtualClock_HPP
+
+#include <Utils/MutexProfile/MutexProfile.hpp>
+#include "Components/VirtualClock/VirtualClockComponentAc.hpp"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace Components {
+
+//! \class VirtualClock
+//! \brief Time source reporting wall-clock time, or a virtual time that only moves when advanced
+//!
+//! Virtual time reaches the components that request time through the `timeCaller` ports, and the timeouts they count
+//! in rate group cycles. Anything paced by the operating system still runs on wall time while virtual time is reported:
+//! `Os::Task::delay` calls (e.g. the socket reconnect interval of `comm`), the Led PWM timer thread, which sleeps on
+//! CLOCK_MONOTONIC, and durations measured with `Svc::TimerVal` such as the rate groups' `RgMaxTime`. A run in
+//! virtual time therefore mixes the two timelines wherever such pacing is involved.
+class VirtualClock : public VirtualClockComponentBase {
+  public:
+    // ----------------------------------------------------------------------
+    // Construction, initialization, and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct object VirtualClock
+    //!
+    VirtualClock(const char* const compName /*!< The component name*/
+    );
+
+    //! Destroy object VirtualClock
+    //!
+    ~VirtualClock();
+
+    //! Switch between wall-clock and virtual time. Virtual time starts from the current wall-clock time, or from where it
+    //! stopped when that is later, so that the time reported never moves backwards across switches.
+    //!
+    void setVirtual(bool enabled /*!< true to report virtual time*/
+    );
+
+    //! Advance virtual time
+    //!
+    void advance(U32 microseconds /*!< Amount of time to advance by*/
+    );
+
+    //! \return true when virtual time is reported
+    bool isVirtualTime();
+
+    //! \return number of cycles completed by a rate group
+    U32 getCompletedCycles(NATIVE_INT_TYPE rateGroup /*!< Index of the rate group*/
+    );
+
+    //! Block until a rate group has completed a number of cycles in total
+    //!
+    void waitForCycles(NATIVE_INT_TYPE rateGroup, /*!< Index of the rate group*/
+                       U32 cycles                 /*!< Total completed cycles to wait for*/
+    );
+
+  PRIVATE:
+    // ----------------------------------------------------------------------
+    // Handler implementations for user-defined typed input ports
+    // ----------------------------------------------------------------------
+
+    //! Handler implementation for timeGetPort
+    //!
+    void timeGetPort_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                             Fw::Time& time                 /*!< The time tag*/
+    );
+
+    //! Handler implementation for cycleDone
+    //!
+    void cycleDone_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                           NATIVE_UINT_TYPE context       /*!< The call order*/
+    );
+
+    Utils::NamedMutex lock;                          //! Protects virtual time from concurrent callers
+    bool isVirtual;                                  //! Flag: if true virtual time is reported
+    U64 virtualTime;                                 //! Virtual time in microseconds
+    std::mutex cycleLock;                            //! Protects the cycle counters, waited on by waitForCycles
+    std::condition_variable cycleSignal;             //! Signalled on every cycle completion
+    U32 completedCycles[NUM_CYCLEDONE_INPUT_PORTS];  //! Cycles completed per rate group
+};
+
+}  // end namespace Components
+
+#endif
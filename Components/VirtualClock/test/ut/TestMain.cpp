@@ -0,0 +1,20 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "Tester.hpp"
+
+TEST(Nominal, TestVirtualTime) {
+    Components::Tester tester;
+    tester.testVirtualTime();
+}
+
+TEST(Nominal, TestCycleDone) {
+    Components::Tester tester;
+    tester.testCycleDone();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
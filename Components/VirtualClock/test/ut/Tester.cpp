@@ -0,0 +1,72 @@
+// ======================================================================
+// \title  VirtualClock/test/ut/Tester.cpp
+// \brief  cpp file for VirtualClock test harness implementation class
+// ======================================================================
+
+#include "Tester.hpp"
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+// Construction and destruction
+// ----------------------------------------------------------------------
+
+Tester ::Tester() : VirtualClockGTestBase("Tester", Tester::MAX_HISTORY_SIZE), component("VirtualClock") {
+    this->initComponents();
+    this->connectPorts();
+}
+
+Tester ::~Tester() {}
+
+// ----------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------
+
+void Tester ::testVirtualTime() {
+    // Virtual time starts from the wall-clock time when enabled
+    Fw::Time start;
+    Fw::Time later;
+    this->component.setVirtual(true);
+    this->invoke_to_timeGetPort(0, start);
+    ASSERT_GT(start.getSeconds(), 0u);
+
+    // Time does not move until advanced, then moves by exactly the amount advanced
+    this->invoke_to_timeGetPort(0, later);
+    ASSERT_EQ(Fw::Time::compare(start, later), Fw::Time::EQ);
+    this->component.advance(1500000);
+    this->invoke_to_timeGetPort(0, later);
+    Fw::Time elapsed = Fw::Time::sub(later, start);
+    ASSERT_EQ(elapsed.getSeconds(), 1u);
+    ASSERT_EQ(elapsed.getUSeconds(), 500000u);
+
+    // Wall-clock time is reported once virtual time is disabled
+    this->component.setVirtual(false);
+    this->invoke_to_timeGetPort(0, later);
+    ASSERT_EQ(later.getTimeBase(), TB_WORKSTATION_TIME);
+
+    // Virtual time ahead of the wall clock resumes where it stopped instead of moving backwards
+    Fw::Time resumed;
+    this->component.setVirtual(true);
+    this->component.advance(3600000000u);
+    this->invoke_to_timeGetPort(0, later);
+    this->component.setVirtual(false);
+    this->component.setVirtual(true);
+    this->invoke_to_timeGetPort(0, resumed);
+    ASSERT_EQ(Fw::Time::compare(later, resumed), Fw::Time::EQ);
+    ASSERT_TRUE(this->component.isVirtualTime());
+}
+
+void Tester ::testCycleDone() {
+    this->invoke_to_cycleDone(0, 0);
+    this->invoke_to_cycleDone(0, 0);
+    this->invoke_to_cycleDone(2, 0);
+    ASSERT_EQ(this->component.getCompletedCycles(0), 2u);
+    ASSERT_EQ(this->component.getCompletedCycles(1), 0u);
+    ASSERT_EQ(this->component.getCompletedCycles(2), 1u);
+
+    // Waiting for cycles already completed returns at once
+    this->component.waitForCycles(0, 2);
+    this->component.waitForCycles(1, 0);
+}
+
+}  // end namespace Components
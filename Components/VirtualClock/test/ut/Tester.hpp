@@ -0,0 +1,71 @@
+// ======================================================================
+// \title  VirtualClock/test/ut/Tester.hpp
+// \brief  hpp file for VirtualClock test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "Components/VirtualClock/VirtualClock.hpp"
+#include "GTestBase.hpp"
+
+namespace Components {
+
+class Tester : public VirtualClockGTestBase {
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+  public:
+    // Maximum size of histories storing events, telemetry, and port outputs
+    static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 10;
+    // Instance ID supplied to the component instance under test
+    static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+
+    //! Construct object Tester
+    //!
+    Tester();
+
+    //! Destroy object Tester
+    //!
+    ~Tester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    //! Virtual time only moves when advanced
+    //!
+    void testVirtualTime();
+
+    //! Cycle completions are counted per rate group
+    //!
+    void testCycleDone();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper methods
+    // ----------------------------------------------------------------------
+
+    //! Connect ports
+    //!
+    void connectPorts();
+
+    //! Initialize components
+    //!
+    void initComponents();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Variables
+    // ----------------------------------------------------------------------
+
+    //! The component under test
+    //!
+    VirtualClock component;
+};
+
+}  // end namespace Components
+
+#endif
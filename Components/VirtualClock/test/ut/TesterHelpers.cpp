@@ -0,0 +1,31 @@
+// ======================================================================
+// \title  VirtualClock/test/ut/TesterHelpers.cpp
+// \author Auto-generated
+// \brief  cpp file for VirtualClock component test harness base class
+//
+// NOTE: this file was automatically generated
+//
+// ======================================================================
+#include "Tester.hpp"
+
+namespace Components {
+// ----------------------------------------------------------------------
+// Helper methods
+// ----------------------------------------------------------------------
+
+void Tester ::connectPorts() {
+    // timeGetPort
+    this->connect_to_timeGetPort(0, this->component.get_timeGetPort_InputPort(0));
+
+    // cycleDone
+    for (NATIVE_INT_TYPE i = 0; i < 3; ++i) {
+        this->connect_to_cycleDone(i, this->component.get_cycleDone_InputPort(i));
+    }
+}
+
+void Tester ::initComponents() {
+    this->init();
+    this->component.init(Tester::TEST_INSTANCE_ID);
+}
+
+}  // end namespace Components
@@ -0,0 +1,129 @@
+// ======================================================================
+// \title  TimingWheel.cpp
+// \brief  cpp file for a hierarchical timing wheel of fixed entries
+// ======================================================================
+
+#include <Components/WheelRateGroup/TimingWheel.hpp>
+#include <Fw/Types/Assert.hpp>
+
+namespace Components {
+
+TimingWheel ::TimingWheel() : m_now(0) {
+    for (U32 i = 0; i < MAX_ENTRIES; i++) {
+        this->m_nodes[i].due = 0;
+        this->m_nodes[i].prev = NIL;
+        this->m_nodes[i].next = NIL;
+        this->m_nodes[i].slot = 0;
+        this->m_nodes[i].linked = false;
+    }
+    for (U32 i = 0; i < (LEVELS * SLOTS); i++) {
+        this->m_heads[i] = NIL;
+    }
+}
+
+U64 TimingWheel ::getNow() const {
+    return this->m_now;
+}
+
+void TimingWheel ::schedule(U32 entry, U64 due) {
+    FW_ASSERT(entry < MAX_ENTRIES, entry);
+    FW_ASSERT(due > this->m_now, static_cast<NATIVE_INT_TYPE>(due), static_cast<NATIVE_INT_TYPE>(this->m_now));
+    this->unlink(entry);
+    this->m_nodes[entry].due = due;
+    this->insert(entry);
+}
+
+void TimingWheel ::cancel(U32 entry) {
+    FW_ASSERT(entry < MAX_ENTRIES, entry);
+    this->unlink(entry);
+}
+
+bool TimingWheel ::isScheduled(U32 entry) const {
+    FW_ASSERT(entry < MAX_ENTRIES, entry);
+    return this->m_nodes[entry].linked;
+}
+
+U64 TimingWheel ::getDue(U32 entry) const {
+    FW_ASSERT(this->isScheduled(entry), entry);
+    return this->m_nodes[entry].due;
+}
+
+U32 TimingWheel ::advance(U32* due, U32 capacity) {
+    FW_ASSERT(due != nullptr);
+    FW_ASSERT(capacity >= MAX_ENTRIES, capacity);
+    this->m_now = this->m_now + 1;
+
+    // Entering a new block of a level moves that block's entries down, highest level first
+    for (U32 level = LEVELS - 1; level > 0; level--) {
+        const U64 mask = (static_cast<U64>(1) << (SLOT_BITS * level)) - 1;
+        if ((this->m_now & mask) != 0) {
+            continue;
+        }
+        const U32 slot = (level * SLOTS) + static_cast<U32>((this->m_now >> (SLOT_BITS * level)) & (SLOTS - 1));
+        U16 entry = this->m_heads[slot];
+        this->m_heads[slot] = NIL;
+        while (entry != NIL) {
+            const U16 next = this->m_nodes[entry].next;
+            this->m_nodes[entry].linked = false;
+            this->insert(entry);
+            entry = next;
+        }
+    }
+
+    // Every entry in the level 0 slot of this tick is due now
+    const U32 slot = static_cast<U32>(this->m_now & (SLOTS - 1));
+    U32 count = 0;
+    U16 entry = this->m_heads[slot];
+    this->m_heads[slot] = NIL;
+    while (entry != NIL) {
+        FW_ASSERT(this->m_nodes[entry].due == this->m_now, entry);
+        const U16 next = this->m_nodes[entry].next;
+        this->m_nodes[entry].linked = false;
+        due[count] = entry;
+        count++;
+        entry = next;
+    }
+    return count;
+}
+
+void TimingWheel ::insert(U32 entry) {
+    Node& node = this->m_nodes[entry];
+    FW_ASSERT(!node.linked, entry);
+
+    // The level is set by how far ahead the entry is. Beyond the last level it waits in the furthest slot.
+    const U64 horizon = static_cast<U64>(1) << (SLOT_BITS * LEVELS);
+    const U64 delta = node.due - this->m_now;
+    const U64 target = (delta < horizon) ? node.due : (this->m_now + horizon - 1);
+    U32 level = 0;
+    while ((level < (LEVELS - 1)) && ((target - this->m_now) >= (static_cast<U64>(1) << (SLOT_BITS * (level + 1))))) {
+        level++;
+    }
+    const U32 slot = (level * SLOTS) + static_cast<U32>((target >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+    node.slot = static_cast<U16>(slot);
+    node.prev = NIL;
+    node.next = this->m_heads[slot];
+    if (node.next != NIL) {
+        this->m_nodes[node.next].prev = static_cast<U16>(entry);
+    }
+    this->m_heads[slot] = static_cast<U16>(entry);
+    node.linked = true;
+}
+
+void TimingWheel ::unlink(U32 entry) {
+    Node& node = this->m_nodes[entry];
+    if (!node.linked) {
+        return;
+    }
+    if (node.prev != NIL) {
+        this->m_nodes[node.prev].next = node.next;
+    } else {
+        this->m_heads[node.slot] = node.next;
+    }
+    if (node.next != NIL) {
+        this->m_nodes[node.next].prev = node.prev;
+    }
+    node.linked = false;
+}
+
+}  // end namespace Components
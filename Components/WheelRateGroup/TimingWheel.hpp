@@ -0,0 +1,84 @@
+// ======================================================================
+// \title  TimingWheel.hpp
+// \brief  hpp file for a hierarchical timing wheel of fixed entries
+// ======================================================================
+
+#ifndef TimingWheel_HPP
+#define TimingWheel_HPP
+
+#include <FpConfig.hpp>
+
+namespace Components {
+
+//! \class TimingWheel
+//! \brief Hierarchical timing wheel scheduling a fixed set of entries by tick
+//!
+//! Four levels of 64 slots cover 2^24 ticks ahead; entries further out wait in the last level and are placed again as
+//! time approaches. Entries are linked into their slot in place, so scheduling and cancelling are constant time and
+//! advancing a tick costs the entries due plus any moved down from a higher level.
+class TimingWheel {
+  public:
+    //! Maximum number of entries
+    static const U32 MAX_ENTRIES = 256;
+    //! Number of levels
+    static const U32 LEVELS = 4;
+    //! log2 of the number of slots per level
+    static const U32 SLOT_BITS = 6;
+    //! Number of slots per level
+    static const U32 SLOTS = 1 << SLOT_BITS;
+
+    TimingWheel();
+
+    //! \return current tick
+    U64 getNow() const;
+
+    //! Schedule an entry, replacing any tick it was scheduled for
+    //!
+    void schedule(U32 entry, /*!< Index of the entry*/
+                  U64 due    /*!< Tick it is due, later than the current tick*/
+    );
+
+    //! Cancel an entry. Nothing happens when it is not scheduled.
+    //!
+    void cancel(U32 entry /*!< Index of the entry*/
+    );
+
+    //! \return true when an entry is scheduled
+    bool isScheduled(U32 entry) const;
+
+    //! \return tick an entry is scheduled for. Entry must be scheduled.
+    U64 getDue(U32 entry) const;
+
+    //! Move to the next tick and take the entries due on it. Taken entries are no longer scheduled.
+    //!
+    //! \return number of entries due
+    U32 advance(U32* due,     /*!< Out: indices of the entries due*/
+                U32 capacity  /*!< Capacity of due, at least MAX_ENTRIES*/
+    );
+
+  PRIVATE:
+    //! Link an entry into the slot for its due tick relative to the current tick
+    void insert(U32 entry);
+
+    //! Unlink an entry from its slot
+    void unlink(U32 entry);
+
+    //! An entry: its due tick and links within its slot
+    struct Node {
+        U64 due;      //!< Tick the entry is due
+        U16 prev;     //!< Previous entry in the slot, NIL at the head
+        U16 next;     //!< Next entry in the slot, NIL at the tail
+        U16 slot;     //!< Index of the slot, level * SLOTS + slot within the level
+        bool linked;  //!< Flag: if true the entry is scheduled
+    };
+
+    static const U16 NIL = 0xFFFF;
+
+    U64 m_now;                        //!< Current tick
+    Node m_nodes[MAX_ENTRIES];        //!< Entries
+    U16 m_heads[LEVELS * SLOTS];      //!< First entry of each slot
+};
+
+}  // end namespace Components
+
+#endif
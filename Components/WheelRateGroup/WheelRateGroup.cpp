@@ -0,0 +1,332 @@
+// ======================================================================
+// \title  WheelRateGroup.cpp
+// \brief  cpp file for WheelRateGroup component implementation class
+// ======================================================================
+
+#include <Components/WheelRateGroup/WheelRateGroup.hpp>
+#include <FpConfig.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Os/File.hpp>
+#include <Utils/PortTrace/PortTrace.hpp>
+
+#include <time.h>
+#include <cstdio>
+
+namespace Components {
+
+namespace {
+//! Thread CPU time in microseconds
+U64 threadCpuTime() {
+    struct timespec now;
+    (void)clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (static_cast<U64>(now.tv_sec) * 1000000) + (static_cast<U64>(now.tv_nsec) / 1000);
+}
+}  // namespace
+
+static_assert(WheelRateGroup::MAX_MEMBERS <= TimingWheel::MAX_ENTRIES, "Timing wheel too small for all members");
+static_assert(WheelRateGroup::MAX_MEMBERS == WheelRateGroup::NUM_WAKEUP_INPUT_PORTS,
+              "Each member needs a wakeup port");
+
+// ----------------------------------------------------------------------
+// Construction, initialization, and destruction
+// ----------------------------------------------------------------------
+
+WheelRateGroup ::WheelRateGroup(const char* const compName)
+    : WheelRateGroupComponentBase(compName),
+      lock("WheelRateGroup.lock"),
+      configured(false),
+      cycleStarted(false),
+      maxTime(0),
+      cycleSlips(0),
+      cyclesDropped(0),
+      historyNext(0),
+      historyCount(0),
+      frozenCount(0),
+      slipCpuTime(0),
+      cyclePerfCount(0) {
+    for (U32 i = 0; i < MEMBER_WORDS; i++) {
+        this->connected[i] = 0;
+        this->declared[i] = 0;
+    }
+    const Utils::PerfCounters::Sample zero = {0, 0, 0, 0, 0, 0};
+    this->cyclePerf = zero;
+    for (U32 i = 0; i < MAX_MEMBERS; i++) {
+        this->memberPerf[i] = zero;
+        this->memberPerfCalls[i] = 0;
+    }
+}
+
+WheelRateGroup ::~WheelRateGroup() {}
+
+// ----------------------------------------------------------------------
+// Command handler implementations
+// ----------------------------------------------------------------------
+
+void WheelRateGroup ::PERF_COUNTERS_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, Fw::On on_off) {
+    if (!on_off.isValid()) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+        return;
+    }
+    // Counters count the thread that opens them. This handler runs on the rate group thread.
+    if (Fw::On::ON == on_off) {
+        const I32 error = this->perf.isOpen() ? 0 : this->perf.open();
+        if (error != 0) {
+            this->log_WARNING_LO_PerfCountersUnavailable(error);
+            this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+            return;
+        }
+        const Utils::PerfCounters::Sample zero = {0, 0, 0, 0, 0, 0};
+        this->cyclePerf = zero;
+        this->cyclePerfCount = 0;
+        for (U32 i = 0; i < MAX_MEMBERS; i++) {
+            this->memberPerf[i] = zero;
+            this->memberPerfCalls[i] = 0;
+        }
+        this->lastMemberPerf = WheelRateGroupMemberPerf();
+    } else {
+        this->perf.close();
+    }
+    this->log_ACTIVITY_HI_PerfCountersState(on_off);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+void WheelRateGroup ::DUMP_PERF_cmdHandler(const FwOpcodeType opCode,
+                                           const U32 cmdSeq,
+                                           const Fw::CmdStringArg& fileName) {
+    Fw::LogStringArg fileArg(fileName.toChar());
+    Os::File file;
+    if (Os::File::OP_OK != file.open(fileName.toChar(), Os::File::OPEN_WRITE)) {
+        this->log_WARNING_HI_PerfDumpError(fileArg);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+
+    char row[128];
+    NATIVE_INT_TYPE length = snprintf(row, sizeof(row), "cycle,%u,%llu,%llu,%llu,%llu\n", this->cyclePerfCount,
+                                      static_cast<unsigned long long>(this->cyclePerf.cycles),
+                                      static_cast<unsigned long long>(this->cyclePerf.instructions),
+                                      static_cast<unsigned long long>(this->cyclePerf.cacheMisses),
+                                      static_cast<unsigned long long>(this->cyclePerf.branchMisses));
+    bool ok = (Os::File::OP_OK == file.write(row, length));
+    U32 members = 0;
+    for (U32 i = 0; ok && (i < MAX_MEMBERS); i++) {
+        if (0 == this->memberPerfCalls[i]) {
+            continue;
+        }
+        const Utils::PerfCounters::Sample& counts = this->memberPerf[i];
+        length = snprintf(row, sizeof(row), "%u,%u,%llu,%llu,%llu,%llu\n", i, this->memberPerfCalls[i],
+                          static_cast<unsigned long long>(counts.cycles),
+                          static_cast<unsigned long long>(counts.instructions),
+                          static_cast<unsigned long long>(counts.cacheMisses),
+                          static_cast<unsigned long long>(counts.branchMisses));
+        ok = (Os::File::OP_OK == file.write(row, length));
+        members++;
+    }
+    file.close();
+
+    if (!ok) {
+        this->log_WARNING_HI_PerfDumpError(fileArg);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->log_ACTIVITY_HI_PerfDumped(members, fileArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+void WheelRateGroup ::DUMP_SLIP_cmdHandler(const FwOpcodeType opCode,
+                                           const U32 cmdSeq,
+                                           const Fw::CmdStringArg& fileName) {
+    // Runs on the rate group thread between cycles, so no slip can change the frozen cycles during the write
+    const U32 cycles = this->frozenCount;
+    Fw::LogStringArg fileArg(fileName.toChar());
+    Os::File file;
+    if ((0 == cycles) || (Os::File::OP_OK != file.open(fileName.toChar(), Os::File::OPEN_WRITE))) {
+        this->log_WARNING_HI_SlipDumpError(fileArg);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+
+    bool ok = true;
+    for (U32 i = 0; ok && (i < cycles); i++) {
+        const CycleRecord& record = this->frozen[i];
+        for (U32 j = 0; ok && (j < record.count); j++) {
+            char row[64];
+            NATIVE_INT_TYPE length = snprintf(row, sizeof(row), "%u,%u,%u,%u\n", record.cycle, record.members[j],
+                                              record.durations[j], record.queueDepth);
+            ok = (Os::File::OP_OK == file.write(row, length));
+        }
+    }
+    file.close();
+
+    if (!ok) {
+        this->log_WARNING_HI_SlipDumpError(fileArg);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->log_ACTIVITY_HI_SlipDumped(cycles, fileArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+// ----------------------------------------------------------------------
+// Handler implementations for user-defined typed input ports
+// ----------------------------------------------------------------------
+
+void WheelRateGroup ::CycleIn_handler(const NATIVE_INT_TYPE portNum, Svc::TimerVal& cycleStart) {
+    PORT_TRACE_SCOPE("WheelRateGroup.CycleIn", static_cast<U32>(portNum));
+    this->cycleStarted.store(false, std::memory_order_relaxed);
+    const U32 queued = static_cast<U32>(this->m_queue.getNumMsgs());
+
+    // Find the members due under the lock, then call them without it so that they may declare wakeups
+    U32 taken[TimingWheel::MAX_ENTRIES];
+    U64 due[MEMBER_WORDS];
+    this->lock.lock();
+    if (!this->configured) {
+        for (U32 member = 0; member < MAX_MEMBERS; member++) {
+            if (this->isConnected_RateGroupMemberOut_OutputPort(member)) {
+                this->connected[member / 64] |= static_cast<U64>(1) << (member % 64);
+            }
+        }
+        this->configured = true;
+    }
+    const U32 count = this->wheel.advance(taken, FW_NUM_ARRAY_ELEMENTS(taken));
+    const U32 cycle = static_cast<U32>(this->wheel.getNow());
+    for (U32 i = 0; i < MEMBER_WORDS; i++) {
+        due[i] = this->connected[i] & ~this->declared[i];
+    }
+    for (U32 i = 0; i < count; i++) {
+        due[taken[i] / 64] |= (static_cast<U64>(1) << (taken[i] % 64)) & this->connected[taken[i] / 64];
+    }
+    this->lock.unLock();
+
+    // Members are called in port order, visiting only the members due. Each call is timed into the cycle's record,
+    // which is only read should the cycle slip. The monotonic clock is read without a system call; the thread CPU clock
+    // needs one, so it is read only once a slip is detected.
+    CycleRecord& record = this->history[this->historyNext];
+    record.cycle = cycle;
+    record.queueDepth = queued;
+    U32 called = 0;
+    // A cycle whose counters cannot be read at its start is not counted, rather than reporting counts from zero
+    Utils::PerfCounters::Sample cycleCounts;
+    Utils::PerfCounters::Sample previousCounts;
+    const bool counting = this->perf.isOpen() && this->perf.read(cycleCounts);
+    if (counting) {
+        previousCounts = cycleCounts;
+    }
+    Svc::TimerVal end;
+    end.take();
+    for (U32 i = 0; i < MEMBER_WORDS; i++) {
+        U64 bits = due[i];
+        while (bits != 0) {
+            const U32 member = (i * 64) + static_cast<U32>(__builtin_ctzll(bits));
+            PORT_TRACE_BEGIN("WheelRateGroup.RateGroupMemberOut", member);
+            this->RateGroupMemberOut_out(static_cast<NATIVE_INT_TYPE>(member), cycle);
+            PORT_TRACE_END();
+            Svc::TimerVal returned;
+            returned.take();
+            record.members[called] = static_cast<U16>(member);
+            record.durations[called] = returned.diffUSec(end);
+            end = returned;
+            if (counting) {
+                this->countMember(member, previousCounts);
+            }
+            called++;
+            bits &= bits - 1;
+        }
+    }
+    record.count = called;
+    if (counting) {
+        cycleCounts = previousCounts - cycleCounts;
+    }
+    // Counts of a cycle the kernel multiplexed are scaled, and a cycle the counters never ran in is not counted
+    if (counting && cycleCounts.scale()) {
+        this->cyclePerf += cycleCounts;
+        this->cyclePerfCount = this->cyclePerfCount + 1;
+        this->tlmWrite_RgCyclePerf(toPerf(cycleCounts));
+        this->tlmWrite_RgMemberPerf(this->lastMemberPerf);
+    }
+    this->historyNext = (this->historyNext + 1) % SLIP_HISTORY;
+    this->historyCount = (this->historyCount < SLIP_HISTORY) ? (this->historyCount + 1) : SLIP_HISTORY;
+
+    const U32 cycleTime = end.diffUSec(cycleStart);
+    this->maxTime = (cycleTime > this->maxTime) ? cycleTime : this->maxTime;
+    // Cycles dropped since the last one run never called their members, so each counts as a slip. CycleIn is the only
+    // port that drops messages.
+    const U32 dropped = static_cast<U32>(this->getNumMsgsDropped()) - this->cyclesDropped;
+    this->cyclesDropped = this->cyclesDropped + dropped;
+    const U32 slipped = (this->cycleStarted.load(std::memory_order_relaxed) ? 1 : 0) + dropped;
+    if (slipped > 0) {
+        this->cycleSlips = this->cycleSlips + slipped;
+        this->log_WARNING_HI_RateGroupCycleSlip(cycle);
+        this->tlmWrite_RgCycleSlips(this->cycleSlips);
+        const U64 cpuTime = threadCpuTime();
+        this->captureSlip(record, cycleTime, static_cast<U32>(cpuTime - this->slipCpuTime));
+        this->slipCpuTime = cpuTime;
+    }
+    this->tlmWrite_RgMaxTime(this->maxTime);
+    this->tlmWrite_RgDueMembers(called);
+}
+
+void WheelRateGroup ::countMember(U32 member, Utils::PerfCounters::Sample& previous) {
+    Utils::PerfCounters::Sample now;
+    if (!this->perf.read(now)) {
+        return;
+    }
+    Utils::PerfCounters::Sample call = now - previous;
+    previous = now;
+    if (!call.scale()) {
+        return;
+    }
+    this->memberPerf[member] += call;
+    this->memberPerfCalls[member] = this->memberPerfCalls[member] + 1;
+    if (member < PERF_MEMBERS) {
+        this->lastMemberPerf[member] = toPerf(call);
+    }
+}
+
+WheelRateGroupPerf WheelRateGroup ::toPerf(const Utils::PerfCounters::Sample& counts) {
+    return WheelRateGroupPerf(counts.cycles, counts.instructions, counts.cacheMisses, counts.branchMisses);
+}
+
+void WheelRateGroup ::captureSlip(const CycleRecord& slipped, U32 cycleTime, U32 cpuTime) {
+    for (U32 i = 0; i < this->historyCount; i++) {
+        const U32 index = (this->historyNext + SLIP_HISTORY - this->historyCount + i) % SLIP_HISTORY;
+        this->frozen[i] = this->history[index];
+    }
+    this->frozenCount = this->historyCount;
+
+    WheelRateGroupSlip slip(slipped.cycle, 0, 0, cycleTime, cpuTime,
+                            static_cast<U32>(this->m_queue.getNumMsgs()));
+    for (U32 i = 0; i < slipped.count; i++) {
+        if ((0 == i) || (slipped.durations[i] > slip.getmemberTime())) {
+            slip.setmember(slipped.members[i]);
+            slip.setmemberTime(slipped.durations[i]);
+        }
+    }
+    this->tlmWrite_RgLastSlip(slip);
+}
+
+void WheelRateGroup ::CycleIn_preMsgHook(const NATIVE_INT_TYPE portNum, Svc::TimerVal& cycleStart) {
+    this->cycleStarted.store(true, std::memory_order_relaxed);
+}
+
+void WheelRateGroup ::wakeup_handler(const NATIVE_INT_TYPE portNum, U32 delay) {
+    FW_ASSERT(portNum >= 0 && static_cast<U32>(portNum) < MAX_MEMBERS, portNum);
+    const U32 member = static_cast<U32>(portNum);
+    this->lock.lock();
+    this->declared[member / 64] |= static_cast<U64>(1) << (member % 64);
+    if (NEVER == delay) {
+        this->wheel.cancel(member);
+    } else {
+        const U64 due = this->wheel.getNow() + ((delay > 0) ? delay : 1);
+        if (!this->wheel.isScheduled(member) || (due < this->wheel.getDue(member))) {
+            this->wheel.schedule(member, due);
+        }
+    }
+    this->lock.unLock();
+}
+
+void WheelRateGroup ::PingIn_handler(const NATIVE_INT_TYPE portNum, U32 key) {
+    this->PingOut_out(0, key);
+}
+
+}  // end namespace Components
@@ -0,0 +1,148 @@
+// ======================================================================
+// \title  WheelRateGroup.hpp
+// \brief  hpp file for WheelRateGroup component implementation class
+// ======================================================================
+
+#ifndef WheelRateGroup_HPP
+#define WheelRateGroup_HPP
+
+#include <Utils/MutexProfile/MutexProfile.hpp>
+#include <Utils/PerfCounters/PerfCounters.hpp>
+#include "Components/WheelRateGroup/TimingWheel.hpp"
+#include "Components/WheelRateGroup/WheelRateGroupComponentAc.hpp"
+
+#include <atomic>
+
+namespace Components {
+
+class WheelRateGroup : public WheelRateGroupComponentBase {
+  public:
+    //! Wakeup delay declaring a member has nothing due until it declares again
+    static const U32 NEVER = 0xFFFFFFFF;
+    //! Number of members
+    static const U32 MAX_MEMBERS = NUM_RATEGROUPMEMBEROUT_OUTPUT_PORTS;
+    //! Number of 64-bit words in a set of members
+    static const U32 MEMBER_WORDS = (MAX_MEMBERS + 63) / 64;
+    //! Cycles whose member timings are kept, and frozen when a cycle slips
+    static const U32 SLIP_HISTORY = 4;
+    //! Members whose last call counts are reported as telemetry
+    static const U32 PERF_MEMBERS = WheelRateGroupMemberPerf::SIZE;
+
+    // ----------------------------------------------------------------------
+    // Construction, initialization, and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct object WheelRateGroup
+    //!
+    WheelRateGroup(const char* const compName /*!< The component name*/
+    );
+
+    //! Destroy object WheelRateGroup
+    //!
+    ~WheelRateGroup();
+
+  PRIVATE:
+    //! Member timings of one cycle
+    struct CycleRecord {
+        U32 cycle;                    //!< Cycle number
+        U32 queueDepth;               //!< Messages waiting on the queue when the cycle began
+        U32 count;                    //!< Number of members called
+        U16 members[MAX_MEMBERS];     //!< Members called, in call order
+        U32 durations[MAX_MEMBERS];   //!< Wall time of each call in microseconds
+    };
+
+    // ----------------------------------------------------------------------
+    // Command handler implementations
+    // ----------------------------------------------------------------------
+
+    //! Implementation for PERF_COUNTERS command handler
+    //! Start or stop counting CPU cycles, instructions, cache misses and branch misses of each cycle and member call
+    void PERF_COUNTERS_cmdHandler(const FwOpcodeType opCode, /*!< The opcode*/
+                                  const U32 cmdSeq,          /*!< The command sequence number*/
+                                  Fw::On on_off              /*!< Whether to count*/
+    );
+
+    //! Implementation for DUMP_PERF command handler
+    //! Write the counts accumulated since counting started to a file
+    void DUMP_PERF_cmdHandler(const FwOpcodeType opCode,       /*!< The opcode*/
+                              const U32 cmdSeq,                /*!< The command sequence number*/
+                              const Fw::CmdStringArg& fileName /*!< Path of the file written*/
+    );
+
+    //! Implementation for DUMP_SLIP command handler
+    //! Write the member timings of the cycles up to the last slip to a file
+    void DUMP_SLIP_cmdHandler(const FwOpcodeType opCode,       /*!< The opcode*/
+                              const U32 cmdSeq,                /*!< The command sequence number*/
+                              const Fw::CmdStringArg& fileName /*!< Path of the file written*/
+    );
+
+  PRIVATE:
+    // ----------------------------------------------------------------------
+    // Handler implementations for user-defined typed input ports
+    // ----------------------------------------------------------------------
+
+    //! Handler implementation for CycleIn
+    //! Call the members due on the next cycle
+    void CycleIn_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                         Svc::TimerVal& cycleStart      /*!< Cycle start timestamp*/
+    );
+
+    //! Pre-message hook for CycleIn, noting a cycle has started so that a slip can be detected
+    //!
+    void CycleIn_preMsgHook(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                            Svc::TimerVal& cycleStart      /*!< Cycle start timestamp*/
+    );
+
+    //! Handler implementation for wakeup
+    //! Schedule member portNum, keeping a pending earlier wakeup so that requests from other threads are never lost.
+    //! NEVER cancels the pending wakeup, so a member declaring it must then check for work requested meanwhile.
+    void wakeup_handler(const NATIVE_INT_TYPE portNum, /*!< The port number, the index of the member*/
+                        U32 delay                      /*!< Cycles until the member is next called*/
+    );
+
+    //! Freeze the recorded cycles, ending with the one that slipped, and report the member that ran longest
+    void captureSlip(const CycleRecord& slipped, /*!< Record of the cycle that slipped*/
+                     U32 cycleTime,              /*!< Wall time of that cycle in microseconds*/
+                     U32 cpuTime                 /*!< CPU time of the thread since the previous slip in microseconds*/
+    );
+
+    //! Attribute the counts since previous to a member, advancing previous to now
+    void countMember(U32 member,                            /*!< The member just called*/
+                     Utils::PerfCounters::Sample& previous  /*!< Counts before the call. Out: counts after it.*/
+    );
+
+    //! \return counts as telemetry
+    static WheelRateGroupPerf toPerf(const Utils::PerfCounters::Sample& counts);
+
+    //! Handler implementation for PingIn
+    //!
+    void PingIn_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                        U32 key                        /*!< Value to return to pinger*/
+    );
+
+    Utils::NamedMutex lock;               //! Protects the wheel and member sets from wakeups on other threads
+    TimingWheel wheel;                    //! Wakeups of members that have declared one
+    U64 connected[MEMBER_WORDS];          //! Members connected, bit N for member N. Set on the first cycle.
+    U64 declared[MEMBER_WORDS];           //! Members that have declared a wakeup and are only called when due
+    bool configured;                      //! Flag: if true the connected members have been found
+    std::atomic<bool> cycleStarted;       //! Flag: if true a cycle was queued since the current cycle began
+    U32 maxTime;                          //! Longest cycle in microseconds
+    U32 cycleSlips;                       //! Number of cycles that slipped
+    U32 cyclesDropped;                    //! Number of cycles dropped with the queue full, as counted so far
+    CycleRecord history[SLIP_HISTORY];    //! Member timings of the last cycles, written only by the rate group thread
+    U32 historyNext;                      //! Index of history written by the next cycle
+    U32 historyCount;                     //! Number of cycles in history
+    CycleRecord frozen[SLIP_HISTORY];     //! Cycles up to the last slip, oldest first
+    U32 frozenCount;                      //! Number of cycles in frozen
+    U64 slipCpuTime;                      //! CPU time of the rate group thread at the last slip in microseconds
+    Utils::PerfCounters perf;             //! Counters of the rate group thread, open while counting
+    Utils::PerfCounters::Sample cyclePerf;                //! Counts of whole cycles since counting started
+    U32 cyclePerfCount;                                   //! Cycles counted
+    Utils::PerfCounters::Sample memberPerf[MAX_MEMBERS];  //! Counts of each member since counting started
+    U32 memberPerfCalls[MAX_MEMBERS];                     //! Calls of each member counted
+    WheelRateGroupMemberPerf lastMemberPerf;              //! Counts of the last call of each of the first members
+};
+
+}  // end namespace Components
+
+#endif
@@ -0,0 +1,50 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "Tester.hpp"
+
+TEST(Nominal, TestPeriodic) {
+    Components::Tester tester;
+    tester.testPeriodic();
+}
+
+TEST(Nominal, TestSparse) {
+    Components::Tester tester;
+    tester.testSparse();
+}
+
+TEST(Nominal, TestEarliestWakeup) {
+    Components::Tester tester;
+    tester.testEarliestWakeup();
+}
+
+TEST(Nominal, TestCycleSlip) {
+    Components::Tester tester;
+    tester.testCycleSlip();
+}
+
+TEST(Nominal, TestSlipCapture) {
+    Components::Tester tester;
+    tester.testSlipCapture();
+}
+
+TEST(Benchmark, TestPerfCounters) {
+    Components::Tester tester;
+    tester.testPerfCounters();
+}
+
+TEST(Nominal, TestTimingWheel) {
+    Components::Tester tester;
+    tester.testTimingWheel();
+}
+
+TEST(Benchmark, TestMemberScale) {
+    Components::Tester tester;
+    tester.testMemberScale();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
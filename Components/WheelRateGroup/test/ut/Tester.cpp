@@ -0,0 +1,388 @@
+// ======================================================================
+// \title  WheelRateGroup/test/ut/Tester.cpp
+// \brief  cpp file for WheelRateGroup test harness implementation class
+// ======================================================================
+
+#include "Tester.hpp"
+
+#include <Os/IntervalTimer.hpp>
+#include <Utils/TestFile/TestFile.hpp>
+#include <cstdio>
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+// Construction and destruction
+// ----------------------------------------------------------------------
+
+Tester ::Tester()
+    : WheelRateGroupGTestBase("Tester", Tester::MAX_HISTORY_SIZE),
+      component("WheelRateGroup"),
+      lastContext(0),
+      lastMember(-1),
+      slipCycle(0),
+      slowCycle(0),
+      slowMember(0),
+      checkDue(false) {
+    for (U32 i = 0; i < WheelRateGroup::MAX_MEMBERS; i++) {
+        this->calls[i] = 0;
+        this->delays[i] = 0;
+        this->expected[i] = 0;
+    }
+    this->initComponents();
+    this->connectPorts();
+}
+
+Tester ::~Tester() {}
+
+// ----------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------
+
+void Tester ::testPeriodic() {
+    this->connectMembers(3);
+    for (U32 i = 0; i < 5; i++) {
+        this->cycle();
+        ASSERT_TLM_RgDueMembers(0, 3);
+    }
+    for (U32 i = 0; i < 3; i++) {
+        ASSERT_EQ(this->calls[i], 5u);
+    }
+    ASSERT_EQ(this->lastContext, 5u);
+
+    // Health pings are answered
+    this->invoke_to_PingIn(0, 0x1234);
+    this->component.doDispatch();
+    ASSERT_from_PingOut_SIZE(1);
+    ASSERT_from_PingOut(0, 0x1234);
+}
+
+void Tester ::testSparse() {
+    // Delays either side of each level boundary. Member 0 declares nothing and stays periodic.
+    const U32 delays[] = {0, 1, 3, 63, 64, 65, 4095, 4096, 4097, 262145};
+    const U32 members = FW_NUM_ARRAY_ELEMENTS(delays);
+    const U32 cycles = 262200;
+    this->connectMembers(members);
+    for (U32 i = 0; i < members; i++) {
+        this->delays[i] = delays[i];
+    }
+    this->checkDue = true;
+
+    for (U32 cycle = 1; cycle <= cycles; cycle++) {
+        this->cycle();
+        // Every member is called on the first cycle, then only member 0 and the member due every cycle
+        if (2 == cycle) {
+            ASSERT_TLM_RgDueMembers(0, 2);
+        }
+    }
+
+    // Each member was called on the first cycle and then every time its delay elapsed
+    ASSERT_EQ(this->calls[0], cycles);
+    for (U32 i = 1; i < members; i++) {
+        ASSERT_EQ(this->calls[i], 1 + ((cycles - 1) / delays[i])) << "member " << i;
+    }
+}
+
+void Tester ::testEarliestWakeup() {
+    // Member 1 declares it has nothing due after each call
+    this->connectMembers(2);
+    this->delays[1] = WheelRateGroup::NEVER;
+    for (U32 cycle = 1; cycle <= 5; cycle++) {
+        this->cycle();
+    }
+    ASSERT_EQ(this->calls[0], 5u);
+    ASSERT_EQ(this->calls[1], 1u);
+
+    // Requests from elsewhere, as when a command is queued for the member. The earliest, cycle 8, is kept.
+    this->invoke_to_wakeup(1, 10);
+    this->invoke_to_wakeup(1, 3);
+    this->invoke_to_wakeup(1, 20);
+    for (U32 cycle = 6; cycle <= 30; cycle++) {
+        this->cycle();
+        ASSERT_EQ(this->calls[1], (cycle < 8) ? 1u : 2u) << "cycle " << cycle;
+    }
+
+    // Declaring nothing due cancels a pending request, so the idle member is not called again
+    this->invoke_to_wakeup(1, 5);
+    this->invoke_to_wakeup(1, WheelRateGroup::NEVER);
+    for (U32 cycle = 31; cycle <= 40; cycle++) {
+        this->cycle();
+    }
+    ASSERT_EQ(this->calls[1], 2u);
+}
+
+void Tester ::testCycleSlip() {
+    this->connectMembers(1);
+    this->slipCycle = 2;
+    this->cycle();
+    ASSERT_EVENTS_RateGroupCycleSlip_SIZE(0);
+
+    // The member queues the next cycle while cycle 2 runs
+    this->cycle();
+    ASSERT_EVENTS_RateGroupCycleSlip_SIZE(1);
+    ASSERT_EVENTS_RateGroupCycleSlip(0, 2);
+    ASSERT_TLM_RgCycleSlips(0, 1);
+
+    // The queued cycle runs normally
+    this->clearHistory();
+    this->component.doDispatch();
+    ASSERT_EVENTS_RateGroupCycleSlip_SIZE(0);
+    ASSERT_EQ(this->calls[0], 3u);
+
+    // Cycles arriving with the queue full are dropped, and counted as slips by the next cycle run
+    Svc::TimerVal start;
+    start.take();
+    for (NATIVE_INT_TYPE i = 0; i < (TEST_INSTANCE_QUEUE_DEPTH + 2); i++) {
+        this->invoke_to_CycleIn(0, start);
+    }
+    this->component.doDispatch();
+    ASSERT_EVENTS_RateGroupCycleSlip_SIZE(1);
+    ASSERT_EVENTS_RateGroupCycleSlip(0, 4);
+    ASSERT_TLM_RgCycleSlips(0, 3);
+    while (Fw::QueuedComponentBase::MSG_DISPATCH_OK == this->component.doDispatch()) {
+    }
+    ASSERT_EVENTS_RateGroupCycleSlip_SIZE(1);
+    ASSERT_EQ(this->calls[0], 3u + TEST_INSTANCE_QUEUE_DEPTH);
+}
+
+void Tester ::testSlipCapture() {
+    // Nothing to dump before a slip
+    const Utils::TestFile dumpFile("WheelRateGroupSlip.csv");
+    const char* const dump = dumpFile.get();
+    this->connectMembers(3);
+    this->sendCmd_DUMP_SLIP(0, 0, Fw::CmdStringArg(dump));
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(0, WheelRateGroup::OPCODE_DUMP_SLIP, 0, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_SlipDumpError_SIZE(1);
+
+    // Member 1 overruns cycle 6, which slips
+    this->slipCycle = 6;
+    this->slowCycle = 6;
+    this->slowMember = 1;
+    for (U32 cycle = 1; cycle <= 5; cycle++) {
+        this->cycle();
+        ASSERT_TLM_RgLastSlip_SIZE(0);
+    }
+    this->cycle();
+    ASSERT_EVENTS_RateGroupCycleSlip(0, 6);
+    ASSERT_TLM_RgLastSlip_SIZE(1);
+    const WheelRateGroupSlip& slip = this->tlmHistory_RgLastSlip->at(0).arg;
+    ASSERT_EQ(slip.getcycle(), 6u);
+    ASSERT_EQ(slip.getmember(), 1u);
+    ASSERT_GE(slip.getmemberTime(), SLOW_MEMBER_USEC);
+    ASSERT_GE(slip.getcycleTime(), slip.getmemberTime());
+    ASSERT_EQ(slip.getqueueDepth(), 1u);
+
+    // The queued cycle runs without changing the frozen record
+    this->component.doDispatch();
+
+    // The dump holds cycles 3 to 6, one row per member call
+    this->clearHistory();
+    this->sendCmd_DUMP_SLIP(0, 1, Fw::CmdStringArg(dump));
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(0, WheelRateGroup::OPCODE_DUMP_SLIP, 1, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_SlipDumped(0, WheelRateGroup::SLIP_HISTORY, dump);
+
+    FILE* file = fopen(dump, "r");
+    ASSERT_NE(file, nullptr);
+    U32 cycle = 0;
+    U32 member = 0;
+    U32 duration = 0;
+    U32 queueDepth = 0;
+    U32 rows = 0;
+    while (fscanf(file, "%u,%u,%u,%u\n", &cycle, &member, &duration, &queueDepth) == 4) {
+        ASSERT_EQ(cycle, 3 + (rows / 3));
+        ASSERT_EQ(member, rows % 3);
+        if ((6 == cycle) && (1 == member)) {
+            ASSERT_GE(duration, SLOW_MEMBER_USEC);
+        }
+        rows++;
+    }
+    (void)fclose(file);
+    ASSERT_EQ(rows, 3 * WheelRateGroup::SLIP_HISTORY);
+}
+
+void Tester ::testPerfCounters() {
+    this->connectMembers(3);
+    this->sendCmd_DUMP_PERF(0, 0, Fw::CmdStringArg("/does-not-exist/perf.csv"));
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(0, WheelRateGroup::OPCODE_DUMP_PERF, 0, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_PerfDumpError_SIZE(1);
+
+    this->clearHistory();
+    this->sendCmd_PERF_COUNTERS(0, 1, Fw::On::ON);
+    this->component.doDispatch();
+    if (this->eventHistory_PerfCountersUnavailable->size() > 0) {
+        ASSERT_CMD_RESPONSE(0, WheelRateGroup::OPCODE_PERF_COUNTERS, 1, Fw::CmdResponse::EXECUTION_ERROR);
+        GTEST_SKIP() << "perf_event_open unavailable, errno " << this->eventHistory_PerfCountersUnavailable->at(0).error;
+    }
+    ASSERT_CMD_RESPONSE(0, WheelRateGroup::OPCODE_PERF_COUNTERS, 1, Fw::CmdResponse::OK);
+
+    const U32 cycles = 100;
+    for (U32 cycle = 0; cycle < cycles; cycle++) {
+        this->cycle();
+    }
+    ASSERT_TLM_RgCyclePerf_SIZE(1);
+    ASSERT_GT(this->tlmHistory_RgCyclePerf->at(0).arg.getinstructions(), 0u);
+    ASSERT_TLM_RgMemberPerf_SIZE(1);
+    ASSERT_GT(this->tlmHistory_RgMemberPerf->at(0).arg[2].getinstructions(), 0u);
+
+    // Report the counts of each member
+    const Utils::TestFile dumpFile("WheelRateGroupPerf.csv");
+    const char* const dump = dumpFile.get();
+    this->sendCmd_DUMP_PERF(0, 2, Fw::CmdStringArg(dump));
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(0, WheelRateGroup::OPCODE_DUMP_PERF, 2, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_PerfDumped(0, 3, dump);
+
+    FILE* file = fopen(dump, "r");
+    ASSERT_NE(file, nullptr);
+    char member[16];
+    U32 calls = 0;
+    unsigned long long counts[4] = {};
+    U32 rows = 0;
+    while (fscanf(file, "%15[^,],%u,%llu,%llu,%llu,%llu\n", member, &calls, &counts[0], &counts[1], &counts[2],
+                  &counts[3]) == 6) {
+        ASSERT_EQ(calls, cycles);
+        (void)printf("[BENCH] %-6s %u calls: %llu cycles, %llu instructions, IPC %.2f, %llu cache misses, %llu branch "
+                     "misses\n",
+                     member, calls, counts[0], counts[1],
+                     (counts[0] > 0) ? (static_cast<F64>(counts[1]) / static_cast<F64>(counts[0])) : 0.0, counts[2],
+                     counts[3]);
+        rows++;
+    }
+    (void)fclose(file);
+    ASSERT_EQ(rows, 4u);
+
+    this->sendCmd_PERF_COUNTERS(0, 3, Fw::On::OFF);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(1, WheelRateGroup::OPCODE_PERF_COUNTERS, 3, Fw::CmdResponse::OK);
+}
+
+void Tester ::testTimingWheel() {
+    TimingWheel wheel;
+
+    // Dues at level boundaries and beyond the last level. Entry 6 is cancelled and entry 7 brought forward.
+    const U64 horizon = static_cast<U64>(1) << (TimingWheel::SLOT_BITS * TimingWheel::LEVELS);
+    const U64 dues[] = {1, 64, 4096, 262144, horizon + 5, (2 * horizon) + 3, 1000, 50};
+    const U32 entries = FW_NUM_ARRAY_ELEMENTS(dues);
+    for (U32 i = 0; i < entries; i++) {
+        wheel.schedule(i, (7 == i) ? 100 : dues[i]);
+    }
+    wheel.schedule(7, dues[7]);
+    wheel.cancel(6);
+    ASSERT_FALSE(wheel.isScheduled(6));
+    ASSERT_EQ(wheel.getDue(4), horizon + 5);
+
+    U32 fired[FW_NUM_ARRAY_ELEMENTS(dues)] = {};
+    U32 taken[TimingWheel::MAX_ENTRIES];
+    while (wheel.getNow() < dues[5]) {
+        const U32 count = wheel.advance(taken, FW_NUM_ARRAY_ELEMENTS(taken));
+        for (U32 i = 0; i < count; i++) {
+            ASSERT_LT(taken[i], entries);
+            ASSERT_EQ(wheel.getNow(), dues[taken[i]]) << "entry " << taken[i];
+            ASSERT_FALSE(wheel.isScheduled(taken[i]));
+            fired[taken[i]]++;
+        }
+    }
+    for (U32 i = 0; i < entries; i++) {
+        ASSERT_EQ(fired[i], (6 == i) ? 0u : 1u) << "entry " << i;
+    }
+}
+
+void Tester ::testMemberScale() {
+    // All members called on every cycle, as by Svc.ActiveRateGroup
+    this->connectMembers(WheelRateGroup::MAX_MEMBERS);
+    Os::IntervalTimer timer;
+    timer.start();
+    for (U32 cycle = 0; cycle < BENCHMARK_CYCLES; cycle++) {
+        this->cycle();
+    }
+    timer.stop();
+    U32 calls = 0;
+    for (U32 i = 0; i < WheelRateGroup::MAX_MEMBERS; i++) {
+        calls = calls + this->calls[i];
+    }
+    (void)printf("[BENCH] %u periodic members: %.1f ns per cycle, %.1f calls per cycle\n", WheelRateGroup::MAX_MEMBERS,
+                 (timer.getDiffUsec() * 1000.0) / BENCHMARK_CYCLES, static_cast<F64>(calls) / BENCHMARK_CYCLES);
+
+    // The same members each due once every 200 to 455 cycles
+    Tester sparse;
+    sparse.connectMembers(WheelRateGroup::MAX_MEMBERS);
+    for (U32 i = 0; i < WheelRateGroup::MAX_MEMBERS; i++) {
+        sparse.delays[i] = 200 + i;
+    }
+    timer.start();
+    for (U32 cycle = 0; cycle < BENCHMARK_CYCLES; cycle++) {
+        sparse.cycle();
+    }
+    timer.stop();
+    calls = 0;
+    for (U32 i = 0; i < WheelRateGroup::MAX_MEMBERS; i++) {
+        calls = calls + sparse.calls[i];
+    }
+    (void)printf("[BENCH] %u sparse members: %.1f ns per cycle, %.1f calls per cycle\n", WheelRateGroup::MAX_MEMBERS,
+                 (timer.getDiffUsec() * 1000.0) / BENCHMARK_CYCLES, static_cast<F64>(calls) / BENCHMARK_CYCLES);
+    // Aside from the first cycle, when every member is called, cost follows the few members due
+    ASSERT_LT(calls, 2 * BENCHMARK_CYCLES);
+}
+
+// ----------------------------------------------------------------------
+// Handlers for typed from ports
+// ----------------------------------------------------------------------
+
+void Tester ::from_RateGroupMemberOut_handler(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+    const U32 member = static_cast<U32>(portNum);
+    this->calls[member]++;
+    EXPECT_GT(portNum, this->lastMember);
+    this->lastMember = portNum;
+    this->lastContext = context;
+
+    if (this->checkDue && (this->expected[member] != 0)) {
+        EXPECT_EQ(context, this->expected[member]) << "member " << member;
+    }
+    if (this->delays[member] != 0) {
+        this->expected[member] = (WheelRateGroup::NEVER == this->delays[member]) ? 0 : context + this->delays[member];
+        this->invoke_to_wakeup(portNum, this->delays[member]);
+    }
+    if ((this->slowCycle == context) && (this->slowMember == member)) {
+        Svc::TimerVal start;
+        start.take();
+        Svc::TimerVal now;
+        do {
+            now.take();
+        } while (now.diffUSec(start) < SLOW_MEMBER_USEC);
+    }
+    if (this->slipCycle == context) {
+        // Queued once, by the first member called
+        this->slipCycle = 0;
+        Svc::TimerVal start;
+        start.take();
+        this->invoke_to_CycleIn(0, start);
+    }
+}
+
+void Tester ::from_PingOut_handler(const NATIVE_INT_TYPE portNum, U32 key) {
+    this->pushFromPortEntry_PingOut(key);
+}
+
+// ----------------------------------------------------------------------
+// Helper methods
+// ----------------------------------------------------------------------
+
+void Tester ::connectMembers(U32 count) {
+    for (U32 i = 0; i < count; i++) {
+        this->component.set_RateGroupMemberOut_OutputPort(i, this->get_from_RateGroupMemberOut(i));
+    }
+}
+
+void Tester ::cycle() {
+    this->clearHistory();
+    this->lastMember = -1;
+    Svc::TimerVal start;
+    start.take();
+    this->invoke_to_CycleIn(0, start);
+    this->component.doDispatch();
+}
+
+}  // end namespace Components
@@ -0,0 +1,137 @@
+// ======================================================================
+// \title  WheelRateGroup/test/ut/Tester.hpp
+// \brief  hpp file for WheelRateGroup test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "Components/WheelRateGroup/WheelRateGroup.hpp"
+#include "GTestBase.hpp"
+
+namespace Components {
+
+class Tester : public WheelRateGroupGTestBase {
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+  public:
+    // Maximum size of histories storing events, telemetry, and port outputs
+    static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 10;
+    // Instance ID supplied to the component instance under test
+    static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+    // Queue depth supplied to component instance under test
+    static const NATIVE_INT_TYPE TEST_INSTANCE_QUEUE_DEPTH = 10;
+    // Cycles run by each benchmark mode
+    static const U32 BENCHMARK_CYCLES = 20000;
+    // Microseconds the slow member runs in the slip capture test
+    static const U32 SLOW_MEMBER_USEC = 2000;
+
+    //! Construct object Tester
+    //!
+    Tester();
+
+    //! Destroy object Tester
+    //!
+    ~Tester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    //! Members that never declare a wakeup are called on every cycle, in port order, with the cycle as context
+    //!
+    void testPeriodic();
+
+    //! Members that declare wakeups are called exactly on the cycles they are due, across every wheel level
+    //!
+    void testSparse();
+
+    //! Wakeups requested by others bring a member forward but never postpone it, and NEVER cancels them
+    //!
+    void testEarliestWakeup();
+
+    //! A cycle queued while the previous one runs is reported as a slip
+    //!
+    void testCycleSlip();
+
+    //! A slip freezes the member timings of the last cycles, naming the member that overran
+    //!
+    void testSlipCapture();
+
+    //! Counters attribute cycles and instructions to each member and cycle. Skipped without a hardware PMU.
+    //!
+    void testPerfCounters();
+
+    //! Entries are taken exactly on their due tick, including beyond the last level
+    //!
+    void testTimingWheel();
+
+    //! Benchmark cycles of many members, all periodic and all sparse
+    //!
+    void testMemberScale();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handlers for typed from ports
+    // ----------------------------------------------------------------------
+
+    //! Handler for from_RateGroupMemberOut. Counts the call, checks it is due, and declares the member's next wakeup.
+    //!
+    void from_RateGroupMemberOut_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                                         NATIVE_UINT_TYPE context       /*!< The call order*/
+    );
+
+    //! Handler for from_PingOut
+    //!
+    void from_PingOut_handler(const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                              U32 key                        /*!< Value to return to pinger*/
+    );
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper methods
+    // ----------------------------------------------------------------------
+
+    //! Connect ports
+    //!
+    void connectPorts();
+
+    //! Initialize components
+    //!
+    void initComponents();
+
+    //! Connect the first members of the rate group to this harness
+    //!
+    void connectMembers(U32 count /*!< Number of members*/
+    );
+
+    //! Run one cycle of the rate group
+    //!
+    void cycle();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Variables
+    // ----------------------------------------------------------------------
+
+    //! The component under test
+    //!
+    WheelRateGroup component;
+
+    U32 calls[WheelRateGroup::MAX_MEMBERS];     //! Calls of each member
+    U32 delays[WheelRateGroup::MAX_MEMBERS];    //! Wakeup each member declares when called, 0 to declare none
+    U32 expected[WheelRateGroup::MAX_MEMBERS];  //! Cycle each member is next due, 0 when not checked
+    U32 lastContext;                            //! Context of the last member called
+    I32 lastMember;                             //! Last member called in the current cycle, -1 before any
+    U32 slipCycle;                              //! Cycle on which a member queues another cycle, 0 for none
+    U32 slowCycle;                              //! Cycle on which slowMember runs for SLOW_MEMBER_USEC, 0 for none
+    U32 slowMember;                             //! Member that runs slowly on slowCycle
+    bool checkDue;                              //! Flag: if true members check they are called when due
+};
+
+}  // end namespace Components
+
+#endif
@@ -0,0 +1,58 @@
+// ======================================================================
+// \title  WheelRateGroup/test/ut/TesterHelpers.cpp
+// \author Auto-generated
+// \brief  cpp file for WheelRateGroup component test harness base class
+//
+// NOTE: this file was automatically generated
+//
+// ======================================================================
+#include "Tester.hpp"
+
+namespace Components {
+// ----------------------------------------------------------------------
+// Helper methods
+// ----------------------------------------------------------------------
+
+void Tester ::connectPorts() {
+    // CycleIn
+    this->connect_to_CycleIn(0, this->component.get_CycleIn_InputPort(0));
+
+    // cmdIn
+    this->connect_to_cmdIn(0, this->component.get_cmdIn_InputPort(0));
+
+    // wakeup
+    for (NATIVE_INT_TYPE i = 0; i < 256; ++i) {
+        this->connect_to_wakeup(i, this->component.get_wakeup_InputPort(i));
+    }
+
+    // PingIn
+    this->connect_to_PingIn(0, this->component.get_PingIn_InputPort(0));
+
+    // PingOut
+    this->component.set_PingOut_OutputPort(0, this->get_from_PingOut(0));
+
+    // cmdRegOut
+    this->component.set_cmdRegOut_OutputPort(0, this->get_from_cmdRegOut(0));
+
+    // cmdResponseOut
+    this->component.set_cmdResponseOut_OutputPort(0, this->get_from_cmdResponseOut(0));
+
+    // logOut
+    this->component.set_logOut_OutputPort(0, this->get_from_logOut(0));
+
+    // logTextOut
+    this->component.set_logTextOut_OutputPort(0, this->get_from_logTextOut(0));
+
+    // timeCaller
+    this->component.set_timeCaller_OutputPort(0, this->get_from_timeCaller(0));
+
+    // tlmOut
+    this->component.set_tlmOut_OutputPort(0, this->get_from_tlmOut(0));
+}
+
+void Tester ::initComponents() {
+    this->init();
+    this->component.init(Tester::TEST_INSTANCE_QUEUE_DEPTH, Tester::TEST_INSTANCE_ID);
+}
+
+}  // end namespace Components
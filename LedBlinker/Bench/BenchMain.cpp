@@ -0,0 +1,504 @@
+// ======================================================================
+// \title  BenchMain.cpp
+// \brief  headless benchmark and soak test of the full LedBlinker topology, served by an in-process loopback ground
+//
+// ======================================================================
+// Used to access topology functions and instances
+#include <LedBlinker/Top/LedBlinkerTopology.hpp>
+#include <LedBlinker/Top/LedBlinkerTopologyAc.hpp>
+// Used to serve the comm link and time commands
+#include <LedBlinker/Bench/LoopbackGround.hpp>
+#include <Fw/Cmd/CmdArgBuffer.hpp>
+#include <Fw/Types/OnEnumAc.hpp>
+// Used to sample resources in soak mode
+#include <LedBlinker/Bench/SoakMonitor.hpp>
+#include <Fw/Comp/QueuedComponentBase.hpp>
+#include <Fw/Tlm/TlmBuffer.hpp>
+#include <Os/Task.hpp>
+#include <dirent.h>
+#include <unistd.h>
+// Used for signal handling shutdown
+#include <signal.h>
+// Used for command line argument processing
+#include <getopt.h>
+// Used for CPU time accounting
+#include <sys/resource.h>
+#include <time.h>
+// Used for printf functions
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+//! Milliseconds allowed for the deployment to connect to the ground
+const U32 CONNECT_TIMEOUT = 5000;
+//! Cycles run when none are given
+const U32 DEFAULT_CYCLES = 20000;
+//! Size of the name of a queue metric: "queue." and the instance name
+const U32 QUEUE_METRIC_NAME_SIZE = 64;
+//! Milliseconds between checks of the soak sampler for a sample due or the end of the run
+const U32 SOAK_POLL_INTERVAL = 10;
+//! Virtual seconds of the single virtual cycle a soak runs, longer than any run. It ends on a stopSimulatedCycle call.
+const U32 SOAK_VIRTUAL_SECONDS = 0xFFFFFFFF;
+
+//! Monotonic time in seconds
+double wallSeconds() {
+    struct timespec now;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<double>(now.tv_sec) + (static_cast<double>(now.tv_nsec) / 1e9);
+}
+
+//! User plus system CPU time of the whole process, in seconds
+double cpuSeconds() {
+    struct rusage usage;
+    (void)getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           (static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6);
+}
+
+//! Round trips kept for percentiles
+U32 roundTrips[LedBlinker::LoopbackGround::MAX_ROUND_TRIPS];
+
+//! The ground is large and must outlive the topology's tasks
+LedBlinker::LoopbackGround ground;
+
+//! Samples of a soak run, kept out of the stack for their size
+LedBlinker::SoakMonitor soakMonitor;
+
+//! Options of a soak run
+struct SoakOptions {
+    U32 seconds;          //!< Wall clock seconds to run
+    U32 sampleCycles;     //!< Cycles between samples
+    U32 warmUpCycles;     //!< Cycles before samples are kept for the trend check
+    U32 slackPercent;     //!< Growth allowed in percent of the first value kept
+    const char* csvFile;  //!< File every sample is written to
+};
+
+//! Set by a signal or the end of the soak duration: the virtual cycle is not started again
+volatile sig_atomic_t stopRequested = 0;
+
+//! \class QueueAccess
+//! \brief Reads the message queue of a queued or active component, which the framework only exposes to the component
+class QueueAccess : public Fw::QueuedComponentBase {
+  public:
+    //! \return most messages the queue of the component has held at once
+    static NATIVE_INT_TYPE getHighWater(Fw::QueuedComponentBase& component) {
+        return (component.*(&QueueAccess::m_queue)).getMaxMsgs();
+    }
+};
+
+// The identifiers below are offsets from an instance's base id, as generated for each component. The framework only
+// exposes them to the component, so each is read through a class derived from its component base.
+
+//! \class CommandDispatcherIds
+//! \brief Reads the identifiers of the command dispatcher used to probe the command path
+class CommandDispatcherIds : public Svc::CommandDispatcherComponentBase {
+  public:
+    static const FwOpcodeType NO_OP = OPCODE_CMD_NO_OP;               //!< No-op command
+    static const FwEventIdType NO_OP_RECEIVED = EVENTID_NOOPRECEIVED;  //!< Event reporting the no-op
+};
+
+//! \class LedIds
+//! \brief Reads the identifiers of the led component used to start blinking
+class LedIds : public Components::LedComponentBase {
+  public:
+    static const FwOpcodeType BLINKING_ON_OFF = OPCODE_BLINKING_ON_OFF;  //!< Command turning blinking on or off
+};
+
+//! \class BufferManagerIds
+//! \brief Reads the identifiers of the buffer manager channels sampled
+class BufferManagerIds : public Svc::BufferManagerComponentBase {
+  public:
+    static const FwChanIdType CURR_BUFFS = CHANNELID_CURRBUFFS;  //!< Buffers allocated
+    static const FwChanIdType HI_BUFFS = CHANNELID_HIBUFFS;      //!< Most buffers allocated at once
+};
+
+//! \class RateGroupIds
+//! \brief Reads the identifiers of the rate group channels sampled
+class RateGroupIds : public Components::WheelRateGroupComponentBase {
+  public:
+    static const FwChanIdType MAX_TIME = CHANNELID_RGMAXTIME;  //!< Longest cycle
+};
+
+//! Queued or active instance whose queue high-water mark is sampled
+struct QueueEntry {
+    Fw::QueuedComponentBase& component;
+    const char* name;
+};
+
+}  // namespace
+
+namespace LedBlinker {
+namespace {
+//! Every queued and active instance, generated from instances.fpp by LedBlinker/Top/CMakeLists.txt
+QueueEntry queues[] = {
+#include <LedBlinker/Top/LedBlinkerQueuedAc.hpp>
+};
+}  // namespace
+}  // namespace LedBlinker
+
+namespace {
+
+using LedBlinker::queues;
+
+//! Metric name of each queue, which must outlive the soak monitor
+char queueMetricNames[FW_NUM_ARRAY_ELEMENTS(queues)][QUEUE_METRIC_NAME_SIZE];
+
+//! Telemetry channels sampled, read back from tlmSend
+struct ChannelEntry {
+    Fw::PassiveComponentBase& component;
+    FwChanIdType offset;
+    const char* metric;
+    U64 slackAbsolute;
+} channels[] = {
+    {LedBlinker::fileUplinkBufferManager, BufferManagerIds::CURR_BUFFS, "fileUplinkBufferManager.CurrBuffs", 1},
+    {LedBlinker::fileUplinkBufferManager, BufferManagerIds::HI_BUFFS, "fileUplinkBufferManager.HiBuffs", 1},
+    {LedBlinker::rateGroup1, RateGroupIds::MAX_TIME, "rateGroup1.RgMaxTime_us", 1000},
+    {LedBlinker::rateGroup2, RateGroupIds::MAX_TIME, "rateGroup2.RgMaxTime_us", 1000},
+    {LedBlinker::rateGroup3, RateGroupIds::MAX_TIME, "rateGroup3.RgMaxTime_us", 1000},
+};
+
+//! Least growth allowed of the resident set, in KiB
+const U64 RSS_SLACK = 1024;
+//! Least growth allowed of the open file descriptors, and of each queue high-water mark
+const U64 COUNT_SLACK = 2;
+
+//! \return resident set size of the process in KiB, 0 if unavailable
+U64 residentKib() {
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm == nullptr) {
+        return 0;
+    }
+    const int fields = fscanf(statm, "%llu %llu", &size, &resident);
+    (void)fclose(statm);
+    return (fields == 2) ? ((resident * static_cast<U64>(sysconf(_SC_PAGESIZE))) / 1024) : 0;
+}
+
+//! \return file descriptors open in the process, 0 if unavailable
+U64 openFds() {
+    DIR* fds = opendir("/proc/self/fd");
+    if (fds == nullptr) {
+        return 0;
+    }
+    U64 count = 0;
+    for (struct dirent* entry = readdir(fds); entry != nullptr; entry = readdir(fds)) {
+        count += (entry->d_name[0] != '.') ? 1 : 0;
+    }
+    (void)closedir(fds);
+    // Not counting the descriptor of the listing itself
+    return (count > 0) ? (count - 1) : 0;
+}
+
+//! Read the last value of a U32 telemetry channel from tlmSend
+//!
+//! \return true when the channel has been written
+bool readChannel(FwChanIdType id, U32& value) {
+    Fw::Time timeTag;
+    Fw::TlmBuffer buffer;
+    LedBlinker::tlmSend.get_TlmGet_InputPort(0)->invoke(id, timeTag, buffer);
+    buffer.resetDeser();
+    return (buffer.getBuffLength() > 0) && (Fw::FW_SERIALIZE_OK == buffer.deserialize(value));
+}
+
+//! State of a soak run shared by the cycling thread and the sampler task
+struct SoakRun {
+    const SoakOptions* options;        //!< Options of the run
+    U32 rss;                           //!< Metric index of the resident set size
+    U32 fds;                           //!< Metric index of the open file descriptors
+    U32 queueMetrics[FW_NUM_ARRAY_ELEMENTS(queues)];      //!< Metric index of each queue high-water mark
+    U32 channelMetrics[FW_NUM_ARRAY_ELEMENTS(channels)];  //!< Metric index of each channel
+    double wallStart;                  //!< Wall clock time the run started
+    std::atomic<bool> cycling;         //!< The virtual cycle is running
+    U64 run;                           //!< Cycles completed by rateGroup1 over the run, written by the sampler
+};
+
+//! Record one sample of every metric at the given cycle
+void sampleSoak(SoakRun& soakRun, U64 cycle) {
+    soakMonitor.beginSample(cycle, cycle < soakRun.options->warmUpCycles);
+    soakMonitor.record(soakRun.rss, residentKib());
+    soakMonitor.record(soakRun.fds, openFds());
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(queues); i++) {
+        soakMonitor.record(soakRun.queueMetrics[i], static_cast<U64>(QueueAccess::getHighWater(queues[i].component)));
+    }
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(channels); i++) {
+        U32 value = 0;
+        (void)readChannel(channels[i].component.getIdBase() + channels[i].offset, value);
+        soakMonitor.record(soakRun.channelMetrics[i], value);
+    }
+    if (!soakMonitor.endSample()) {
+        (void)printf("[SOAK] Failed to write a sample to %s\n", soakRun.options->csvFile);
+    }
+}
+
+//! Sampler task of a soak run: samples every sampleCycles completed cycles while the topology cycles, stops the cycle
+//! once the soak duration has elapsed, and takes a last sample when the cycle ends
+void soakSampler(void* arg) {
+    SoakRun& soakRun = *static_cast<SoakRun*>(arg);
+    const U32 sampleCycles = soakRun.options->sampleCycles;
+    U32 last = LedBlinker::systemTime.getCompletedCycles(0);
+    U64 nextSample = sampleCycles;
+    U64 sampled = 0;
+    bool ended = false;
+    while (!ended) {
+        Os::Task::delay(SOAK_POLL_INTERVAL);
+        ended = !soakRun.cycling.load(std::memory_order_acquire);
+        // Counts are accumulated from differences so that a run of more than 2^32 cycles is counted in full
+        const U32 completed = LedBlinker::systemTime.getCompletedCycles(0);
+        soakRun.run += static_cast<U32>(completed - last);
+        last = completed;
+        if ((soakRun.run >= nextSample) || (ended && (soakRun.run > sampled))) {
+            sampleSoak(soakRun, soakRun.run);
+            sampled = soakRun.run;
+            nextSample = (soakRun.run - (soakRun.run % sampleCycles)) + sampleCycles;
+        }
+        if (!stopRequested && ((wallSeconds() - soakRun.wallStart) >= soakRun.options->seconds)) {
+            stopRequested = 1;
+            LedBlinker::stopSimulatedCycle();
+        }
+    }
+}
+
+}  // namespace
+
+/**
+ * \brief print commandline help message
+ *
+ * @param app: name of application
+ */
+void print_usage(const char* app) {
+    (void)printf(
+        "Usage: ./%s [options]\n-c\tcycles to run (default %u)\n-d\tteardown deadline (ms)\n"
+        "-S\tsoak for N wall clock seconds instead of benchmarking\n-i\tsoak: cycles between samples (default 1000)\n"
+        "-w\tsoak: warm-up cycles not checked for trends (default 10000)\n"
+        "-t\tsoak: growth allowed in percent of the first value checked (default 10)\n"
+        "-o\tsoak: file every sample is written to (default soak.csv)\n",
+        app, DEFAULT_CYCLES);
+}
+
+/**
+ * \brief stop the benchmark early on signal
+ *
+ * @param signum
+ */
+static void signalHandler(int signum) {
+    stopRequested = 1;
+    LedBlinker::stopSimulatedCycle();
+}
+
+/**
+ * \brief measure throughput, command latency and CPU use over a number of cycles, then tear down
+ *
+ * @param inputs: state the topology was set up with
+ * @param cycles: cycles to run
+ * @return: 0 on success
+ */
+static int benchmark(const LedBlinker::TopologyState& inputs, U32 cycles) {
+    // One cycle per virtual second, as on the deployment, counted on rateGroup1 in case a signal ends the run early
+    ground.reset();
+    const U32 cyclesStart = LedBlinker::systemTime.getCompletedCycles(0);
+    const double wallStart = wallSeconds();
+    const double cpuStart = cpuSeconds();
+    LedBlinker::startVirtualCycle(1000, cycles);
+    const double wall = wallSeconds() - wallStart;
+    const double cpu = cpuSeconds() - cpuStart;
+    const U32 run = LedBlinker::systemTime.getCompletedCycles(0) - cyclesStart;
+    LedBlinker::LoopbackGround::Counts counts;
+    ground.snapshot(counts);
+    const U32 samples = ground.getRoundTrips(roundTrips, LedBlinker::LoopbackGround::MAX_ROUND_TRIPS);
+
+    LedBlinker::teardownTopology(inputs);
+    ground.stop();
+
+    (void)printf("[BENCH] cycles %u in %.3f s: %.0f cycles/s\n", run, wall, run / wall);
+    (void)printf("[BENCH] telemetry packets %llu: %.0f packets/s\n",
+                 static_cast<unsigned long long>(counts.telemetryPackets), counts.telemetryPackets / wall);
+    (void)printf("[BENCH] event packets %llu: %.0f packets/s\n", static_cast<unsigned long long>(counts.eventPackets),
+                 counts.eventPackets / wall);
+    if (samples > 0) {
+        (void)printf("[BENCH] command round trip (us) over %u: min %u p50 %u p99 %u max %u\n", counts.roundTrips,
+                     roundTrips[0], roundTrips[samples / 2], roundTrips[(samples * 99) / 100], roundTrips[samples - 1]);
+    } else {
+        (void)printf("[BENCH] command round trip: no reply received\n");
+    }
+    (void)printf("[BENCH] cpu %.3f s: %.1f us/cycle\n", cpu, (run > 0) ? ((cpu * 1e6) / run) : 0.0);
+    (void)printf("[BENCH] probe timeouts %u, bad frame bytes %llu, other packets %llu\n", counts.probeTimeouts,
+                 static_cast<unsigned long long>(counts.badFrames),
+                 static_cast<unsigned long long>(counts.otherPackets));
+    return 0;
+}
+
+/**
+ * \brief sample resources until the soak duration elapses, then tear down and check each for an upward trend
+ *
+ * The topology runs one virtual cycle for the whole soak, so rate group completions, virtual time and the divisor
+ * phase run on unbroken. A sampler task samples every metric every `sampleCycles` cycles meanwhile, and stops the cycle
+ * once the duration has elapsed. A signal ends the run early and the samples taken so far are checked.
+ *
+ * @param inputs: state the topology was set up with
+ * @param options: options of the soak run
+ * @return: 0 when no metric trended upward beyond its slack, 1 otherwise
+ */
+static int soak(const LedBlinker::TopologyState& inputs, const SoakOptions& options) {
+    SoakRun soakRun;
+    soakRun.options = &options;
+    soakRun.rss = soakMonitor.addMetric("rss_kib", options.slackPercent, RSS_SLACK);
+    soakRun.fds = soakMonitor.addMetric("fds", options.slackPercent, COUNT_SLACK);
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(queues); i++) {
+        (void)snprintf(queueMetricNames[i], sizeof(queueMetricNames[i]), "queue.%s", queues[i].name);
+        soakRun.queueMetrics[i] = soakMonitor.addMetric(queueMetricNames[i], options.slackPercent, COUNT_SLACK);
+    }
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(channels); i++) {
+        soakRun.channelMetrics[i] =
+            soakMonitor.addMetric(channels[i].metric, options.slackPercent, channels[i].slackAbsolute);
+    }
+    if (!soakMonitor.open(options.csvFile)) {
+        (void)printf("[SOAK] Failed to open %s\n", options.csvFile);
+        LedBlinker::teardownTopology(inputs);
+        ground.stop();
+        return 1;
+    }
+
+    // Keep the probe command flowing for the whole run, so the command path is soaked as well
+    ground.reset();
+    soakRun.wallStart = wallSeconds();
+    soakRun.run = 0;
+    soakRun.cycling.store(true, std::memory_order_release);
+    Os::Task sampler;
+    Os::TaskString name("SoakSampler");
+    if (Os::Task::TASK_OK != sampler.start(name, soakSampler, &soakRun)) {
+        (void)printf("[SOAK] Failed to start the sampler task\n");
+        soakMonitor.close();
+        LedBlinker::teardownTopology(inputs);
+        ground.stop();
+        return 1;
+    }
+    // A run outlasting the virtual seconds of one call, over 4 billion cycles, continues with another
+    while (!stopRequested) {
+        LedBlinker::startVirtualCycle(1000, SOAK_VIRTUAL_SECONDS);
+    }
+    soakRun.cycling.store(false, std::memory_order_release);
+    (void)sampler.join(nullptr);
+    const U64 run = soakRun.run;
+    const double wall = wallSeconds() - soakRun.wallStart;
+    soakMonitor.close();
+
+    LedBlinker::teardownTopology(inputs);
+    ground.stop();
+
+    (void)printf("[SOAK] cycles %llu in %.0f s: %.0f cycles/s, %u samples checked\n",
+                 static_cast<unsigned long long>(run), wall, run / wall, soakMonitor.getKeptCount());
+    bool passed = true;
+    for (U32 i = 0; i < soakMonitor.getMetricCount(); i++) {
+        LedBlinker::SoakMonitor::Trend trend;
+        const bool metricPassed = soakMonitor.getTrend(i, trend);
+        (void)printf("[SOAK] %s %s: %llu -> %llu, trend %+.1f, allowed %.1f\n", metricPassed ? "PASS" : "FAIL",
+                     trend.name, static_cast<unsigned long long>(trend.first),
+                     static_cast<unsigned long long>(trend.last), trend.growth, trend.slack);
+        passed = passed && metricPassed;
+    }
+    (void)printf("[SOAK] %s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
+
+/**
+ * \brief run the benchmark
+ *
+ * Brings up the deployment's topology with its `comm` link connected to an in-process ground on the loopback
+ * interface and GPIO simulated, turns blinking on, then drives the rate group driver in virtual time as fast as the
+ * rate groups complete their cycles. Throughput, command latency and CPU use over the run are printed on "[BENCH]"
+ * lines. Given -S, the topology is soaked for that many seconds instead and its resources checked for growth.
+ *
+ * @param argc: argument count supplied to program
+ * @param argv: argument values supplied to program
+ * @return: 0 on success, something else on failure
+ */
+int main(int argc, char* argv[]) {
+    U32 cycles = DEFAULT_CYCLES;
+    U32 teardown_deadline = 0;
+    I32 option = 0;
+    SoakOptions soakOptions = {0, 1000, 10000, 10, "soak.csv"};
+
+    // Loop while reading the getopt supplied options
+    while ((option = getopt(argc, argv, "hc:d:S:i:w:t:o:")) != -1) {
+        switch (option) {
+            // Handle the -c cycles argument
+            case 'c':
+                cycles = static_cast<U32>(atoi(optarg));
+                break;
+            // Handle the -d teardown deadline argument
+            case 'd':
+                teardown_deadline = static_cast<U32>(atoi(optarg));
+                break;
+            // Handle the -S soak seconds argument
+            case 'S':
+                soakOptions.seconds = static_cast<U32>(atoi(optarg));
+                break;
+            // Handle the -i soak sample interval argument
+            case 'i':
+                soakOptions.sampleCycles = static_cast<U32>(atoi(optarg));
+                break;
+            // Handle the -w soak warm-up argument
+            case 'w':
+                soakOptions.warmUpCycles = static_cast<U32>(atoi(optarg));
+                break;
+            // Handle the -t soak slack argument
+            case 't':
+                soakOptions.slackPercent = static_cast<U32>(atoi(optarg));
+                break;
+            // Handle the -o soak sample file argument
+            case 'o':
+                soakOptions.csvFile = optarg;
+                break;
+            // Cascade intended: help output
+            case 'h':
+            // Cascade intended: help output
+            case '?':
+            // Default case: output help and exit
+            default:
+                print_usage(argv[0]);
+                return (option == 'h') ? 0 : 1;
+        }
+    }
+    if (soakOptions.sampleCycles == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (!ground.listen()) {
+        (void)printf("[BENCH] Failed to listen on the loopback interface\n");
+        return 1;
+    }
+
+    // Object for communicating state to the reference topology
+    LedBlinker::TopologyState inputs;
+    inputs.hostname = "127.0.0.1";
+    inputs.port = ground.getPort();
+    inputs.teardownDeadline = teardown_deadline;
+    inputs.recordFile = nullptr;
+    inputs.simulateGpio = true;
+
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+
+    LedBlinker::setupTopology(inputs);
+    const U32 probeOpcode = LedBlinker::cmdDisp.getIdBase() + CommandDispatcherIds::NO_OP;
+    const U32 probeEvent = LedBlinker::cmdDisp.getIdBase() + CommandDispatcherIds::NO_OP_RECEIVED;
+    bool ready = (Os::Task::TASK_OK == ground.start(probeOpcode, probeEvent)) && ground.waitConnected(CONNECT_TIMEOUT);
+    if (ready) {
+        // Blink, so that the led component and the GPIO path carry their load
+        Fw::CmdArgBuffer args;
+        ready = (Fw::FW_SERIALIZE_OK == args.serialize(Fw::On(Fw::On::ON))) &&
+                ground.sendCommand(LedBlinker::led.getIdBase() + LedIds::BLINKING_ON_OFF, args.getBuffAddr(),
+                                   static_cast<U32>(args.getBuffLength()));
+    }
+    if (!ready) {
+        (void)printf("[BENCH] Deployment did not connect to the loopback ground\n");
+        LedBlinker::teardownTopology(inputs);
+        ground.stop();
+        return 1;
+    }
+
+    return (soakOptions.seconds > 0) ? soak(inputs, soakOptions) : benchmark(inputs, cycles);
+}
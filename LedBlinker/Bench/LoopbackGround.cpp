@@ -0,0 +1,345 @@
+// ======================================================================
+// \title  LoopbackGround.cpp
+// \brief  cpp file for an in-process ground stand-in serving the deployment's TCP client on the loopback interface
+// ======================================================================
+
+#include <LedBlinker/Bench/LoopbackGround.hpp>
+#include <Fw/Com/ComBuffer.hpp>
+#include <Fw/Com/ComPacket.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/Serializable.hpp>
+#include <Svc/FramingProtocol/FprimeProtocol.hpp>
+#include <Utils/Hash/Hash.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace LedBlinker {
+
+namespace {
+
+//! Bytes of a frame other than its data: start word, size and CRC
+const U32 FRAME_OVERHEAD = Svc::FpFrameHeader::SIZE + HASH_DIGEST_LENGTH;
+//! Milliseconds the task waits on the socket before checking whether to quit
+const int POLL_INTERVAL = 10;
+
+//! Monotonic time in nanoseconds
+U64 monotonicNs() {
+    struct timespec now;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (static_cast<U64>(now.tv_sec) * 1000000000) + static_cast<U64>(now.tv_nsec);
+}
+
+//! Read a big endian U32, as serialized by the framing protocol
+U32 readU32(const U8* bytes) {
+    return (static_cast<U32>(bytes[0]) << 24) | (static_cast<U32>(bytes[1]) << 16) |
+           (static_cast<U32>(bytes[2]) << 8) | static_cast<U32>(bytes[3]);
+}
+
+}  // namespace
+
+LoopbackGround::LoopbackGround()
+    : serving(false),
+      listenFd(-1),
+      connectionFd(-1),
+      port(0),
+      quit(false),
+      probing(false),
+      sendLock("LoopbackGround.sendLock"),
+      probeOpcode(0),
+      probeEventId(0),
+      probeSent(0),
+      received(0),
+      telemetryPackets(0),
+      eventPackets(0),
+      otherPackets(0),
+      badFrames(0),
+      probeTimeouts(0),
+      roundTripCount(0) {
+    for (U32 i = 0; i < MAX_ROUND_TRIPS; i++) {
+        this->roundTrips[i] = 0;
+    }
+}
+
+LoopbackGround::~LoopbackGround() {
+    this->stop();
+}
+
+bool LoopbackGround::listen() {
+    FW_ASSERT(this->listenFd < 0);
+    this->listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (this->listenFd < 0) {
+        return false;
+    }
+    const int enable = 1;
+    (void)setsockopt(this->listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    if ((bind(this->listenFd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) ||
+        (::listen(this->listenFd, 1) != 0) ||
+        (getsockname(this->listenFd, reinterpret_cast<struct sockaddr*>(&address), &length) != 0)) {
+        (void)close(this->listenFd);
+        this->listenFd = -1;
+        return false;
+    }
+    this->port = ntohs(address.sin_port);
+    return true;
+}
+
+U16 LoopbackGround::getPort() const {
+    return this->port;
+}
+
+Os::Task::TaskStatus LoopbackGround::start(U32 probeOpcode, U32 probeEventId) {
+    FW_ASSERT(this->listenFd >= 0);
+    FW_ASSERT(!this->serving);
+    this->probeOpcode = probeOpcode;
+    this->probeEventId = probeEventId;
+    this->quit = false;
+    Os::TaskString name("LoopbackGnd");
+    const Os::Task::TaskStatus status = this->task.start(name, LoopbackGround::serveTask, this);
+    this->serving = (Os::Task::TASK_OK == status);
+    return status;
+}
+
+void LoopbackGround::stop() {
+    this->quit = true;
+    if (this->serving) {
+        (void)this->task.join(nullptr);
+        this->serving = false;
+    }
+    const int connection = this->connectionFd.exchange(-1);
+    if (connection >= 0) {
+        (void)close(connection);
+    }
+    if (this->listenFd >= 0) {
+        (void)close(this->listenFd);
+        this->listenFd = -1;
+    }
+}
+
+bool LoopbackGround::waitConnected(U32 milliseconds) {
+    for (U32 waited = 0; (this->connectionFd < 0) && (waited < milliseconds); waited += POLL_INTERVAL) {
+        Os::Task::delay(POLL_INTERVAL);
+    }
+    return this->connectionFd >= 0;
+}
+
+bool LoopbackGround::sendCommand(U32 opcode, const U8* args, U32 argsSize) {
+    Fw::ComBuffer packet;
+    Fw::SerializeStatus status =
+        packet.serialize(static_cast<FwPacketDescriptorType>(Fw::ComPacket::FW_PACKET_COMMAND));
+    status = (Fw::FW_SERIALIZE_OK == status) ? packet.serialize(static_cast<FwOpcodeType>(opcode)) : status;
+    if ((Fw::FW_SERIALIZE_OK == status) && (argsSize > 0)) {
+        status = packet.serialize(args, argsSize, true);
+    }
+    if (Fw::FW_SERIALIZE_OK != status) {
+        return false;
+    }
+
+    U8 frame[MAX_FRAME];
+    const U32 size = static_cast<U32>(packet.getBuffLength());
+    FW_ASSERT(size + FRAME_OVERHEAD <= sizeof(frame), size);
+    Fw::ExternalSerializeBuffer framer(frame, sizeof(frame));
+    status = framer.serialize(static_cast<Svc::FpFrameHeader::TokenType>(Svc::FpFrameHeader::START_WORD));
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+    status = framer.serialize(static_cast<Svc::FpFrameHeader::TokenType>(size));
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+    status = framer.serialize(packet.getBuffAddr(), size, true);
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+    Utils::HashBuffer hash;
+    Utils::Hash::hash(frame, static_cast<NATIVE_INT_TYPE>(framer.getBuffLength()), hash);
+    status = framer.serialize(hash.asBigEndianU32());
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+
+    this->sendLock.lock();
+    const bool sent = this->sendAll(frame, static_cast<U32>(framer.getBuffLength()));
+    this->sendLock.unLock();
+    return sent;
+}
+
+void LoopbackGround::reset() {
+    this->telemetryPackets = 0;
+    this->eventPackets = 0;
+    this->otherPackets = 0;
+    this->badFrames = 0;
+    this->probeTimeouts = 0;
+    this->roundTripCount = 0;
+    this->probing = true;
+}
+
+void LoopbackGround::snapshot(Counts& counts) {
+    counts.telemetryPackets = this->telemetryPackets;
+    counts.eventPackets = this->eventPackets;
+    counts.otherPackets = this->otherPackets;
+    counts.badFrames = this->badFrames;
+    counts.roundTrips = this->roundTripCount;
+    counts.probeTimeouts = this->probeTimeouts;
+}
+
+U32 LoopbackGround::getRoundTrips(U32* roundTrips, U32 maxCount) {
+    FW_ASSERT(roundTrips != nullptr);
+    U32 count = this->roundTripCount;
+    count = (count < MAX_ROUND_TRIPS) ? count : MAX_ROUND_TRIPS;
+    count = (count < maxCount) ? count : maxCount;
+    for (U32 i = 0; i < count; i++) {
+        roundTrips[i] = this->roundTrips[i];
+    }
+    std::sort(roundTrips, roundTrips + count);
+    return count;
+}
+
+void LoopbackGround::serveTask(void* ground) {
+    FW_ASSERT(ground != nullptr);
+    static_cast<LoopbackGround*>(ground)->serve();
+}
+
+void LoopbackGround::serve() {
+    // Accept the deployment's connection, checking regularly whether to quit
+    struct pollfd listening = {this->listenFd, POLLIN, 0};
+    while (!this->quit && (this->connectionFd < 0)) {
+        if (poll(&listening, 1, POLL_INTERVAL) > 0) {
+            const int connection = accept(this->listenFd, nullptr, nullptr);
+            if (connection >= 0) {
+                // Frames are small and latency is measured, so send them without coalescing
+                const int enable = 1;
+                (void)setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+                this->connectionFd = connection;
+            }
+        }
+    }
+
+    struct pollfd connected = {this->connectionFd, POLLIN, 0};
+    while (!this->quit) {
+        if (this->probing) {
+            const U64 now = monotonicNs();
+            if (this->probeSent == 0) {
+                this->sendProbe();
+            } else if ((now - this->probeSent) > (static_cast<U64>(PROBE_TIMEOUT) * 1000000)) {
+                this->probeTimeouts++;
+                this->sendProbe();
+            }
+        }
+        const int ready = poll(&connected, 1, POLL_INTERVAL);
+        if ((ready < 0) && (errno != EINTR)) {
+            break;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        const ssize_t count = recv(connected.fd, this->receiveBuffer + this->received,
+                                   sizeof(this->receiveBuffer) - this->received, 0);
+        if (count == 0) {
+            break;  // The deployment closed the connection
+        }
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        this->received += static_cast<U32>(count);
+        this->parseFrames();
+    }
+}
+
+void LoopbackGround::parseFrames() {
+    U32 offset = 0;
+    while ((this->received - offset) >= FRAME_OVERHEAD) {
+        const U8* frame = this->receiveBuffer + offset;
+        const U32 available = this->received - offset;
+        const U32 size = readU32(frame + sizeof(Svc::FpFrameHeader::TokenType));
+        if ((readU32(frame) != Svc::FpFrameHeader::START_WORD) || (size > (MAX_FRAME - FRAME_OVERHEAD))) {
+            this->badFrames++;
+            offset++;
+            continue;
+        }
+        if (available < (size + FRAME_OVERHEAD)) {
+            break;  // Wait for the rest of the frame
+        }
+        Utils::HashBuffer hash;
+        Utils::Hash::hash(frame, static_cast<NATIVE_INT_TYPE>(Svc::FpFrameHeader::SIZE + size), hash);
+        if (hash.asBigEndianU32() != readU32(frame + Svc::FpFrameHeader::SIZE + size)) {
+            this->badFrames++;
+            offset++;
+            continue;
+        }
+        this->receivePacket(frame + Svc::FpFrameHeader::SIZE, size);
+        offset += size + FRAME_OVERHEAD;
+    }
+    // Keep the partial frame, if any, at the start of the buffer
+    this->received -= offset;
+    if ((offset > 0) && (this->received > 0)) {
+        memmove(this->receiveBuffer, this->receiveBuffer + offset, this->received);
+    }
+}
+
+void LoopbackGround::receivePacket(const U8* data, U32 size) {
+    Fw::ExternalSerializeBuffer packet(const_cast<U8*>(data), size);
+    Fw::SerializeStatus status = packet.setBuffLen(size);
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+    FwPacketDescriptorType descriptor = 0;
+    if (Fw::FW_SERIALIZE_OK != packet.deserialize(descriptor)) {
+        this->otherPackets++;
+        return;
+    }
+    switch (descriptor) {
+        case Fw::ComPacket::FW_PACKET_TELEM:
+            this->telemetryPackets++;
+            break;
+        case Fw::ComPacket::FW_PACKET_LOG: {
+            this->eventPackets++;
+            FwEventIdType id = 0;
+            status = packet.deserialize(id);
+            if ((Fw::FW_SERIALIZE_OK == status) && (id == this->probeEventId) && (this->probeSent != 0)) {
+                const U64 roundTrip = (monotonicNs() - this->probeSent) / 1000;
+                const U32 index = this->roundTripCount++;
+                if (index < MAX_ROUND_TRIPS) {
+                    this->roundTrips[index] = static_cast<U32>(std::min(roundTrip, static_cast<U64>(0xFFFFFFFF)));
+                }
+                this->probeSent = 0;
+                this->sendProbe();
+            }
+            break;
+        }
+        default:
+            this->otherPackets++;
+            break;
+    }
+}
+
+void LoopbackGround::sendProbe() {
+    this->probeSent = monotonicNs();
+    (void)this->sendCommand(this->probeOpcode, nullptr, 0);
+}
+
+bool LoopbackGround::sendAll(const U8* data, U32 size) {
+    const int connection = this->connectionFd;
+    U32 sent = 0;
+    while ((connection >= 0) && (sent < size)) {
+        // The deployment may close the connection first during teardown, which must not raise SIGPIPE
+        const ssize_t count = send(connection, data + sent, size - sent, MSG_NOSIGNAL);
+        if ((count < 0) && (errno == EINTR)) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        sent += static_cast<U32>(count);
+    }
+    return (connection >= 0) && (sent == size);
+}
+
+}  // namespace LedBlinker
@@ -0,0 +1,135 @@
+// ======================================================================
+// \title  LoopbackGround.hpp
+// \brief  hpp file for an in-process ground stand-in serving the deployment's TCP client on the loopback interface
+// ======================================================================
+
+#ifndef LedBlinker_LoopbackGround_HPP
+#define LedBlinker_LoopbackGround_HPP
+
+#include <FpConfig.hpp>
+#include <Os/Task.hpp>
+#include <Utils/MutexProfile/MutexProfile.hpp>
+
+#include <atomic>
+
+namespace LedBlinker {
+
+//! \class LoopbackGround
+//! \brief Accepts the connection of the `comm` TCP client, counts the packets it downlinks and times commands
+//!
+//! Downlinked frames are parsed with the F´ framing protocol and counted by packet type. Commands are framed the same
+//! way. A probe command is kept in flight: each time the event it produces is downlinked, the round trip is recorded
+//! and the next probe is sent, so command latency is sampled continuously under the load of the running topology.
+//! Probing starts with the first reset. The events of the probes are counted with the other event packets.
+class LoopbackGround {
+  public:
+    //! Round trips retained for percentiles
+    static const U32 MAX_ROUND_TRIPS = 8192;
+    //! Largest frame accepted, in bytes
+    static const U32 MAX_FRAME = 4096;
+    //! Milliseconds after which an unanswered probe is sent again
+    static const U32 PROBE_TIMEOUT = 1000;
+
+    //! Counts taken by snapshot
+    struct Counts {
+        U64 telemetryPackets;  //!< Telemetry packets received
+        U64 eventPackets;      //!< Event packets received
+        U64 otherPackets;      //!< Packets of any other type received
+        U64 badFrames;         //!< Bytes skipped to find the start of a frame
+        U32 roundTrips;        //!< Probe round trips recorded
+        U32 probeTimeouts;     //!< Probes sent again after PROBE_TIMEOUT
+    };
+
+    LoopbackGround();
+
+    ~LoopbackGround();
+
+    //! Listen on an ephemeral port of the loopback interface
+    //!
+    //! \return true when listening
+    bool listen();
+
+    //! \return port listened on
+    U16 getPort() const;
+
+    //! Start the task accepting the connection and serving it
+    //!
+    //! \return status of starting the task
+    Os::Task::TaskStatus start(U32 probeOpcode,  /*!< Opcode of the probe command, taking no arguments*/
+                               U32 probeEventId  /*!< Id of the event the probe command produces*/
+    );
+
+    //! Stop the task, once the deployment has closed its side of the connection or on its own
+    void stop();
+
+    //! Wait for the deployment to connect
+    //!
+    //! \return true when connected within the timeout
+    bool waitConnected(U32 milliseconds /*!< Longest wait*/
+    );
+
+    //! Send a command
+    //!
+    //! \return true when the whole frame was sent
+    bool sendCommand(U32 opcode,         /*!< Opcode of the command*/
+                     const U8* args,     /*!< Serialized arguments*/
+                     U32 argsSize        /*!< Size of the arguments*/
+    );
+
+    //! Restart counting, dropping the round trips recorded so far. The first call also starts probing.
+    void reset();
+
+    //! Read the counts since the last reset
+    void snapshot(Counts& counts);
+
+    //! Copy the round trips recorded since the last reset, in microseconds, sorted ascending
+    //!
+    //! \return number of round trips copied
+    U32 getRoundTrips(U32* roundTrips, /*!< Out: round trips, of MAX_ROUND_TRIPS entries*/
+                      U32 maxCount     /*!< Entries available in roundTrips*/
+    );
+
+  PRIVATE:
+    //! Task entry point
+    static void serveTask(void* ground);
+
+    //! Accept the connection and parse frames until stopped or disconnected
+    void serve();
+
+    //! Parse the frames complete in the receive buffer, keeping any partial frame
+    void parseFrames();
+
+    //! Count a downlinked packet, completing the probe in flight if it is the probe event
+    void receivePacket(const U8* data, U32 size);
+
+    //! Send the probe command, timing its round trip from now
+    void sendProbe();
+
+    //! Send the whole of a buffer over the connection
+    bool sendAll(const U8* data, U32 size);
+
+    Os::Task task;                      //!< Task serving the connection
+    bool serving;                       //!< The task was started and not yet joined
+    int listenFd;                       //!< Listening socket
+    std::atomic<int> connectionFd;      //!< Accepted connection, -1 before connecting
+    U16 port;                           //!< Port listened on
+    std::atomic<bool> quit;             //!< Set to stop the task
+    std::atomic<bool> probing;          //!< Set by the first reset to start probing
+    Utils::NamedMutex sendLock;         //!< Serializes frames sent by the task and by sendCommand
+    U32 probeOpcode;                    //!< Opcode of the probe command
+    U32 probeEventId;                   //!< Id of the event completing a probe
+    U64 probeSent;                      //!< Monotonic time the probe in flight was sent in nanoseconds, 0 if none
+    U8 receiveBuffer[2 * MAX_FRAME];    //!< Bytes received and not yet parsed
+    U32 received;                       //!< Bytes in receiveBuffer
+    std::atomic<U64> telemetryPackets;  //!< Telemetry packets received
+    std::atomic<U64> eventPackets;      //!< Event packets received
+    std::atomic<U64> otherPackets;      //!< Other packets received
+    std::atomic<U64> badFrames;         //!< Bytes skipped while resynchronizing
+    std::atomic<U32> probeTimeouts;     //!< Probes sent again
+    std::atomic<U32> roundTripCount;    //!< Round trips recorded, possibly more than retained
+    std::atomic<U32> roundTrips[MAX_ROUND_TRIPS];  //!< Round trips in microseconds
+};
+
+}  // namespace LedBlinker
+
+#endif
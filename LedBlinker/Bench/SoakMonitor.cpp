@@ -0,0 +1,152 @@
+// ======================================================================
+// \title  SoakMonitor.cpp
+// \brief  cpp file for resource samples taken over a soak run, and the upward trend check applied to them
+// ======================================================================
+
+#include <LedBlinker/Bench/SoakMonitor.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <cstdio>
+
+namespace LedBlinker {
+
+namespace {
+//! Longest CSV row, the header included
+const U32 MAX_ROW = 2048;
+}  // namespace
+
+SoakMonitor::SoakMonitor()
+    : fileOpen(false), metricCount(0), cycle(0), warmUp(true), stride(1), skipped(0), kept(0) {}
+
+U32 SoakMonitor::addMetric(const char* name, U32 slackPercent, U64 slackAbsolute) {
+    FW_ASSERT(name != nullptr);
+    FW_ASSERT(this->metricCount < MAX_METRICS, this->metricCount);
+    FW_ASSERT(!this->fileOpen && (this->kept == 0));
+    Metric& metric = this->metrics[this->metricCount];
+    metric.name = name;
+    metric.slackPercent = slackPercent;
+    metric.slackAbsolute = slackAbsolute;
+    return this->metricCount++;
+}
+
+bool SoakMonitor::open(const char* fileName) {
+    FW_ASSERT(fileName != nullptr);
+    FW_ASSERT(!this->fileOpen);
+    if (Os::File::OP_OK != this->file.open(fileName, Os::File::OPEN_WRITE)) {
+        return false;
+    }
+    this->fileOpen = true;
+    char row[MAX_ROW];
+    NATIVE_INT_TYPE length = snprintf(row, sizeof(row), "cycle");
+    for (U32 i = 0; i < this->metricCount; i++) {
+        length += snprintf(row + length, sizeof(row) - length, ",%s", this->metrics[i].name);
+        FW_ASSERT(static_cast<U32>(length) < (sizeof(row) - 1), length);
+    }
+    row[length++] = '\n';
+    return (Os::File::OP_OK == this->file.write(row, length));
+}
+
+void SoakMonitor::beginSample(U64 cycle, bool warmUp) {
+    this->cycle = cycle;
+    this->warmUp = warmUp;
+    for (U32 i = 0; i < this->metricCount; i++) {
+        this->current[i] = 0;
+    }
+}
+
+void SoakMonitor::record(U32 metric, U64 value) {
+    FW_ASSERT(metric < this->metricCount, metric);
+    this->current[metric] = value;
+}
+
+bool SoakMonitor::endSample() {
+    if (!this->warmUp && (++this->skipped >= this->stride)) {
+        this->skipped = 0;
+        if (this->kept == MAX_SAMPLES) {
+            this->decimate();
+        }
+        this->keptCycles[this->kept] = this->cycle;
+        for (U32 i = 0; i < this->metricCount; i++) {
+            this->keptValues[this->kept][i] = this->current[i];
+        }
+        this->kept++;
+    }
+
+    if (!this->fileOpen) {
+        return false;
+    }
+    char row[MAX_ROW];
+    NATIVE_INT_TYPE length = snprintf(row, sizeof(row), "%llu", static_cast<unsigned long long>(this->cycle));
+    for (U32 i = 0; i < this->metricCount; i++) {
+        length += snprintf(row + length, sizeof(row) - length, ",%llu",
+                           static_cast<unsigned long long>(this->current[i]));
+        FW_ASSERT(static_cast<U32>(length) < (sizeof(row) - 1), length);
+    }
+    row[length++] = '\n';
+    return (Os::File::OP_OK == this->file.write(row, length));
+}
+
+void SoakMonitor::close() {
+    if (this->fileOpen) {
+        this->file.close();
+        this->fileOpen = false;
+    }
+}
+
+U32 SoakMonitor::getMetricCount() const {
+    return this->metricCount;
+}
+
+U32 SoakMonitor::getKeptCount() const {
+    return this->kept;
+}
+
+bool SoakMonitor::getTrend(U32 metric, Trend& trend) const {
+    FW_ASSERT(metric < this->metricCount, metric);
+    const Metric& entry = this->metrics[metric];
+    trend.name = entry.name;
+    trend.first = (this->kept > 0) ? this->keptValues[0][metric] : 0;
+    trend.last = (this->kept > 0) ? this->keptValues[this->kept - 1][metric] : 0;
+    trend.growth = 0.0;
+    const F64 percent = (static_cast<F64>(trend.first) * entry.slackPercent) / 100.0;
+    trend.slack = (percent > static_cast<F64>(entry.slackAbsolute)) ? percent : static_cast<F64>(entry.slackAbsolute);
+
+    if (this->kept >= 2) {
+        F64 meanCycle = 0.0;
+        F64 meanValue = 0.0;
+        for (U32 i = 0; i < this->kept; i++) {
+            meanCycle += static_cast<F64>(this->keptCycles[i]);
+            meanValue += static_cast<F64>(this->keptValues[i][metric]);
+        }
+        meanCycle /= this->kept;
+        meanValue /= this->kept;
+        F64 covariance = 0.0;
+        F64 variance = 0.0;
+        for (U32 i = 0; i < this->kept; i++) {
+            const F64 dx = static_cast<F64>(this->keptCycles[i]) - meanCycle;
+            covariance += dx * (static_cast<F64>(this->keptValues[i][metric]) - meanValue);
+            variance += dx * dx;
+        }
+        if (variance > 0.0) {
+            const F64 span = static_cast<F64>(this->keptCycles[this->kept - 1] - this->keptCycles[0]);
+            trend.growth = (covariance / variance) * span;
+        }
+    }
+    trend.failed = trend.growth > trend.slack;
+    return !trend.failed;
+}
+
+void SoakMonitor::decimate() {
+    U32 count = 0;
+    for (U32 i = 0; i < this->kept; i += 2) {
+        this->keptCycles[count] = this->keptCycles[i];
+        for (U32 j = 0; j < this->metricCount; j++) {
+            this->keptValues[count][j] = this->keptValues[i][j];
+        }
+        count++;
+    }
+    this->kept = count;
+    this->stride *= 2;
+}
+
+}  // namespace LedBlinker
@@ -0,0 +1,114 @@
+// ======================================================================
+// \title  SoakMonitor.hpp
+// \brief  hpp file for resource samples taken over a soak run, and the upward trend check applied to them
+// ======================================================================
+
+#ifndef LedBlinker_SoakMonitor_HPP
+#define LedBlinker_SoakMonitor_HPP
+
+#include <FpConfig.hpp>
+#include <Os/File.hpp>
+
+namespace LedBlinker {
+
+//! \class SoakMonitor
+//! \brief Records samples of named metrics over a soak run and fails those whose values trend upward
+//!
+//! Every sample is appended to a CSV file as it is taken, so a run of any length can be examined afterwards. Samples
+//! taken once the warm-up is over are also kept for the trend check, in a fixed table: when it fills, every other
+//! sample is dropped and only every other later sample is kept, so a run of weeks is covered evenly at a coarser step.
+//!
+//! The trend of a metric is the growth of its least squares line over the samples kept. A metric fails when that growth
+//! exceeds its slack: a percentage of its first kept value, but no less than an absolute amount. Fitting a line rather
+//! than comparing the first and last samples keeps a noisy metric such as RSS from failing on a single high sample.
+class SoakMonitor {
+  public:
+    //! Metrics that may be recorded
+    static const U32 MAX_METRICS = 32;
+    //! Samples kept per metric for the trend check
+    static const U32 MAX_SAMPLES = 4096;
+
+    //! Trend of one metric over the samples kept
+    struct Trend {
+        const char* name;  //!< Name of the metric
+        U64 first;         //!< First value kept
+        U64 last;          //!< Last value kept
+        F64 growth;        //!< Growth of the least squares line over the samples kept
+        F64 slack;         //!< Growth allowed
+        bool failed;       //!< Growth exceeded the slack
+    };
+
+    SoakMonitor();
+
+    //! Add a metric. Metrics must all be added before the first sample.
+    //!
+    //! \return index of the metric, passed to record
+    U32 addMetric(const char* name,    /*!< Column name. Must outlive the monitor, e.g. a string literal.*/
+                  U32 slackPercent,    /*!< Growth allowed, in percent of the first value kept*/
+                  U64 slackAbsolute    /*!< Least growth allowed*/
+    );
+
+    //! Open the CSV file the samples are written to, writing its header
+    //!
+    //! \return true when the file was opened and the header written
+    bool open(const char* fileName /*!< Path of the file written*/
+    );
+
+    //! Start a sample, to be followed by a record call for every metric, then endSample
+    void beginSample(U64 cycle,   /*!< Rate group cycles run so far*/
+                     bool warmUp  /*!< The sample falls within the warm-up and is not kept for the trend check*/
+    );
+
+    //! Record the value of a metric in the current sample
+    void record(U32 metric, /*!< Index returned by addMetric*/
+                U64 value   /*!< Value sampled*/
+    );
+
+    //! Write the current sample to the CSV file and keep it for the trend check when due
+    //!
+    //! \return true when the row was written
+    bool endSample();
+
+    //! Close the CSV file
+    void close();
+
+    //! \return number of metrics added
+    U32 getMetricCount() const;
+
+    //! \return number of samples kept for the trend check
+    U32 getKeptCount() const;
+
+    //! Compute the trend of a metric over the samples kept
+    //!
+    //! \return true when the metric passed, false when it trended upward beyond its slack
+    bool getTrend(U32 metric,   /*!< Index returned by addMetric*/
+                  Trend& trend  /*!< Out: trend of the metric*/
+    ) const;
+
+  PRIVATE:
+    //! Drop every other sample kept and double the stride between samples kept from now on
+    void decimate();
+
+    struct Metric {
+        const char* name;   //!< Column name
+        U32 slackPercent;   //!< Growth allowed in percent of the first value kept
+        U64 slackAbsolute;  //!< Least growth allowed
+    };
+
+    Os::File file;                              //!< CSV file samples are written to
+    bool fileOpen;                              //!< The CSV file is open
+    Metric metrics[MAX_METRICS];                //!< Metrics added
+    U32 metricCount;                            //!< Number of metrics added
+    U64 cycle;                                  //!< Cycle of the current sample
+    bool warmUp;                                //!< The current sample falls within the warm-up
+    U64 current[MAX_METRICS];                   //!< Values of the current sample
+    U32 stride;                                 //!< Samples after the warm-up per sample kept
+    U32 skipped;                                //!< Samples after the warm-up since the last sample kept
+    U32 kept;                                   //!< Samples kept
+    U64 keptCycles[MAX_SAMPLES];                //!< Cycle of each sample kept
+    U64 keptValues[MAX_SAMPLES][MAX_METRICS];   //!< Values of each sample kept
+};
+
+}  // namespace LedBlinker
+
+#endif
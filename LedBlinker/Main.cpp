@@ -21,7 +21,11 @@
  * @param app: name of application
  */
 void print_usage(const char* app) {
-    (void)printf("Usage: ./%s [options]\n-a\thostname/IP address\n-p\tport_number\n", app);
+    (void)printf(
+        "Usage: ./%s [options]\n-a\thostname/IP address\n-p\tport_number\n-d\tteardown deadline (ms)\n"
+        "-r\tfile recording led port invocations\n-s\trun N simulated seconds in virtual time and exit\n"
+        "-g\tsimulate GPIO, capturing edges for gpioDriver.DUMP_EDGES\n",
+        app);
 }
 
 /**
@@ -48,11 +52,15 @@ static void signalHandler(int signum) {
  */
 int main(int argc, char* argv[]) {
     U32 port_number = 0;
+    U32 teardown_deadline = 0;
     I32 option = 0;
     char* hostname = nullptr;
+    char* record_file = nullptr;
+    U32 simulated_seconds = 0;
+    bool simulate_gpio = false;
 
     // Loop while reading the getopt supplied options
-    while ((option = getopt(argc, argv, "hp:a:")) != -1) {
+    while ((option = getopt(argc, argv, "hp:a:d:r:s:g")) != -1) {
         switch (option) {
             // Handle the -a argument for address/hostname
             case 'a':
@@ -62,6 +70,22 @@ int main(int argc, char* argv[]) {
             case 'p':
                 port_number = static_cast<U32>(atoi(optarg));
                 break;
+            // Handle the -d teardown deadline argument
+            case 'd':
+                teardown_deadline = static_cast<U32>(atoi(optarg));
+                break;
+            // Handle the -r port recording argument
+            case 'r':
+                record_file = optarg;
+                break;
+            // Handle the -s simulated seconds argument
+            case 's':
+                simulated_seconds = static_cast<U32>(atoi(optarg));
+                break;
+            // Handle the -g simulated GPIO argument
+            case 'g':
+                simulate_gpio = true;
+                break;
             // Cascade intended: help output
             case 'h':
             // Cascade intended: help output
@@ -76,6 +100,9 @@ int main(int argc, char* argv[]) {
     LedBlinker::TopologyState inputs;
     inputs.hostname = hostname;
     inputs.port = port_number;
+    inputs.teardownDeadline = teardown_deadline;
+    inputs.recordFile = record_file;
+    inputs.simulateGpio = simulate_gpio;
 
     // Setup program shutdown via Ctrl-C
     signal(SIGINT, signalHandler);
@@ -84,7 +111,11 @@ int main(int argc, char* argv[]) {
 
     // Setup, cycle, and teardown topology
     LedBlinker::setupTopology(inputs);
-    LedBlinker::startSimulatedCycle(1000);  // Program loop cycling rate groups at 1Hz
+    if (simulated_seconds > 0) {
+        LedBlinker::startVirtualCycle(1000, simulated_seconds);  // 1Hz cycling in virtual time, as fast as possible
+    } else {
+        LedBlinker::startSimulatedCycle(1000);  // Program loop cycling rate groups at 1Hz
+    }
     LedBlinker::teardownTopology(inputs);
     (void)printf("Exiting...\n");
     return 0;
@@ -0,0 +1,390 @@
+// ======================================================================
+// \title  ScaleMain.cpp
+// \brief  measures memory and context switches of many Led instances, queued as deployed and with a thread each as
+//         when Led was an active component
+//
+// ======================================================================
+// Used for the queue depth and stack size of the deployed instance
+#include <LedBlinker/Top/LedBlinkerTopologyAc.hpp>
+#include <Components/Led/Led.hpp>
+#include <Fw/Cmd/CmdArgBuffer.hpp>
+#include <Fw/Cmd/CmdResponsePortAc.hpp>
+#include <Fw/Comp/PassiveComponentBase.hpp>
+#include <Fw/Prm/PrmGetPortAc.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/OnEnumAc.hpp>
+#include <Os/Queue.hpp>
+#include <Os/Task.hpp>
+// Used to run each variant in a process of its own
+#include <sys/wait.h>
+#include <unistd.h>
+// Used for command line argument processing
+#include <getopt.h>
+// Used for context switch accounting
+#include <sys/resource.h>
+// Used for printf functions
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+//! Instances run when none are given
+const U32 DEFAULT_INSTANCES = 100;
+//! Rate group ticks run when none are given
+const U32 DEFAULT_TICKS = 10000;
+//! Ticks between BLINKING_ON_OFF commands sent to every instance, when none are given
+const U32 DEFAULT_COMMAND_PERIOD = 100;
+//! Most instances run
+const U32 MAX_INSTANCES = 10000;
+//! BLINK_INTERVAL served to every instance, in ticks
+const U32 BLINK_INTERVAL = 10;
+//! Message sent to a dispatch thread to dispatch one queued message
+const U8 WAKE_DISPATCH = 0;
+//! Message sent to a dispatch thread to exit
+const U8 WAKE_EXIT = 1;
+
+//! \class ThreadedLed
+//! \brief A Led whose commands are dispatched by a thread of its own, as they were when Led was an active component
+//!
+//! The thread has the stack size of the deployed instances and blocks on a wake queue between commands, as an active
+//! component blocks on its message queue. The Led still drains its queue in run calls, but finds it empty: the driver
+//! waits for every command to be answered before the next tick, so handlers never run on two threads at once.
+class ThreadedLed : public Components::Led {
+  public:
+    explicit ThreadedLed(const char* compName) : Led(compName) {}
+
+    //! Create the wake queue and start the dispatch thread
+    //!
+    //! \return true when the thread was started
+    bool start() {
+        Os::QueueString queueName("LedWake");
+        if (Os::Queue::QUEUE_OK != this->wakeQueue.create(queueName, Default::QUEUE_SIZE, sizeof(U8))) {
+            return false;
+        }
+        Os::TaskString taskName("LedDispatch");
+        return Os::Task::TASK_OK == this->task.start(taskName, ThreadedLed::dispatchTask, this, Os::Task::TASK_DEFAULT,
+                                                     Default::STACK_SIZE);
+    }
+
+    //! Wake the dispatch thread with a message
+    void wake(U8 message) {
+        const Os::Queue::QueueStatus status =
+            this->wakeQueue.send(&message, sizeof(message), 0, Os::Queue::QUEUE_BLOCKING);
+        FW_ASSERT(Os::Queue::QUEUE_OK == status, status);
+    }
+
+    //! Stop the dispatch thread and wait for it to exit
+    void stop() {
+        this->wake(WAKE_EXIT);
+        (void)this->task.join(nullptr);
+    }
+
+  private:
+    static void dispatchTask(void* arg) {
+        ThreadedLed* led = static_cast<ThreadedLed*>(arg);
+        U8 message = WAKE_DISPATCH;
+        NATIVE_INT_TYPE size = 0;
+        NATIVE_INT_TYPE priority = 0;
+        while (Os::Queue::QUEUE_OK == led->wakeQueue.receive(&message, sizeof(message), size, priority,
+                                                                Os::Queue::QUEUE_BLOCKING) &&
+               WAKE_DISPATCH == message) {
+            (void)led->doDispatch();
+        }
+    }
+
+    Os::Queue wakeQueue;  //! Messages to the dispatch thread
+    Os::Task task;        //! Dispatch thread
+};
+
+//! \class Fleet
+//! \brief Instances run side by side, with parameters and command responses served by sinks that keep no history
+class Fleet : public Fw::PassiveComponentBase {
+  public:
+    Fleet() : Fw::PassiveComponentBase("Fleet"), count(0), threaded(false), commandSeq(0), failures(0) {
+        this->init(0);
+        this->responsePort.init();
+        this->responsePort.addCallComp(this, Fleet::cmdResponseIn);
+        this->prmGetPort.init();
+        this->prmGetPort.addCallComp(this, Fleet::prmGetIn);
+    }
+
+    //! Create and connect the instances, starting a dispatch thread for each when threaded
+    //!
+    //! \return true when every thread was started
+    bool create(U32 instances, bool withThreads) {
+        FW_ASSERT(instances <= MAX_INSTANCES, instances);
+        this->threaded = withThreads;
+        if (this->threaded) {
+            Os::QueueString queueName("Answered");
+            if (Os::Queue::QUEUE_OK != this->answered.create(queueName, static_cast<NATIVE_INT_TYPE>(instances),
+                                                             sizeof(U8))) {
+                return false;
+            }
+        }
+        for (; this->count < instances; this->count++) {
+            ThreadedLed* led = new ThreadedLed("led");
+            led->init(Default::QUEUE_SIZE, static_cast<NATIVE_INT_TYPE>(this->count));
+            led->set_prmGetOut_OutputPort(0, &this->prmGetPort);
+            led->set_cmdResponseOut_OutputPort(0, &this->responsePort);
+            led->loadParameters();
+            this->leds[this->count] = led;
+            if (this->threaded && !led->start()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Send BLINKING_ON_OFF to every instance. With threads, wake each one and wait until every command is answered.
+    void command(Fw::On on_off) {
+        Fw::CmdArgBuffer args;
+        const Fw::SerializeStatus status = args.serialize(on_off);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+        for (U32 i = 0; i < this->count; i++) {
+            args.resetDeser();
+            this->leds[i]->get_cmdIn_InputPort(0)->invoke(Components::Led::OPCODE_BLINKING_ON_OFF, this->commandSeq++,
+                                                          args);
+            if (this->threaded) {
+                this->leds[i]->wake(WAKE_DISPATCH);
+            }
+        }
+        for (U32 i = 0; this->threaded && (i < this->count); i++) {
+            U8 message = 0;
+            NATIVE_INT_TYPE size = 0;
+            NATIVE_INT_TYPE priority = 0;
+            const Os::Queue::QueueStatus received =
+                this->answered.receive(&message, sizeof(message), size, priority, Os::Queue::QUEUE_BLOCKING);
+            FW_ASSERT(Os::Queue::QUEUE_OK == received, received);
+        }
+    }
+
+    //! Call the run port of every instance, as the rate group does on each tick
+    void tick(U32 context) {
+        for (U32 i = 0; i < this->count; i++) {
+            this->leds[i]->get_run_InputPort(0)->invoke(context);
+        }
+    }
+
+    //! Stop the dispatch threads and delete the instances
+    void destroy() {
+        for (U32 i = 0; i < this->count; i++) {
+            if (this->threaded) {
+                this->leds[i]->stop();
+            }
+            delete this->leds[i];
+        }
+        this->count = 0;
+    }
+
+    //! \return command responses other than OK
+    U32 getFailures() const { return this->failures.load(); }
+
+  private:
+    static void cmdResponseIn(Fw::PassiveComponentBase* callComp,
+                              NATIVE_INT_TYPE portNum,
+                              FwOpcodeType opCode,
+                              U32 cmdSeq,
+                              const Fw::CmdResponse& response) {
+        // Called on the dispatch thread of a threaded instance
+        Fleet* fleet = static_cast<Fleet*>(callComp);
+        if (Fw::CmdResponse::OK != response) {
+            fleet->failures.fetch_add(1);
+        }
+        if (fleet->threaded) {
+            const U8 message = 0;
+            const Os::Queue::QueueStatus status =
+                fleet->answered.send(&message, sizeof(message), 0, Os::Queue::QUEUE_NONBLOCKING);
+            FW_ASSERT(Os::Queue::QUEUE_OK == status, status);
+        }
+    }
+
+    static Fw::ParamValid prmGetIn(Fw::PassiveComponentBase* callComp,
+                                   NATIVE_INT_TYPE portNum,
+                                   FwPrmIdType id,
+                                   Fw::ParamBuffer& val) {
+        // Only BLINK_INTERVAL is served and the rest take their defaults
+        if (Components::Led::PARAMID_BLINK_INTERVAL != id) {
+            return Fw::ParamValid::INVALID;
+        }
+        val.resetSer();
+        const Fw::SerializeStatus status = val.serialize(BLINK_INTERVAL);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+        return Fw::ParamValid::VALID;
+    }
+
+    Fw::InputCmdResponsePort responsePort;  //! Receives command responses
+    Fw::InputPrmGetPort prmGetPort;         //! Serves BLINK_INTERVAL
+    Os::Queue answered;                     //! One message per command answered by a dispatch thread
+    ThreadedLed* leds[MAX_INSTANCES];       //! Instances created
+    U32 count;                              //! Number of instances created
+    bool threaded;                          //! Each instance dispatches its commands on a thread of its own
+    U32 commandSeq;                         //! Sequence number of the next command
+    std::atomic<U32> failures;              //! Command responses other than OK
+};
+
+//! Figures of the process read from /proc/self/status, in KiB except the thread count
+struct ProcessStatus {
+    U64 threads;  //!< Threads of the process
+    U64 vmSize;   //!< Virtual memory size, thread stacks included
+    U64 vmRss;    //!< Resident set size
+    U64 vmHwm;    //!< Peak resident set size
+};
+
+//! \return figures of the process, 0 where unavailable
+ProcessStatus processStatus() {
+    ProcessStatus status = {0, 0, 0, 0};
+    FILE* file = fopen("/proc/self/status", "r");
+    if (file == nullptr) {
+        return status;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        unsigned long long value = 0;
+        if (sscanf(line, "Threads: %llu", &value) == 1) {
+            status.threads = value;
+        } else if (sscanf(line, "VmSize: %llu", &value) == 1) {
+            status.vmSize = value;
+        } else if (sscanf(line, "VmRSS: %llu", &value) == 1) {
+            status.vmRss = value;
+        } else if (sscanf(line, "VmHWM: %llu", &value) == 1) {
+            status.vmHwm = value;
+        }
+    }
+    (void)fclose(file);
+    return status;
+}
+
+//! Options of a run
+struct ScaleOptions {
+    U32 instances;      //!< Instances run
+    U32 ticks;          //!< Rate group ticks run
+    U32 commandPeriod;  //!< Ticks between BLINKING_ON_OFF commands to every instance
+};
+
+//! Instances of the variant run in this process
+Fleet fleet;
+
+//! Run one variant and print its figures. Context switches are those of every thread of the process while ticking.
+//!
+//! \return 0 on success
+int runVariant(const char* name, bool threaded, const ScaleOptions& options) {
+    const ProcessStatus before = processStatus();
+    if (!fleet.create(options.instances, threaded)) {
+        (void)printf("[SCALE] %s: failed to create the instances\n", name);
+        return 1;
+    }
+    struct rusage start;
+    (void)getrusage(RUSAGE_SELF, &start);
+    U32 commands = 0;
+    for (U32 tick = 0; tick < options.ticks; tick++) {
+        if ((tick % options.commandPeriod) == 0) {
+            fleet.command(Fw::On((commands++ & 1) ? Fw::On::OFF : Fw::On::ON));
+        }
+        fleet.tick(tick);
+    }
+    struct rusage end;
+    (void)getrusage(RUSAGE_SELF, &end);
+    const ProcessStatus after = processStatus();
+    const U32 failures = fleet.getFailures();
+    fleet.destroy();
+
+    const U64 voluntary = static_cast<U64>(end.ru_nvcsw - start.ru_nvcsw);
+    const U64 involuntary = static_cast<U64>(end.ru_nivcsw - start.ru_nivcsw);
+    (void)printf(
+        "[SCALE] %-6s instances %u, ticks %u, commands per instance %u: threads %llu (+%llu), VmSize %llu KiB "
+        "(+%llu), VmRSS %llu KiB (+%llu), VmHWM %llu KiB, context switches %llu voluntary, %llu involuntary\n",
+        name, options.instances, options.ticks, commands, static_cast<unsigned long long>(after.threads),
+        static_cast<unsigned long long>(after.threads - before.threads),
+        static_cast<unsigned long long>(after.vmSize), static_cast<unsigned long long>(after.vmSize - before.vmSize),
+        static_cast<unsigned long long>(after.vmRss), static_cast<unsigned long long>(after.vmRss - before.vmRss),
+        static_cast<unsigned long long>(after.vmHwm), static_cast<unsigned long long>(voluntary),
+        static_cast<unsigned long long>(involuntary));
+    if (failures > 0) {
+        (void)printf("[SCALE] %s: %u commands failed\n", name, failures);
+        return 1;
+    }
+    return 0;
+}
+
+//! Run one variant in a child process, so that neither variant sees the threads or memory of the other
+//!
+//! \return 0 on success
+int forkVariant(const char* name, bool threaded, const ScaleOptions& options) {
+    (void)fflush(stdout);
+    const pid_t child = fork();
+    if (child < 0) {
+        (void)printf("[SCALE] %s: fork failed\n", name);
+        return 1;
+    }
+    if (child == 0) {
+        const int status = runVariant(name, threaded, options);
+        (void)fflush(stdout);
+        _exit(status);
+    }
+    int status = 0;
+    if ((waitpid(child, &status, 0) != child) || !WIFEXITED(status)) {
+        (void)printf("[SCALE] %s: did not exit\n", name);
+        return 1;
+    }
+    return WEXITSTATUS(status);
+}
+
+}  // namespace
+
+/**
+ * \brief print command line help message
+ *
+ * @param app: name of application
+ */
+void print_usage(const char* app) {
+    (void)printf(
+        "Usage: ./%s [options]\n-n\tinstances (default %u, at most %u)\n-c\tticks to run (default %u)\n"
+        "-b\tticks between BLINKING_ON_OFF commands to every instance (default %u)\n",
+        app, DEFAULT_INSTANCES, MAX_INSTANCES, DEFAULT_TICKS, DEFAULT_COMMAND_PERIOD);
+}
+
+/**
+ * \brief run the queued and the threaded variant in turn, each in a process of its own
+ *
+ * @param argc: argument count supplied to program
+ * @param argv: argument values supplied to program
+ * @return: 0 when both variants ran
+ */
+int main(int argc, char* argv[]) {
+    ScaleOptions options = {DEFAULT_INSTANCES, DEFAULT_TICKS, DEFAULT_COMMAND_PERIOD};
+    I32 option = 0;
+
+    // Loop while reading the getopt supplied options
+    while ((option = getopt(argc, argv, "hn:c:b:")) != -1) {
+        switch (option) {
+            // Handle the -n instances argument
+            case 'n':
+                options.instances = static_cast<U32>(atoi(optarg));
+                break;
+            // Handle the -c ticks argument
+            case 'c':
+                options.ticks = static_cast<U32>(atoi(optarg));
+                break;
+            // Handle the -b command period argument
+            case 'b':
+                options.commandPeriod = static_cast<U32>(atoi(optarg));
+                break;
+            // Cascade intended: help output
+            case 'h':
+            // Cascade intended: help output
+            case '?':
+            // Default case: output help and exit
+            default:
+                print_usage(argv[0]);
+                return (option == 'h') ? 0 : 1;
+        }
+    }
+    if ((options.instances == 0) || (options.instances > MAX_INSTANCES) || (options.commandPeriod == 0)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const int queued = forkVariant("queued", false, options);
+    const int threaded = forkVariant("active", true, options);
+    return ((queued == 0) && (threaded == 0)) ? 0 : 1;
+}
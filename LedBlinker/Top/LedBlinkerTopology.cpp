@@ -9,12 +9,22 @@
 #include <LedBlinker/Top/LedBlinkerTopologyAc.hpp>
 
 // Necessary project-specified types
-#include <Fw/Types/MallocAllocator.hpp>
+#include <Fw/Logger/Logger.hpp>
+#include <Os/IntervalTimer.hpp>
 #include <Os/Log.hpp>
+#include <Os/Task.hpp>
 #include <Svc/FramingProtocol/FprimeProtocol.hpp>
+#include <Utils/ArenaAllocator/ArenaAllocator.hpp>
+#include <Utils/HeapGuard/HeapGuard.hpp>
+#include <Utils/PortRecorder/PortRecorder.hpp>
+#include <Utils/PortTrace/PortTrace.hpp>
 
 // Used for 1Hz synthetic cycling
-#include <Os/Mutex.hpp>
+#include <Utils/MutexProfile/MutexProfile.hpp>
+
+// Used to force process exit when teardown overruns its deadline
+#include <unistd.h>
+#include <cstdlib>
 
 // Allows easy reference to objects in FPP/autocoder required namespaces
 using namespace LedBlinker;
@@ -22,9 +32,12 @@ using namespace LedBlinker;
 // Instantiate a system logger that will handle Fw::Logger::logMsg calls
 Os::Log logger;
 
-// The reference topology uses a malloc-based allocator for components that need to allocate memory during the
-// initialization phase.
-Fw::MallocAllocator mallocator;
+// Components that need to allocate memory during the initialization phase are served from a single arena reserved at
+// startup, locked into memory so that no page faults occur once the deployment is running.
+Utils::ArenaAllocator arena;
+
+// Records the led component's port invocations for later replay when requested on the command line
+Utils::PortRecorder ledRecorder;
 
 // The reference topology uses the F´ packet protocol when communicating with the ground and therefore uses the F´
 // framing and deframing implementations.
@@ -34,14 +47,11 @@ Svc::FprimeDeframing deframing;
 // The reference topology divides the incoming clock signal (1Hz) into sub-signals: 1Hz, 1/2Hz, and 1/4Hz
 NATIVE_INT_TYPE rateGroupDivisors[Svc::RateGroupDriver::DIVIDER_SIZE] = {1, 2, 4};
 
-// Rate groups may supply a context token to each of the attached children whose purpose is set by the project. The
-// reference topology sets each token to zero as these contexts are unused in this project.
-NATIVE_INT_TYPE rateGroup1Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
-NATIVE_INT_TYPE rateGroup2Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
-NATIVE_INT_TYPE rateGroup3Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
+// Rate groups pass each member the cycle number as its context, so they take no context arrays.
 
 // A number of constants are needed for construction of the topology. These are specified here.
 enum TopologyConstants {
+    ARENA_SIZE = 128 * 1024,
     CMD_SEQ_BUFFER_SIZE = 5 * 1024,
     FILE_DOWNLINK_TIMEOUT = 1000,
     FILE_DOWNLINK_COOLDOWN = 1000,
@@ -51,7 +61,9 @@ enum TopologyConstants {
     COMM_PRIORITY = 100,
     UPLINK_BUFFER_MANAGER_STORE_SIZE = 3000,
     UPLINK_BUFFER_MANAGER_QUEUE_SIZE = 30,
-    UPLINK_BUFFER_MANAGER_ID = 200
+    UPLINK_BUFFER_MANAGER_ID = 200,
+    TEARDOWN_DEFAULT_DEADLINE = 2000,
+    TEARDOWN_POLL_INTERVAL = 10
 };
 
 // Ping entries are autocoded, however; this code is not properly exported. Thus, it is copied here.
@@ -70,33 +82,108 @@ Svc::Health::PingEntry pingEntries[] = {
     {PingEntries::rateGroup3::WARN, PingEntries::rateGroup3::FATAL, "rateGroup3"},
 };
 
+/**
+ * \brief report the duration of a startup phase
+ *
+ * Stops the supplied timer, logs the time elapsed since it was started under the given phase name, and restarts it so
+ * the next phase may be timed with the same timer.
+ *
+ * \param phase: name of the phase that just completed
+ * \param timer: timer started at the beginning of the phase
+ */
+void reportStartupPhase(const char* phase, Os::IntervalTimer& timer) {
+    timer.stop();
+    Fw::Logger::logMsg("[STARTUP] %-24s %10u us\n", reinterpret_cast<POINTER_CAST>(phase), timer.getDiffUsec());
+    timer.start();
+}
+
+/**
+ * \brief read the parameter database from disk
+ *
+ * Task routine run alongside the other configuration steps as the parameter file read is blocking file I/O.
+ */
+void configureParameters(void* unused) {
+    Os::IntervalTimer timer;
+    timer.start();
+    // Parameter database is configured with a database file name, and that file must be initially read.
+    prmDb.configure("PrmDb.dat");
+    prmDb.readParamFile();
+    reportStartupPhase("  prmDb.readParamFile", timer);
+}
+
+/**
+ * \brief open the GPIO line driving the LED
+ *
+ * Task routine run alongside the other configuration steps as requesting the GPIO line is blocking I/O. When the
+ * topology simulates GPIO no device is opened and every edge is captured by the driver instead.
+ *
+ * \param state: pointer to the TopologyState supplied to setupTopology
+ */
+void configureGpio(void* state) {
+    Os::IntervalTimer timer;
+    timer.start();
+    const U32 gpioLines[] = {13};
+    if (static_cast<const TopologyState*>(state)->simulateGpio) {
+        gpioDriver.openSimulated(FW_NUM_ARRAY_ELEMENTS(gpioLines));
+    } else {
+        bool gpio_success = gpioDriver.open("/dev/gpiochip0", gpioLines, FW_NUM_ARRAY_ELEMENTS(gpioLines));
+        if (!gpio_success) {
+            printf("[ERROR] Failed to open GPIO pin\n");
+        }
+    }
+    reportStartupPhase("  gpioDriver.open", timer);
+}
+
 /**
  * \brief configure/setup components in project-specific way
  *
  * This is a *helper* function which configures/sets up each component requiring project specific input. This includes
  * allocating resources, passing-in arguments, etc. This function may be inlined into the topology setup function if
  * desired, but is extracted here for clarity.
+ *
+ * Steps that block on I/O and are independent of each other are overlapped: the parameter file read and the GPIO open
+ * each run on a short-lived task while the remaining components are set up on the calling thread. Both helper tasks
+ * are joined before returning so the topology is fully configured when this function completes.
+ *
+ * \param state: object shuttling CLI arguments needed to configure the GPIO and the port recording
  */
-void configureTopology() {
+void configureTopology(const TopologyState& state) {
+    // Kick-off the blocking I/O steps first so they overlap with the rest of the configuration
+    Os::Task prmDbTask;
+    Os::Task gpioTask;
+    Os::TaskString prmDbTaskName("PrmDbLoad");
+    Os::TaskString gpioTaskName("GpioOpen");
+    Os::Task::TaskStatus prmDbStatus =
+        prmDbTask.start(prmDbTaskName, configureParameters, nullptr, Os::Task::TASK_DEFAULT, Default::STACK_SIZE);
+    if (prmDbStatus != Os::Task::TASK_OK) {
+        configureParameters(nullptr);
+    }
+    void* gpioArgument = const_cast<TopologyState*>(&state);
+    Os::Task::TaskStatus gpioStatus =
+        gpioTask.start(gpioTaskName, configureGpio, gpioArgument, Os::Task::TASK_DEFAULT, Default::STACK_SIZE);
+    if (gpioStatus != Os::Task::TASK_OK) {
+        configureGpio(gpioArgument);
+    }
+
+    // Framer and Deframer components need to be passed a protocol handler
+    downlink.setup(framing);
+    uplink.setup(deframing);
+
+    // Arena backing init-time allocations. Huge pages are not requested as the arena is smaller than one huge page.
+    if (!arena.reserve(ARENA_SIZE, false, true)) {
+        printf("[ERROR] Failed to reserve allocation arena\n");
+    }
+
     // Command sequencer needs to allocate memory to hold contents of command sequences
-    cmdSeq.allocateBuffer(0, mallocator, CMD_SEQ_BUFFER_SIZE);
+    cmdSeq.allocateBuffer(0, arena, CMD_SEQ_BUFFER_SIZE);
 
     // Rate group driver needs a divisor list
     rateGroupDriver.configure(rateGroupDivisors, FW_NUM_ARRAY_ELEMENTS(rateGroupDivisors));
 
-    // Rate groups require context arrays. Empty for LedBlinkererence example.
-    rateGroup1.configure(rateGroup1Context, FW_NUM_ARRAY_ELEMENTS(rateGroup1Context));
-    rateGroup2.configure(rateGroup2Context, FW_NUM_ARRAY_ELEMENTS(rateGroup2Context));
-    rateGroup3.configure(rateGroup3Context, FW_NUM_ARRAY_ELEMENTS(rateGroup3Context));
-
     // File downlink requires some project-derived properties.
     fileDownlink.configure(FILE_DOWNLINK_TIMEOUT, FILE_DOWNLINK_COOLDOWN, FILE_DOWNLINK_CYCLE_TIME,
                            FILE_DOWNLINK_FILE_QUEUE_DEPTH);
 
-    // Parameter database is configured with a database file name, and that file must be initially read.
-    prmDb.configure("PrmDb.dat");
-    prmDb.readParamFile();
-
     // Health is supplied a set of ping entires.
     health.setPingEntries(pingEntries, FW_NUM_ARRAY_ELEMENTS(pingEntries), HEALTH_WATCHDOG_CODE);
 
@@ -105,48 +192,85 @@ void configureTopology() {
     memset(&upBuffMgrBins, 0, sizeof(upBuffMgrBins));
     upBuffMgrBins.bins[0].bufferSize = UPLINK_BUFFER_MANAGER_STORE_SIZE;
     upBuffMgrBins.bins[0].numBuffers = UPLINK_BUFFER_MANAGER_QUEUE_SIZE;
-    fileUplinkBufferManager.setup(UPLINK_BUFFER_MANAGER_ID, 0, mallocator, upBuffMgrBins);
+    fileUplinkBufferManager.setup(UPLINK_BUFFER_MANAGER_ID, 0, arena, upBuffMgrBins);
 
-    // Framer and Deframer components need to be passed a protocol handler
-    downlink.setup(framing);
-    uplink.setup(deframing);
+    // Led PWM brightness timer thread, started only while PWM brightness mode is on
+    led.configurePwm(Os::Task::TASK_DEFAULT, Default::STACK_SIZE);
+
+    // Port recording of the led component for replay in its unit test harness
+    if (state.recordFile != nullptr) {
+        if (ledRecorder.open(state.recordFile)) {
+            led.setRecorder(&ledRecorder);
+        } else {
+            printf("[ERROR] Failed to open port recording %s\n", state.recordFile);
+        }
+    }
 
     // Note: Uncomment when using Svc:TlmPacketizer
     // tlmSend.setPacketList(LedBlinkerPacketsPkts, LedBlinkerPacketsIgnore, 1);
-    bool gpio_success = gpioDriver.open(13, Drv::LinuxGpioDriver::GpioDirection::GPIO_OUT);
-    if (!gpio_success) {
-        printf("[ERROR] Failed to open GPIO pin\n");
+
+    // Wait for the overlapped I/O steps to complete
+    if (prmDbStatus == Os::Task::TASK_OK) {
+        (void)prmDbTask.join(nullptr);
+    }
+    if (gpioStatus == Os::Task::TASK_OK) {
+        (void)gpioTask.join(nullptr);
     }
+
+    // Report the memory footprint of init-time allocations
+    arena.report();
 }
 
 // Public functions for use in main program are namespaced with deployment name LedBlinker
 namespace LedBlinker {
 void setupTopology(const TopologyState& state) {
+    // Each phase is timed and reported so that slow startup steps are visible at boot
+    Os::IntervalTimer total;
+    Os::IntervalTimer phase;
+    total.start();
+    phase.start();
+
     // Autocoded initialization. Function provided by autocoder.
     initComponents(state);
+    reportStartupPhase("initComponents", phase);
     // Autocoded id setup. Function provided by autocoder.
     setBaseIds();
+    reportStartupPhase("setBaseIds", phase);
     // Autocoded connection wiring. Function provided by autocoder.
     connectComponents();
+    reportStartupPhase("connectComponents", phase);
     // Autocoded command registration. Function provided by autocoder.
     regCommands();
-    // Project-specific component configuration. Function provided above. May be inlined, if desired.
-    configureTopology();
+    reportStartupPhase("regCommands", phase);
+    // Project-specific component configuration. Function provided above.
+    configureTopology(state);
+    reportStartupPhase("configureTopology", phase);
     // Autocoded parameter loading. Function provided by autocoder.
     // loadParameters();
     // Autocoded task kick-off (active components). Function provided by autocoder.
     startTasks(state);
-    // Initialize socket client communication if and only if there is a valid specification
+    reportStartupPhase("startTasks", phase);
+
+    // Initialize socket client communication if and only if there is a valid specification. Uplinked packets may
+    // arrive as soon as the socket task runs, so it is started last, once every buffer manager is set up and the
+    // command dispatcher's task is running.
     if (state.hostname != nullptr && state.port != 0) {
         Os::TaskString name("ReceiveTask");
         // Uplink is configured for receive so a socket task is started
         comm.configure(state.hostname, state.port);
         comm.startSocketTask(name, true, COMM_PRIORITY, Default::STACK_SIZE);
+        reportStartupPhase("startSocketTask", phase);
     }
+
+    // The deployment accepts commands once the active component tasks are running
+    reportStartupPhase("total", total);
+
+    // No heap allocation is expected from here on. Traced in LEDBLINKER_HEAP_GUARD builds.
+    Utils::HeapGuard::arm();
 }
 
 // Variables used for cycle simulation
-Os::Mutex cycleLock;
+Utils::NamedMutex cycleLock("Topology.cycleLock");
 volatile bool cycleFlag = true;
 
 void startSimulatedCycle(U32 milliseconds) {
@@ -165,23 +289,210 @@ void startSimulatedCycle(U32 milliseconds) {
     }
 }
 
+// Ticks driven by startVirtualCycle, kept across calls so that expected rate group cycles follow the divisor phase of
+// the rate group driver
+U64 virtualTicks = 0;
+
+void startVirtualCycle(U32 milliseconds, U32 seconds) {
+    FW_ASSERT(milliseconds > 0);
+    cycleLock.lock();
+    bool cycling = cycleFlag;
+    cycleLock.unLock();
+
+    // Cycles expected to be completed by each rate group, per the divisors configured on the rate group driver. Counts
+    // are cumulative, so they start from those completed before this call.
+    U32 expected[FW_NUM_ARRAY_ELEMENTS(rateGroupDivisors)];
+    for (NATIVE_UINT_TYPE i = 0; i < FW_NUM_ARRAY_ELEMENTS(rateGroupDivisors); i++) {
+        expected[i] = systemTime.getCompletedCycles(static_cast<NATIVE_INT_TYPE>(i));
+    }
+    const U64 cycles = (static_cast<U64>(seconds) * 1000) / milliseconds;
+    // The time source is left as it was found. Virtual time continues from where a previous call left it.
+    const bool wasVirtual = systemTime.isVirtualTime();
+    systemTime.setVirtual(true);
+
+    // Main loop: time only advances when the previous cycle has been fully processed
+    for (U64 tick = 0; cycling && (tick < cycles); tick++) {
+        systemTime.advance(milliseconds * 1000);
+        for (NATIVE_UINT_TYPE i = 0; i < FW_NUM_ARRAY_ELEMENTS(rateGroupDivisors); i++) {
+            expected[i] += ((virtualTicks % static_cast<U64>(rateGroupDivisors[i])) == 0) ? 1 : 0;
+        }
+        virtualTicks++;
+        LedBlinker::blockDrv.callIsr();
+
+        // Wait for every rate group scheduled on this tick so that no queue overflows
+        for (NATIVE_UINT_TYPE i = 0; i < FW_NUM_ARRAY_ELEMENTS(rateGroupDivisors); i++) {
+            systemTime.waitForCycles(static_cast<NATIVE_INT_TYPE>(i), expected[i]);
+        }
+
+        cycleLock.lock();
+        cycling = cycleFlag;
+        cycleLock.unLock();
+    }
+    systemTime.setVirtual(wasVirtual);
+}
+
 void stopSimulatedCycle() {
     cycleLock.lock();
     cycleFlag = false;
     cycleLock.unLock();
 }
 
+// Active component instances joined during teardown, one at a time so each may be timed. The list is generated from
+// instances.fpp by CMakeLists.txt.
+struct TeardownEntry {
+    Fw::ActiveComponentBase& component;
+    const char* name;
+};
+TeardownEntry teardownEntries[] = {
+#include <LedBlinker/Top/LedBlinkerTeardownAc.hpp>
+};
+
+// Variables used for bounded teardown
+Utils::NamedMutex teardownLock("Topology.teardownLock");
+bool teardownDone = false;
+const char* teardownPhase = "";
+U32 teardownDeadline = TEARDOWN_DEFAULT_DEADLINE;
+
+/**
+ * \brief record the teardown phase in progress so an overrun can be attributed
+ */
+void setTeardownPhase(const char* phase) {
+    teardownLock.lock();
+    teardownPhase = phase;
+    teardownLock.unLock();
+}
+
+/**
+ * \brief report the duration of a teardown phase
+ *
+ * \param phase: name of the phase that just completed
+ * \param timer: timer started at the beginning of the phase
+ */
+void reportTeardownPhase(const char* phase, Os::IntervalTimer& timer) {
+    timer.stop();
+    Fw::Logger::logMsg("[TEARDOWN] %-24s %10u us\n", reinterpret_cast<POINTER_CAST>(phase), timer.getDiffUsec());
+}
+
+/**
+ * \brief force process exit when teardown overruns its deadline
+ *
+ * Task routine polling for teardown completion. Should the deadline pass first, the phase that is blocking is logged
+ * and the process exits immediately without running any further clean-up.
+ */
+void teardownWatchdog(void* unused) {
+    // Elapsed time is accumulated over polls, as the timer's difference wraps after 71 minutes
+    U64 elapsedUsec = 0;
+    Os::IntervalTimer timer;
+    timer.start();
+    while (true) {
+        teardownLock.lock();
+        bool done = teardownDone;
+        const char* phase = teardownPhase;
+        teardownLock.unLock();
+        if (done) {
+            return;
+        }
+        timer.stop();
+        elapsedUsec += timer.getDiffUsec();
+        timer.start();
+        if (elapsedUsec >= (static_cast<U64>(teardownDeadline) * 1000)) {
+            (void)printf("[TEARDOWN] Deadline of %u ms exceeded in %s, forcing exit\n", teardownDeadline, phase);
+            (void)fflush(stdout);
+            ::_exit(EXIT_FAILURE);
+        }
+        Os::Task::delay(TEARDOWN_POLL_INTERVAL);
+    }
+}
+
 void teardownTopology(const TopologyState& state) {
-    // Autocoded (active component) task clean-up. Functions provided by topology autocoder.
-    stopTasks(state);
-    freeThreads(state);
+    // Teardown may allocate. Report allocations made while running before reporting anything else.
+    Utils::HeapGuard::disarm();
+    if (Utils::HeapGuard::isEnabled()) {
+        Fw::Logger::logMsg("[HEAPGUARD] %u allocations after setup\n", Utils::HeapGuard::getAllocationCount());
+    }
 
-    // Other task clean-up.
+    Os::IntervalTimer total;
+    Os::IntervalTimer phase;
+    total.start();
+
+    // Guarantee exit within the deadline, even when a task never returns from join
+    teardownDeadline = (state.teardownDeadline != 0) ? state.teardownDeadline : TEARDOWN_DEFAULT_DEADLINE;
+    setTeardownPhase("stopTasks");
+    Os::Task watchdog;
+    Os::TaskString watchdogName("TeardownWdog");
+    Os::Task::TaskStatus watchdogStatus =
+        watchdog.start(watchdogName, teardownWatchdog, nullptr, Os::Task::TASK_DEFAULT, Default::STACK_SIZE);
+    if (watchdogStatus != Os::Task::TASK_OK) {
+        (void)printf("[ERROR] Failed to start teardown watchdog, teardown is unbounded\n");
+    }
+
+    // Wake every task at once before joining any of them. Autocoded stopTasks sends the exit message to each active
+    // component and stopping the socket task shuts the socket down, interrupting a blocked receive.
+    stopTasks(state);
     comm.stopSocketTask();
+
+    // Join each task in turn. Autocoded freeThreads is replaced by this loop so the time spent joining each component
+    // is reported.
+    for (NATIVE_UINT_TYPE i = 0; i < FW_NUM_ARRAY_ELEMENTS(teardownEntries); i++) {
+        setTeardownPhase(teardownEntries[i].name);
+        phase.start();
+        (void)teardownEntries[i].component.join(nullptr);
+        reportTeardownPhase(teardownEntries[i].name, phase);
+    }
+    setTeardownPhase("comm");
+    phase.start();
     (void)comm.joinSocketTask(nullptr);
+    reportTeardownPhase("comm", phase);
+    setTeardownPhase("ledPwm");
+    phase.start();
+    led.stopPwm();
+    reportTeardownPhase("ledPwm", phase);
+
+    // Every traced thread has stopped, so the timeline is complete
+    if (Utils::PortTrace::isEnabled()) {
+        setTeardownPhase("portTrace");
+        phase.start();
+        const char* traceFile = getenv("PORT_TRACE_FILE");
+        traceFile = (traceFile != nullptr) ? traceFile : "port_trace.json";
+        U32 events = 0;
+        if (Utils::PortTrace::dump(traceFile, events)) {
+            Fw::Logger::logMsg("[TRACE] %u port call events written\n", events);
+        } else {
+            (void)printf("[ERROR] Failed to write port trace %s\n", traceFile);
+        }
+        reportTeardownPhase("portTrace", phase);
+    }
+
+    // Every profiled mutex has been released for the last time by a component thread
+    if (Utils::MutexProfile::isEnabled()) {
+        setTeardownPhase("mutexProfile");
+        phase.start();
+        const char* profileFile = getenv("MUTEX_PROFILE_FILE");
+        profileFile = (profileFile != nullptr) ? profileFile : "mutex_profile.csv";
+        U32 mutexes = 0;
+        if (Utils::MutexProfile::dump(profileFile, mutexes)) {
+            Fw::Logger::logMsg("[MUTEX] statistics of %u mutexes written\n", mutexes);
+        } else {
+            (void)printf("[ERROR] Failed to write mutex profile %s\n", profileFile);
+        }
+        reportTeardownPhase("mutexProfile", phase);
+    }
 
     // Resource deallocation
-    cmdSeq.deallocateBuffer(mallocator);
+    setTeardownPhase("deallocation");
+    cmdSeq.deallocateBuffer(arena);
     fileUplinkBufferManager.cleanup();
+    arena.release();
+    led.setRecorder(nullptr);
+    ledRecorder.close();
+
+    // Release the watchdog
+    teardownLock.lock();
+    teardownDone = true;
+    teardownLock.unLock();
+    if (watchdogStatus == Os::Task::TASK_OK) {
+        (void)watchdog.join(nullptr);
+    }
+    reportTeardownPhase("total", total);
 }
 };  // namespace LedBlinker
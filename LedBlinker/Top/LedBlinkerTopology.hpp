@@ -32,6 +32,9 @@ namespace LedBlinker {
  * inserted between step 3 and 5. Step 7 may come before or after the active component initializations. Since these
  * custom tasks often start radio communication it is convenient to start them last.
  *
+ * The duration of each step is logged at boot with a "[STARTUP]" prefix, followed by the total time until the
+ * deployment is ready to accept commands.
+ *
  * The state argument carries command line inputs used to setup the topology. For an explanation of the required type
  * LedBlinker::TopologyState see: LedBlinkerTopologyDefs.hpp.
  *
@@ -52,7 +55,12 @@ void setupTopology(const TopologyState& state);
  *   5. Deallocate other resources
  *
  * Step 1, 2, 3, and 4 must occur in-order as the tasks must be stopped before being joined. These tasks must be stopped
- * and joined before any active resources may be deallocated.
+ * and joined before any active resources may be deallocated. Steps 1 and 3 are performed back-to-back so all tasks are
+ * woken together, and step 2 joins each active component individually so the time spent on each is logged.
+ *
+ * Teardown is bounded by `state.teardownDeadline` milliseconds. A watchdog task forces the process to exit, reporting
+ * the phase that blocked, should a task fail to stop in time (e.g. an exit message dropped by a full queue or a socket
+ * blocked in connect).
  *
  * For an explanation of the required type LedBlinker::TopologyState see: LedBlinkerTopologyDefs.hpp.
  *
@@ -76,10 +84,29 @@ void teardownTopology(const TopologyState& state);
  */
 void startSimulatedCycle(U32 milliseconds = 1000);
 
+/**
+ * \brief cycle the rate group driver in virtual time, as fast as possible
+ *
+ * Runs the given number of simulated seconds then returns. Before each cycle the `systemTime` component is advanced by
+ * `milliseconds` of virtual time, so every component requesting time observes the simulated timeline. Each cycle starts
+ * only once every rate group scheduled on the previous one has signalled completion to `systemTime`, keeping rate group
+ * queues from overflowing. Timeouts counted in rate group cycles (e.g. fileDownlink and health) therefore elapse in
+ * virtual time as well. Delays taken with `Os::Task::delay` and other operating system timers do not: see
+ * Components::VirtualClock for what keeps running on wall time.
+ *
+ * Rate group completions are counted from those already signalled when the call is made, and virtual time continues
+ * from where a previous call left it, so the loop may be run repeatedly. The block driver must not be cycled by anything
+ * else meanwhile. This loop may also be stopped early via a stopSimulatedCycle call.
+ *
+ * \param milliseconds: virtual milliseconds per cycle
+ * \param seconds: virtual seconds to simulate
+ */
+void startVirtualCycle(U32 milliseconds, U32 seconds);
+
 /**
  * \brief stop the simulated cycle started by startSimulatedCycle
  *
- * This stops the cycle started by startSimulatedCycle.
+ * This stops the cycle started by startSimulatedCycle or startVirtualCycle.
  */
 void stopSimulatedCycle();
 
@@ -22,11 +22,16 @@ namespace LedBlinker {
  * The topology autocoder requires an object that carries state with the name `LedBlinker::TopologyState`. Only the type
  * definition is required by the autocoder and the contents of this object are otherwise opaque to the autocoder. The
  * contents are entirely up to the definition of the project. This reference application specifies hostname and port
- * fields, which are derived by command line inputs.
+ * fields, which are derived by command line inputs, the teardown deadline in milliseconds (0 selects the default), and
+ * an optional file recording the led component's port invocations (nullptr disables recording), and whether the GPIO
+ * lines are simulated rather than driven.
  */
 struct TopologyState {
     const char* hostname;
     U32 port;
+    U32 teardownDeadline;
+    const char* recordFile;
+    bool simulateGpio;
 };
 
 /**
@@ -0,0 +1,130 @@
+####
+# PgoBuild.cmake:
+#
+# Script run by the LedBlinker_pgo target: `cmake -DPGO_SETTINGS=<build dir>/pgo-settings.cmake -P PgoBuild.cmake`.
+#
+# Builds the deployment with profile-guided and link-time optimization in the `pgo` directory of the calling build,
+# configured as that build (toolchain, settings and build options):
+#
+#   1. Measure the calling build's LedBlinkerBench as the baseline
+#   2. Configure with LEDBLINKER_PGO=GENERATE and LEDBLINKER_LTO=ON, build, and run LedBlinkerBench to train
+#   3. Reconfigure the same directory with LEDBLINKER_PGO=USE and rebuild. GCC names each profile after the object
+#      file, so training and optimization must share a build directory.
+#   4. Measure the optimized LedBlinkerBench and report binary size and cycle cost before and after
+#
+# Binaries built with a cross toolchain are run through LEDBLINKER_PGO_RUNNER, e.g. qemu-aarch64, which writes the
+# profiles straight to the host.
+####
+cmake_minimum_required(VERSION 3.14)
+include("${PGO_SETTINGS}")
+separate_arguments(PGO_RUNNER_COMMAND UNIX_COMMAND "${PGO_RUNNER}")
+
+# Run the benchmark, returning cycles per second and CPU microseconds per cycle
+function(pgo_bench BENCH LABEL CYCLES_PER_SECOND US_PER_CYCLE)
+    message(STATUS "[PGO] Running ${LABEL} benchmark: ${BENCH} -c ${PGO_TRAINING_CYCLES}")
+    execute_process(
+        COMMAND ${PGO_RUNNER_COMMAND} "${BENCH}" -c "${PGO_TRAINING_CYCLES}"
+        WORKING_DIRECTORY "${PGO_BUILD_DIR}"
+        RESULT_VARIABLE RESULT
+        OUTPUT_VARIABLE OUTPUT
+        ERROR_VARIABLE OUTPUT
+    )
+    if (NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "[PGO] ${LABEL} benchmark failed (${RESULT}):\n${OUTPUT}")
+    endif()
+    if (NOT OUTPUT MATCHES "\\[BENCH\\] cycles [0-9]+ in [0-9.]+ s: ([0-9]+) cycles/s")
+        message(FATAL_ERROR "[PGO] ${LABEL} benchmark reported no cycle rate:\n${OUTPUT}")
+    endif()
+    set(${CYCLES_PER_SECOND} "${CMAKE_MATCH_1}" PARENT_SCOPE)
+    if (NOT OUTPUT MATCHES "\\[BENCH\\] cpu [0-9.]+ s: ([0-9.]+) us/cycle")
+        message(FATAL_ERROR "[PGO] ${LABEL} benchmark reported no cycle cost:\n${OUTPUT}")
+    endif()
+    set(${US_PER_CYCLE} "${CMAKE_MATCH_1}" PARENT_SCOPE)
+endfunction()
+
+# Configure the sub-build for one profile-guided optimization phase
+function(pgo_configure PHASE)
+    execute_process(
+        COMMAND "${CMAKE_COMMAND}" -S "${PGO_SOURCE_DIR}" -B "${PGO_BUILD_DIR}" -G "${PGO_GENERATOR}"
+                ${PGO_CACHE_ARGS} "-DLEDBLINKER_PGO=${PHASE}" -DLEDBLINKER_LTO=ON
+                "-DLEDBLINKER_PGO_DIR=${PGO_PROFILE_DIR}"
+        RESULT_VARIABLE RESULT
+    )
+    if (NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "[PGO] Configuring ${PGO_BUILD_DIR} with LEDBLINKER_PGO=${PHASE} failed")
+    endif()
+endfunction()
+
+# Build the deployment and the benchmark in the sub-build
+function(pgo_build PHASE)
+    foreach(TARGET IN ITEMS LedBlinker LedBlinkerBench)
+        execute_process(COMMAND "${CMAKE_COMMAND}" --build "${PGO_BUILD_DIR}" --target "${TARGET}"
+                        RESULT_VARIABLE RESULT)
+        if (NOT RESULT EQUAL 0)
+            message(FATAL_ERROR "[PGO] Building ${TARGET} with LEDBLINKER_PGO=${PHASE} failed")
+        endif()
+    endforeach()
+endfunction()
+
+# Binary size as reported by `size` when the toolchain has it, file size otherwise
+function(pgo_size BINARY SIZE)
+    file(SIZE "${BINARY}" BYTES)
+    set(RESULT "${BYTES} bytes")
+    string(REGEX REPLACE "objcopy([^/]*)$" "size\\1" SIZE_TOOL "${PGO_OBJCOPY}")
+    if (PGO_OBJCOPY AND EXISTS "${SIZE_TOOL}")
+        execute_process(COMMAND "${SIZE_TOOL}" "${BINARY}" OUTPUT_VARIABLE OUTPUT RESULT_VARIABLE STATUS)
+        if ((STATUS EQUAL 0) AND (OUTPUT MATCHES "\n *([0-9]+)[ \t]+([0-9]+)[ \t]+([0-9]+)"))
+            set(RESULT "${BYTES} bytes, text ${CMAKE_MATCH_1} data ${CMAKE_MATCH_2} bss ${CMAKE_MATCH_3}")
+        endif()
+    endif()
+    set(${SIZE} "${RESULT}" PARENT_SCOPE)
+endfunction()
+
+# The sub-build places its binaries where the calling build does
+file(RELATIVE_PATH DEPLOYMENT_PATH "${PGO_BASELINE_DIR}" "${PGO_DEPLOYMENT}")
+file(RELATIVE_PATH BENCH_PATH "${PGO_BASELINE_DIR}" "${PGO_BENCH}")
+set(PGO_OPTIMIZED_DEPLOYMENT "${PGO_BUILD_DIR}/${DEPLOYMENT_PATH}")
+set(PGO_OPTIMIZED_BENCH "${PGO_BUILD_DIR}/${BENCH_PATH}")
+file(MAKE_DIRECTORY "${PGO_BUILD_DIR}")
+
+# 1. Baseline
+pgo_bench("${PGO_BENCH}" "baseline" BASELINE_RATE BASELINE_COST)
+pgo_size("${PGO_DEPLOYMENT}" BASELINE_SIZE)
+
+# 2. Instrument and train, starting from no profile so that stale counts are not merged in
+file(REMOVE_RECURSE "${PGO_PROFILE_DIR}")
+file(MAKE_DIRECTORY "${PGO_PROFILE_DIR}")
+pgo_configure(GENERATE)
+pgo_build(GENERATE)
+pgo_bench("${PGO_OPTIMIZED_BENCH}" "training" TRAINING_RATE TRAINING_COST)
+if (PGO_COMPILER_ID MATCHES "Clang")
+    get_filename_component(COMPILER_DIR "${PGO_COMPILER}" DIRECTORY)
+    find_program(PGO_PROFDATA NAMES llvm-profdata HINTS "${COMPILER_DIR}")
+    file(GLOB RAW_PROFILES "${PGO_PROFILE_DIR}/*.profraw")
+    if ((NOT PGO_PROFDATA) OR (NOT RAW_PROFILES))
+        message(FATAL_ERROR "[PGO] Merging the training profiles requires llvm-profdata and *.profraw files")
+    endif()
+    execute_process(COMMAND "${PGO_PROFDATA}" merge "-output=${PGO_PROFILE_DIR}/default.profdata" ${RAW_PROFILES}
+                    RESULT_VARIABLE RESULT)
+    if (NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "[PGO] Merging the training profiles failed")
+    endif()
+else()
+    file(GLOB_RECURSE PROFILES "${PGO_PROFILE_DIR}/*.gcda")
+    if (NOT PROFILES)
+        message(FATAL_ERROR "[PGO] Training wrote no profile to ${PGO_PROFILE_DIR}")
+    endif()
+endif()
+
+# 3. Optimize with the profiles
+pgo_configure(USE)
+pgo_build(USE)
+
+# 4. Measure and report
+pgo_bench("${PGO_OPTIMIZED_BENCH}" "optimized" OPTIMIZED_RATE OPTIMIZED_COST)
+pgo_size("${PGO_OPTIMIZED_DEPLOYMENT}" OPTIMIZED_SIZE)
+message(STATUS "[PGO] LedBlinker size: baseline ${BASELINE_SIZE}")
+message(STATUS "[PGO] LedBlinker size: optimized ${OPTIMIZED_SIZE}")
+message(STATUS "[PGO] Cycle cost: baseline ${BASELINE_COST} us/cycle at ${BASELINE_RATE} cycles/s")
+message(STATUS "[PGO] Cycle cost: optimized ${OPTIMIZED_COST} us/cycle at ${OPTIMIZED_RATE} cycles/s")
+message(STATUS "[PGO] Optimized deployment: ${PGO_OPTIMIZED_DEPLOYMENT}")
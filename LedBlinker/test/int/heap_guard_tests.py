@@ -0,0 +1,114 @@
+"""Heap allocation check for a running LedBlinker deployment
+
+Requires a deployment configured with -DLEDBLINKER_HEAP_GUARD=ON. Start the GDS and this test with the same
+HEAP_GUARD_LOG so the test can read the allocation trace written by the deployment, e.g.:
+
+    HEAP_GUARD_LOG=/tmp/heap_guard.log fprime-gds
+    HEAP_GUARD_LOG=/tmp/heap_guard.log pytest LedBlinker/test/int/heap_guard_tests.py
+
+The per-component report is written next to the log as heap_guard_report.txt.
+"""
+import os
+import re
+import tempfile
+import time
+from collections import Counter
+from pathlib import Path
+
+from fprime_gds.common.testing_fw import predicates
+
+# Namespaces whose classes are reported as components, in order of preference when attributing a stack trace
+COMPONENT_NAMESPACES = ["Components", "Svc", "Drv", "Fw", "Os"]
+
+# Matches the leading Namespace::Class of a mangled symbol, e.g. _ZN10Components3Led11run_handlerEij
+MANGLED_CLASS = re.compile(r"_ZN(?:K)?(\d+)(\w+)")
+
+
+def demangle_class(symbol):
+    """Return "Namespace::Class" for a mangled member function symbol, or None"""
+    match = MANGLED_CLASS.search(symbol)
+    if match is None:
+        return None
+    rest = match.group(1) + match.group(2)
+    names = []
+    for _ in range(2):
+        length = re.match(r"\d+", rest)
+        if length is None:
+            return None
+        start = len(length.group(0))
+        end = start + int(length.group(0))
+        names.append(rest[start:end])
+        rest = rest[end:]
+    return "::".join(names)
+
+
+def attribute(frames):
+    """Attribute one stack trace to the component most specific to it"""
+    classes = [demangle_class(frame) for frame in frames]
+    classes = [name for name in classes if name is not None and not name.startswith("Utils::HeapGuard")]
+    for namespace in COMPONENT_NAMESPACES:
+        for name in classes:
+            if name.startswith(namespace + "::"):
+                return name
+    return "unknown"
+
+
+def read_allocations(log_path, offset):
+    """Parse allocation records appended to the heap guard log after offset bytes"""
+    allocations = []
+    with open(log_path, "r", errors="replace") as log:
+        log.seek(offset)
+        frames = None
+        for line in log:
+            if line.startswith("ALLOC "):
+                frames = []
+            elif line.startswith("END") and frames is not None:
+                allocations.append(attribute(frames))
+                frames = None
+            elif frames is not None:
+                frames.append(line.strip())
+    return allocations
+
+
+def test_no_heap_after_init(fprime_test_api):
+    """Exercise blinking, telemetry, events and file transfer, then count allocations made while doing so"""
+    log_path = Path(os.environ.get("HEAP_GUARD_LOG", "heap_guard.log"))
+    assert log_path.exists(), f"{log_path} not found: is the deployment built with LEDBLINKER_HEAP_GUARD=ON?"
+    offset = log_path.stat().st_size
+
+    # Blinking, events and telemetry
+    blink_start_evr = fprime_test_api.get_event_pred("led.SetBlinkingState", ["ON"])
+    led_on_evr = fprime_test_api.get_event_pred("led.LedState", ["ON"])
+    led_off_evr = fprime_test_api.get_event_pred("led.LedState", ["OFF"])
+    fprime_test_api.send_and_assert_event(
+        "led.BLINKING_ON_OFF",
+        args=["ON"],
+        events=[blink_start_evr, led_on_evr, led_off_evr],
+        timeout=5,
+    )
+    fprime_test_api.assert_telemetry_count(predicates.greater_than(1), "led.LedTransitions", timeout=4)
+
+    # File uplink followed by downlink of the same file
+    with tempfile.TemporaryDirectory() as staging:
+        source = Path(staging) / "heap_guard_payload.bin"
+        source.write_bytes(os.urandom(8 * 1024))
+        fprime_test_api.uplink_file_and_await_completion(str(source), "/tmp/heap_guard_payload.bin", timeout=10)
+    fprime_test_api.send_and_assert_command(
+        "fileDownlink.SendFile", ["/tmp/heap_guard_payload.bin", "heap_guard_payload.bin"], timeout=10
+    )
+
+    blink_stop_evr = fprime_test_api.get_event_pred("led.SetBlinkingState", ["OFF"])
+    fprime_test_api.send_and_assert_event("led.BLINKING_ON_OFF", args=["OFF"], events=[blink_stop_evr])
+    time.sleep(1)  # Let in-flight telemetry and events drain through the framer
+
+    # Report allocations per component and fail on any
+    counts = Counter(read_allocations(log_path, offset))
+    report = log_path.parent / "heap_guard_report.txt"
+    with open(report, "w") as output:
+        output.write(f"{'Component':<40} {'Allocations':>12}\n")
+        for component, count in counts.most_common():
+            output.write(f"{component:<40} {count:>12}\n")
+            fprime_test_api.log(f"{component}: {count} allocations after init")
+    assert fprime_test_api.test_assert(
+        sum(counts.values()) == 0, f"Expected no heap allocations after init, see {report}", True
+    )
@@ -0,0 +1,136 @@
+// ======================================================================
+// \title  ArenaAllocator.cpp
+// \brief  cpp file for a bump allocator serving init-time allocations from one region
+// ======================================================================
+
+#include <Fw/Logger/Logger.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Utils/ArenaAllocator/ArenaAllocator.hpp>
+
+#include <sys/mman.h>
+
+namespace Utils {
+
+namespace {
+// Huge page size assumed when rounding a huge page backed region (x86_64 and aarch64 default)
+const NATIVE_UINT_TYPE HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+NATIVE_UINT_TYPE roundUp(NATIVE_UINT_TYPE value, NATIVE_UINT_TYPE multiple) {
+    return ((value + multiple - 1) / multiple) * multiple;
+}
+}  // namespace
+
+// ----------------------------------------------------------------------
+// Construction, initialization, and destruction
+// ----------------------------------------------------------------------
+
+ArenaAllocator ::ArenaAllocator()
+    : m_base(nullptr), m_capacity(0), m_used(0), m_requested(0), m_hugePages(false), m_locked(false) {}
+
+ArenaAllocator ::~ArenaAllocator() {
+    this->release();
+}
+
+bool ArenaAllocator ::reserve(NATIVE_UINT_TYPE size, bool hugePages, bool lockPages) {
+    FW_ASSERT(nullptr == this->m_base);
+    FW_ASSERT(size > 0);
+    void* base = MAP_FAILED;
+    NATIVE_UINT_TYPE capacity = size;
+
+    // Huge pages are frequently unavailable (none reserved by the kernel), so fall back to regular pages
+#ifdef MAP_HUGETLB
+    if (hugePages) {
+        capacity = roundUp(size, HUGE_PAGE_SIZE);
+        base = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE,
+                      -1, 0);
+        this->m_hugePages = (MAP_FAILED != base);
+    }
+#endif
+    if (MAP_FAILED == base) {
+        capacity = size;
+        base = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    }
+    if (MAP_FAILED == base) {
+        return false;
+    }
+
+    // Locking faults in every page now and keeps them resident. Failure (e.g. RLIMIT_MEMLOCK) is not fatal.
+    this->m_locked = lockPages && (0 == ::mlock(base, capacity));
+
+    this->m_base = static_cast<U8*>(base);
+    this->m_capacity = capacity;
+    this->m_used = 0;
+    this->m_requested = 0;
+    return true;
+}
+
+void ArenaAllocator ::release() {
+    if (nullptr != this->m_base) {
+        if (this->m_locked) {
+            (void)::munlock(this->m_base, this->m_capacity);
+        }
+        (void)::munmap(this->m_base, this->m_capacity);
+    }
+    this->m_base = nullptr;
+    this->m_capacity = 0;
+    this->m_used = 0;
+    this->m_requested = 0;
+    this->m_hugePages = false;
+    this->m_locked = false;
+}
+
+// ----------------------------------------------------------------------
+// Fw::MemAllocator implementation
+// ----------------------------------------------------------------------
+
+void* ArenaAllocator ::allocate(const NATIVE_UINT_TYPE identifier, NATIVE_UINT_TYPE& size, bool& recoverable) {
+    void* memory = nullptr;
+    recoverable = false;
+
+    this->m_lock.lock();
+    NATIVE_UINT_TYPE start = roundUp(this->m_used, ALIGNMENT);
+    if ((nullptr != this->m_base) && (start <= this->m_capacity) && (size <= (this->m_capacity - start))) {
+        memory = this->m_base + start;
+        this->m_used = start + size;
+        this->m_requested += size;
+    } else {
+        size = 0;
+    }
+    this->m_lock.unLock();
+    return memory;
+}
+
+void ArenaAllocator ::deallocate(const NATIVE_UINT_TYPE identifier, void* ptr) {
+    // Memory must have come from this region. It is reclaimed all at once by release.
+    FW_ASSERT((nullptr == ptr) ||
+              ((static_cast<U8*>(ptr) >= this->m_base) && (static_cast<U8*>(ptr) < (this->m_base + this->m_capacity))));
+}
+
+// ----------------------------------------------------------------------
+// Reporting
+// ----------------------------------------------------------------------
+
+void ArenaAllocator ::report() const {
+    Fw::Logger::logMsg("[ARENA] %u of %u bytes allocated (%u requested), huge pages: %s, locked: %s\n",
+                       this->m_used, this->m_capacity, this->m_requested,
+                       reinterpret_cast<POINTER_CAST>(this->m_hugePages ? "yes" : "no"),
+                       reinterpret_cast<POINTER_CAST>(this->m_locked ? "yes" : "no"));
+}
+
+NATIVE_UINT_TYPE ArenaAllocator ::getCapacity() const {
+    return this->m_capacity;
+}
+
+NATIVE_UINT_TYPE ArenaAllocator ::getUsed() const {
+    return this->m_used;
+}
+
+bool ArenaAllocator ::isHugePages() const {
+    return this->m_hugePages;
+}
+
+bool ArenaAllocator ::isLocked() const {
+    return this->m_locked;
+}
+
+}  // end namespace Utils
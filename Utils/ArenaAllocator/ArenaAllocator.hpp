@@ -0,0 +1,89 @@
+// ======================================================================
+// \title  ArenaAllocator.hpp
+// \brief  hpp file for a bump allocator serving init-time allocations from one region
+// ======================================================================
+
+#ifndef Utils_ArenaAllocator_HPP
+#define Utils_ArenaAllocator_HPP
+
+#include <FpConfig.hpp>
+#include <Fw/Types/MemAllocator.hpp>
+#include <Os/Mutex.hpp>
+
+namespace Utils {
+
+//! \class ArenaAllocator
+//! \brief Fw::MemAllocator carving allocations out of a single contiguous region
+//!
+//! The region is mapped once by reserve(), optionally backed by huge pages and locked into memory so that no page
+//! fault occurs when it is later touched. Allocations bump a pointer through the region and deallocate() does not
+//! return memory: the whole region is unmapped by release(). It is intended for memory allocated once during topology
+//! setup and held until teardown, and may be passed anywhere an Fw::MallocAllocator is accepted.
+class ArenaAllocator : public Fw::MemAllocator {
+  public:
+    //! Alignment of every allocation returned
+    static const NATIVE_UINT_TYPE ALIGNMENT = 16;
+
+    //! Construct object ArenaAllocator. No memory is reserved until reserve is called.
+    //!
+    ArenaAllocator();
+
+    //! Destroy object ArenaAllocator, releasing the region
+    //!
+    virtual ~ArenaAllocator();
+
+    //! Map the region backing all allocations. The region is prefaulted on mapping.
+    //!
+    //! \return true when the region was mapped, false otherwise
+    bool reserve(NATIVE_UINT_TYPE size, /*!< Size of the region in bytes*/
+                 bool hugePages,        /*!< Attempt to back the region with huge pages*/
+                 bool lockPages         /*!< Attempt to lock the region into memory*/
+    );
+
+    //! Unmap the region. Any memory previously allocated becomes invalid.
+    //!
+    void release();
+
+    //! Allocate memory from the region
+    //!
+    //! \return pointer to memory, or nullptr with size set to 0 when the region is exhausted
+    void* allocate(const NATIVE_UINT_TYPE identifier, /*!< Identifier of the requesting component*/
+                   NATIVE_UINT_TYPE& size,            /*!< In: requested size. Out: size allocated*/
+                   bool& recoverable                  /*!< Out: whether memory survives a reset, always false*/
+                   ) override;
+
+    //! Deallocate memory. Memory is only returned to the system by release.
+    //!
+    void deallocate(const NATIVE_UINT_TYPE identifier, /*!< Identifier of the requesting component*/
+                    void* ptr                          /*!< Pointer previously returned by allocate*/
+                    ) override;
+
+    //! Log the region size, the bytes allocated, and how the region is backed
+    //!
+    void report() const;
+
+    //! \return size of the region in bytes
+    NATIVE_UINT_TYPE getCapacity() const;
+
+    //! \return bytes allocated from the region, including alignment padding
+    NATIVE_UINT_TYPE getUsed() const;
+
+    //! \return true when the region is backed by huge pages
+    bool isHugePages() const;
+
+    //! \return true when the region is locked into memory
+    bool isLocked() const;
+
+  PRIVATE:
+    Os::Mutex m_lock;              //!< Protects allocation from concurrent configuration steps
+    U8* m_base;                    //!< Start of the region, nullptr when not reserved
+    NATIVE_UINT_TYPE m_capacity;   //!< Size of the region in bytes
+    NATIVE_UINT_TYPE m_used;       //!< Offset of the next allocation
+    NATIVE_UINT_TYPE m_requested;  //!< Bytes requested by callers, excluding padding
+    bool m_hugePages;              //!< Region is backed by huge pages
+    bool m_locked;                 //!< Region is locked into memory
+};
+
+}  // end namespace Utils
+
+#endif
@@ -0,0 +1,67 @@
+// ----------------------------------------------------------------------
+// ArenaAllocatorTest.cpp
+// ----------------------------------------------------------------------
+
+#include <Utils/ArenaAllocator/ArenaAllocator.hpp>
+
+#include <gtest/gtest.h>
+#include <cstring>
+
+TEST(Nominal, AllocationsAreAlignedAndContiguous) {
+    Utils::ArenaAllocator arena;
+    ASSERT_TRUE(arena.reserve(4096, false, false));
+    ASSERT_EQ(arena.getCapacity(), 4096u);
+
+    bool recoverable = true;
+    NATIVE_UINT_TYPE size = 10;
+    U8* first = static_cast<U8*>(arena.allocate(0, size, recoverable));
+    ASSERT_NE(first, nullptr);
+    ASSERT_EQ(size, 10u);
+    ASSERT_FALSE(recoverable);
+
+    size = 100;
+    U8* second = static_cast<U8*>(arena.allocate(1, size, recoverable));
+    ASSERT_NE(second, nullptr);
+    ASSERT_EQ(reinterpret_cast<POINTER_CAST>(second) % Utils::ArenaAllocator::ALIGNMENT, 0u);
+    ASSERT_EQ(second, first + Utils::ArenaAllocator::ALIGNMENT);
+    ASSERT_EQ(arena.getUsed(), Utils::ArenaAllocator::ALIGNMENT + 100);
+
+    // Memory is writable across its full extent
+    memset(second, 0xA5, size);
+    arena.deallocate(1, second);
+    arena.deallocate(0, first);
+}
+
+TEST(OffNominal, ExhaustedArenaReturnsNull) {
+    Utils::ArenaAllocator arena;
+    ASSERT_TRUE(arena.reserve(4096, false, false));
+
+    bool recoverable = false;
+    NATIVE_UINT_TYPE size = 4096;
+    ASSERT_NE(arena.allocate(0, size, recoverable), nullptr);
+    size = 1;
+    ASSERT_EQ(arena.allocate(0, size, recoverable), nullptr);
+    ASSERT_EQ(size, 0u);
+}
+
+TEST(OffNominal, UnreservedArenaReturnsNull) {
+    Utils::ArenaAllocator arena;
+    bool recoverable = false;
+    NATIVE_UINT_TYPE size = 1;
+    ASSERT_EQ(arena.allocate(0, size, recoverable), nullptr);
+    ASSERT_EQ(size, 0u);
+}
+
+TEST(Nominal, HugePageRequestFallsBack) {
+    // Whether or not huge pages are available, the reservation succeeds and covers the requested size
+    Utils::ArenaAllocator arena;
+    ASSERT_TRUE(arena.reserve(8192, true, true));
+    ASSERT_GE(arena.getCapacity(), 8192u);
+    arena.release();
+    ASSERT_EQ(arena.getCapacity(), 0u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
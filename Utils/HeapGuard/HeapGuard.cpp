@@ -0,0 +1,157 @@
+// ======================================================================
+// \title  HeapGuard.cpp
+// \brief  cpp file for tracing heap allocations made after topology setup
+// ======================================================================
+
+#include <Utils/HeapGuard/HeapGuard.hpp>
+
+#include <atomic>
+
+#if LEDBLINKER_HEAP_GUARD
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// glibc entry points of the allocator being interposed
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+}
+#endif
+
+namespace Utils {
+namespace HeapGuard {
+
+namespace {
+std::atomic<bool> s_armed(false);
+std::atomic<U32> s_count(0);
+
+#if LEDBLINKER_HEAP_GUARD
+// Maximum stack depth recorded for each allocation
+const int MAX_FRAMES = 32;
+
+// State below is used from within the allocator, so it avoids any type (e.g. Os::Mutex) that allocates itself
+int s_fd = -1;
+bool s_abort = false;
+pthread_mutex_t s_logLock = PTHREAD_MUTEX_INITIALIZER;
+thread_local bool t_inGuard = false;
+
+void writeAll(const char* data, size_t length) {
+    ssize_t written = ::write(s_fd, data, length);
+    (void)written;
+}
+
+void recordAllocation(size_t size) {
+    // Allocations made while recording (e.g. by backtrace) are not themselves recorded
+    if (!s_armed.load(std::memory_order_relaxed) || t_inGuard) {
+        return;
+    }
+    t_inGuard = true;
+    U32 sequence = s_count.fetch_add(1) + 1;
+    if (s_fd >= 0) {
+        void* frames[MAX_FRAMES];
+        int depth = ::backtrace(frames, MAX_FRAMES);
+        char thread[16] = "?";
+        (void)pthread_getname_np(pthread_self(), thread, sizeof(thread));
+        char header[64];
+        int length = snprintf(header, sizeof(header), "ALLOC %u %zu %s\n", sequence, size, thread);
+
+        (void)pthread_mutex_lock(&s_logLock);
+        writeAll(header, static_cast<size_t>(length));
+        ::backtrace_symbols_fd(frames, depth, s_fd);
+        writeAll("END\n", 4);
+        (void)pthread_mutex_unlock(&s_logLock);
+    }
+    if (s_abort) {
+        ::abort();
+    }
+    t_inGuard = false;
+}
+#endif
+}  // namespace
+
+void arm() {
+#if LEDBLINKER_HEAP_GUARD
+    const char* mode = ::getenv("HEAP_GUARD_MODE");
+    s_abort = (nullptr != mode) && (0 == ::strcmp(mode, "abort"));
+    const char* path = ::getenv("HEAP_GUARD_LOG");
+    path = (nullptr != path) ? path : "heap_guard.log";
+    if (s_fd < 0) {
+        s_fd = ::open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    }
+    // The first backtrace loads the unwinder, which allocates. Do so before arming.
+    void* frames[1];
+    (void)::backtrace(frames, 1);
+#endif
+    s_armed = true;
+}
+
+void disarm() {
+    s_armed = false;
+}
+
+bool isEnabled() {
+#if LEDBLINKER_HEAP_GUARD
+    return true;
+#else
+    return false;
+#endif
+}
+
+U32 getAllocationCount() {
+    return s_count.load();
+}
+
+}  // end namespace HeapGuard
+}  // end namespace Utils
+
+#if LEDBLINKER_HEAP_GUARD
+// ----------------------------------------------------------------------
+// Allocator interposition
+// ----------------------------------------------------------------------
+
+extern "C" {
+
+void* malloc(size_t size) {
+    Utils::HeapGuard::recordAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    Utils::HeapGuard::recordAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    Utils::HeapGuard::recordAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    Utils::HeapGuard::recordAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    Utils::HeapGuard::recordAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+    Utils::HeapGuard::recordAllocation(size);
+    void* memory = __libc_memalign(alignment, size);
+    if (nullptr == memory) {
+        return ENOMEM;
+    }
+    *ptr = memory;
+    return 0;
+}
+}
+#endif
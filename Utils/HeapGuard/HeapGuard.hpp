@@ -0,0 +1,39 @@
+// ======================================================================
+// \title  HeapGuard.hpp
+// \brief  hpp file for tracing heap allocations made after topology setup
+// ======================================================================
+
+#ifndef Utils_HeapGuard_HPP
+#define Utils_HeapGuard_HPP
+
+#include <FpConfig.hpp>
+
+namespace Utils {
+
+//! \namespace HeapGuard
+//! \brief Detects heap allocations made once the topology is running
+//!
+//! When built with LEDBLINKER_HEAP_GUARD defined, malloc, calloc, realloc and the aligned allocation functions are
+//! interposed. Once armed, every allocation appends a record with the requesting thread and a stack trace to the file
+//! named by the HEAP_GUARD_LOG environment variable (default: heap_guard.log). Setting HEAP_GUARD_MODE=abort aborts
+//! the process on the first such allocation instead. Without LEDBLINKER_HEAP_GUARD these functions do nothing.
+namespace HeapGuard {
+
+//! Start tracing allocations. Called once setup has completed.
+//!
+void arm();
+
+//! Stop tracing allocations. Called before teardown, which is allowed to allocate.
+//!
+void disarm();
+
+//! \return true when the allocator is interposed in this build
+bool isEnabled();
+
+//! \return number of allocations observed while armed
+U32 getAllocationCount();
+
+}  // end namespace HeapGuard
+}  // end namespace Utils
+
+#endif
@@ -0,0 +1,354 @@
+// ======================================================================
+// \title  MutexProfile.cpp
+// \brief  cpp file for mutexes recording acquisitions, contention, wait time and hold time per name
+// ======================================================================
+
+#include <Utils/MutexProfile/MutexProfile.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Os/File.hpp>
+
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+#if LEDBLINKER_MUTEX_PROFILE
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <cstdlib>
+#endif
+
+// Resolved to the pthread functions when the link wraps them (see CMakeLists.txt), and left null otherwise
+extern "C" {
+int __real_pthread_mutex_lock(pthread_mutex_t* mutex) __attribute__((weak));
+int __real_pthread_mutex_unlock(pthread_mutex_t* mutex) __attribute__((weak));
+}
+
+namespace Utils {
+namespace MutexProfile {
+
+struct Counters {
+    const char* name;
+    std::atomic<U64> acquisitions;
+    std::atomic<U64> contended;
+    std::atomic<U64> waitNs;
+    std::atomic<U64> maxWaitNs;
+    std::atomic<U64> holdNs;
+    std::atomic<U64> maxHoldNs;
+};
+
+namespace {
+
+// Constant initialized, so mutexes constructed during static initialization may claim entries in any order
+Counters table[MAX_MUTEXES];
+std::atomic<U32> tableCount(0);
+pthread_mutex_t tableLock = PTHREAD_MUTEX_INITIALIZER;
+
+//! Lock a mutex without counting it, whether or not the link wraps the pthread functions
+int lockUncounted(pthread_mutex_t* mutex) {
+    return (__real_pthread_mutex_lock != nullptr) ? __real_pthread_mutex_lock(mutex) : pthread_mutex_lock(mutex);
+}
+
+//! Unlock a mutex without counting it, whether or not the link wraps the pthread functions
+int unlockUncounted(pthread_mutex_t* mutex) {
+    return (__real_pthread_mutex_unlock != nullptr) ? __real_pthread_mutex_unlock(mutex) : pthread_mutex_unlock(mutex);
+}
+
+//! Monotonic time in nanoseconds
+U64 monotonicNs() {
+    struct timespec now;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (static_cast<U64>(now.tv_sec) * 1000000000) + static_cast<U64>(now.tv_nsec);
+}
+
+//! Raise a maximum held by several threads
+void raise(std::atomic<U64>& maximum, U64 value) {
+    U64 current = maximum.load(std::memory_order_relaxed);
+    while ((value > current) && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+//! Counters of a name, claimed on first use. nullptr once the table is full.
+Counters* claim(const char* name) {
+    Counters* counters = nullptr;
+    (void)lockUncounted(&tableLock);
+    const U32 count = tableCount.load(std::memory_order_relaxed);
+    for (U32 i = 0; (i < count) && (counters == nullptr); i++) {
+        if (strcmp(table[i].name, name) == 0) {
+            counters = &table[i];
+        }
+    }
+    if ((counters == nullptr) && (count < MAX_MUTEXES)) {
+        counters = &table[count];
+        counters->name = name;
+        tableCount.store(count + 1, std::memory_order_release);
+    }
+    (void)unlockUncounted(&tableLock);
+    return counters;
+}
+
+//! Lock a mutex, counting the acquisition and timing the wait when it is held. Uncounted when counters is nullptr.
+//!
+//! \return status of the lock
+int acquire(pthread_mutex_t* mutex, Counters* counters, U64& lockedAt) {
+    if (pthread_mutex_trylock(mutex) == 0) {
+        lockedAt = monotonicNs();
+    } else {
+        const U64 start = monotonicNs();
+        const int status = lockUncounted(mutex);
+        if (status != 0) {
+            return status;
+        }
+        lockedAt = monotonicNs();
+        if (counters != nullptr) {
+            const U64 wait = lockedAt - start;
+            counters->contended.fetch_add(1, std::memory_order_relaxed);
+            counters->waitNs.fetch_add(wait, std::memory_order_relaxed);
+            raise(counters->maxWaitNs, wait);
+        }
+    }
+    if (counters != nullptr) {
+        counters->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+    return 0;
+}
+
+//! Unlock a mutex, counting the time it was held since lockedAt. Uncounted when counters is nullptr.
+//!
+//! \return status of the unlock
+int release(pthread_mutex_t* mutex, Counters* counters, U64 lockedAt) {
+    if (counters != nullptr) {
+        const U64 hold = monotonicNs() - lockedAt;
+        counters->holdNs.fetch_add(hold, std::memory_order_relaxed);
+        raise(counters->maxHoldNs, hold);
+    }
+    return unlockUncounted(mutex);
+}
+
+#if LEDBLINKER_MUTEX_PROFILE
+//! Mutexes the wrapped pthread functions can tell apart, Os::Mutex and F´ queues included
+const U32 MUTEX_SLOTS = 1024;
+//! Call stack frames searched for the function naming a mutex
+const int NAME_FRAMES = 12;
+
+//! A mutex seen by the wrapped pthread functions
+struct Slot {
+    std::atomic<uintptr_t> mutex;     //!< Address of the mutex, 0 while the slot is free
+    std::atomic<Counters*> counters;  //!< Counters of its name, nullptr until named or when the table is full
+    U64 lockedAt;                     //!< Time of the current acquisition. Only the holder reads and writes it.
+};
+
+// Constant initialized, as mutexes are locked during static initialization
+Slot slots[MUTEX_SLOTS];
+//! Set while a mutex is being named, so that locks taken to name it are not counted
+thread_local bool t_naming = false;
+
+//! \return true when a symbol belongs to the mutex layers between a caller and pthread: Os::Mutex and Os::ScopeLock
+bool isMutexLayer(const char* symbol) {
+    return (strncmp(symbol, "_ZN2Os5Mutex", strlen("_ZN2Os5Mutex")) == 0) ||
+           (strncmp(symbol, "_ZN2Os9ScopeLock", strlen("_ZN2Os9ScopeLock")) == 0);
+}
+
+//! Name of a mutex locked for the first time: the function that locked it, without its parameters. Resolving needs the
+//! symbols exported, which CMakeLists.txt does.
+//!
+//! \return the name, allocated with malloc, or nullptr when unresolved
+char* callerName() {
+    void* frames[NAME_FRAMES];
+    const int depth = ::backtrace(frames, NAME_FRAMES);
+    // Each line reads "binary(symbol+offset) [address]", with an empty symbol when it is not exported
+    char** lines = ::backtrace_symbols(frames, depth);
+    if (lines == nullptr) {
+        return nullptr;
+    }
+    char* name = nullptr;
+    bool pastWrap = false;
+    for (int i = 0; (i < depth) && (name == nullptr); i++) {
+        char* symbol = strchr(lines[i], '(');
+        if ((symbol == nullptr) || (*(++symbol) == '+') || (*symbol == ')')) {
+            continue;
+        }
+        symbol[strcspn(symbol, "+)")] = '\0';
+        if (!pastWrap) {
+            pastWrap = (strcmp(symbol, "__wrap_pthread_mutex_lock") == 0);
+            continue;
+        }
+        if (isMutexLayer(symbol)) {
+            continue;
+        }
+        int status = 0;
+        name = abi::__cxa_demangle(symbol, nullptr, nullptr, &status);
+        if ((status != 0) || (name == nullptr)) {
+            name = strdup(symbol);
+        } else {
+            name[strcspn(name, "(")] = '\0';
+        }
+    }
+    free(lines);
+    return name;
+}
+
+//! Slot of a mutex, claimed and named on its first lock when add is true
+//!
+//! \return the slot, or nullptr when the mutex is not counted
+Slot* findSlot(pthread_mutex_t* mutex, bool add) {
+    if (t_naming) {
+        return nullptr;
+    }
+    const uintptr_t key = reinterpret_cast<uintptr_t>(mutex);
+    const U32 start = static_cast<U32>((key >> 4) * 2654435761u) % MUTEX_SLOTS;
+    for (U32 probe = 0; probe < MUTEX_SLOTS; probe++) {
+        Slot& slot = slots[(start + probe) % MUTEX_SLOTS];
+        uintptr_t current = slot.mutex.load(std::memory_order_acquire);
+        if (current == key) {
+            return &slot;
+        }
+        if (current != 0) {
+            continue;
+        }
+        if (!add) {
+            return nullptr;
+        }
+        if (!slot.mutex.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+            // Claimed by another mutex first, or by this one on another thread
+            if (current == key) {
+                return &slot;
+            }
+            continue;
+        }
+        t_naming = true;
+        char* resolved = callerName();
+        Counters* counters = claim((resolved != nullptr) ? resolved : "unresolved");
+        if ((resolved != nullptr) && ((counters == nullptr) || (counters->name != resolved))) {
+            // The name was claimed before, by a mutex locked from the same function, or the table is full
+            free(resolved);
+        }
+        t_naming = false;
+        slot.counters.store(counters, std::memory_order_release);
+        return &slot;
+    }
+    return nullptr;
+}
+#endif
+
+}  // namespace
+
+bool isEnabled() {
+#if LEDBLINKER_MUTEX_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+U32 getCount() {
+    return tableCount.load(std::memory_order_acquire);
+}
+
+bool getStats(U32 index, Stats& stats) {
+    if (index >= getCount()) {
+        return false;
+    }
+    const Counters& counters = table[index];
+    stats.name = counters.name;
+    stats.acquisitions = counters.acquisitions.load(std::memory_order_relaxed);
+    stats.contended = counters.contended.load(std::memory_order_relaxed);
+    stats.waitNs = counters.waitNs.load(std::memory_order_relaxed);
+    stats.maxWaitNs = counters.maxWaitNs.load(std::memory_order_relaxed);
+    stats.holdNs = counters.holdNs.load(std::memory_order_relaxed);
+    stats.maxHoldNs = counters.maxHoldNs.load(std::memory_order_relaxed);
+    return true;
+}
+
+bool dump(const char* fileName, U32& mutexes) {
+    mutexes = 0;
+    Stats rows[MAX_MUTEXES];
+    const U32 count = getCount();
+    for (U32 i = 0; i < count; i++) {
+        (void)getStats(i, rows[i]);
+    }
+    std::sort(rows, rows + count, [](const Stats& a, const Stats& b) { return a.waitNs > b.waitNs; });
+
+    Os::File file;
+    if (Os::File::OP_OK != file.open(fileName, Os::File::OPEN_WRITE)) {
+        return false;
+    }
+    char row[512];
+    NATIVE_INT_TYPE length =
+        snprintf(row, sizeof(row), "name,acquisitions,contended,wait_us,max_wait_us,hold_us,max_hold_us\n");
+    bool ok = (Os::File::OP_OK == file.write(row, length));
+    for (U32 i = 0; ok && (i < count); i++) {
+        const Stats& stats = rows[i];
+        length = snprintf(row, sizeof(row), "%s,%llu,%llu,%llu,%llu,%llu,%llu\n", stats.name,
+                          static_cast<unsigned long long>(stats.acquisitions),
+                          static_cast<unsigned long long>(stats.contended),
+                          static_cast<unsigned long long>(stats.waitNs / 1000),
+                          static_cast<unsigned long long>(stats.maxWaitNs / 1000),
+                          static_cast<unsigned long long>(stats.holdNs / 1000),
+                          static_cast<unsigned long long>(stats.maxHoldNs / 1000));
+        // A name too long for the row is cut, with the rest of the row
+        length = std::min(length, static_cast<NATIVE_INT_TYPE>(sizeof(row) - 1));
+        ok = (length > 0) && (Os::File::OP_OK == file.write(row, length));
+        mutexes += ok ? 1 : 0;
+    }
+    file.close();
+    return ok;
+}
+
+}  // end namespace MutexProfile
+
+ProfiledMutex::ProfiledMutex(const char* name) : m_counters(MutexProfile::claim(name)), m_lockedAt(0) {
+    FW_ASSERT(name != nullptr);
+    const int status = pthread_mutex_init(&this->m_mutex, nullptr);
+    FW_ASSERT(status == 0, status);
+}
+
+ProfiledMutex::~ProfiledMutex() {
+    (void)pthread_mutex_destroy(&this->m_mutex);
+}
+
+void ProfiledMutex::lock() {
+    U64 lockedAt = 0;
+    const int status = MutexProfile::acquire(&this->m_mutex, this->m_counters, lockedAt);
+    FW_ASSERT(status == 0, status);
+    this->m_lockedAt = lockedAt;
+}
+
+void ProfiledMutex::unLock() {
+    const int status = MutexProfile::release(&this->m_mutex, this->m_counters, this->m_lockedAt);
+    FW_ASSERT(status == 0, status);
+}
+
+}  // end namespace Utils
+
+#if LEDBLINKER_MUTEX_PROFILE
+// ----------------------------------------------------------------------
+// pthread mutex interposition, linked with --wrap so that every Os::Mutex and queue lock is counted
+// ----------------------------------------------------------------------
+
+extern "C" {
+
+int __wrap_pthread_mutex_lock(pthread_mutex_t* mutex) {
+    Utils::MutexProfile::Slot* slot = Utils::MutexProfile::findSlot(mutex, true);
+    if (slot == nullptr) {
+        return Utils::MutexProfile::lockUncounted(mutex);
+    }
+    U64 lockedAt = 0;
+    const int status =
+        Utils::MutexProfile::acquire(mutex, slot->counters.load(std::memory_order_acquire), lockedAt);
+    if (status == 0) {
+        slot->lockedAt = lockedAt;
+    }
+    return status;
+}
+
+int __wrap_pthread_mutex_unlock(pthread_mutex_t* mutex) {
+    Utils::MutexProfile::Slot* slot = Utils::MutexProfile::findSlot(mutex, false);
+    if (slot == nullptr) {
+        return Utils::MutexProfile::unlockUncounted(mutex);
+    }
+    return Utils::MutexProfile::release(mutex, slot->counters.load(std::memory_order_acquire), slot->lockedAt);
+}
+}
+#endif
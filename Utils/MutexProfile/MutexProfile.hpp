@@ -0,0 +1,112 @@
+// ======================================================================
+// \title  MutexProfile.hpp
+// \brief  hpp file for mutexes recording acquisitions, contention, wait time and hold time per name
+// ======================================================================
+
+#ifndef Utils_MutexProfile_HPP
+#define Utils_MutexProfile_HPP
+
+#include <FpConfig.hpp>
+#include <Os/Mutex.hpp>
+
+#include <pthread.h>
+
+namespace Utils {
+
+//! \namespace MutexProfile
+//! \brief Contention statistics of every profiled mutex, aggregated by mutex name
+//!
+//! Mutexes sharing a name, such as the lock of each instance of a component, add to the same entry. Entries are
+//! claimed from a fixed table when a mutex is constructed; mutexes constructed once the table is full still lock but
+//! are not counted.
+//!
+//! Builds configured with LEDBLINKER_MUTEX_PROFILE also wrap pthread_mutex_lock and pthread_mutex_unlock at link time,
+//! so that every other mutex of the program is counted, each Os::Mutex and F´ queue lock included. Such a mutex is
+//! named on its first lock after the function that locked it, skipping Os::Mutex and Os::ScopeLock.
+namespace MutexProfile {
+
+//! Names that may be profiled
+static const U32 MAX_MUTEXES = 64;
+
+//! Statistics of the mutexes sharing one name
+struct Stats {
+    const char* name;   //!< Name of the mutexes
+    U64 acquisitions;   //!< Times a mutex was locked
+    U64 contended;      //!< Acquisitions that found the mutex held and waited
+    U64 waitNs;         //!< Total time waited to lock, in nanoseconds
+    U64 maxWaitNs;      //!< Longest wait to lock, in nanoseconds
+    U64 holdNs;         //!< Total time held, in nanoseconds
+    U64 maxHoldNs;      //!< Longest time held, in nanoseconds
+};
+
+//! Counters of one name, updated by the mutexes sharing it
+struct Counters;
+
+//! \return true when the mutexes of this build are profiled
+bool isEnabled();
+
+//! \return number of names profiled so far
+U32 getCount();
+
+//! Read the statistics of one name. Counters are read one at a time while mutexes keep being used, so a snapshot
+//! may be off by the acquisitions in flight.
+//!
+//! \return true when index names a profiled mutex
+bool getStats(U32 index,   /*!< Index of the name, below getCount()*/
+              Stats& stats /*!< Out: statistics of the name*/
+);
+
+//! Write the statistics of every name to a CSV file, most waited on first
+//!
+//! \return true when the file was written
+bool dump(const char* fileName, /*!< Path of the file written*/
+          U32& mutexes          /*!< Out: number of names written*/
+);
+
+}  // end namespace MutexProfile
+
+//! \class ProfiledMutex
+//! \brief Mutex counting its acquisitions, contended acquisitions, wait time and hold time under a name
+//!
+//! An acquisition is contended when a try-lock fails, after which the wait for the mutex is timed. Hold time runs
+//! from acquisition to unLock. Counting costs two clock reads per uncontended acquisition.
+class ProfiledMutex {
+  public:
+    explicit ProfiledMutex(const char* name /*!< Name of the mutex. Must outlive the mutex, e.g. a string literal.*/
+    );
+
+    ~ProfiledMutex();
+
+    //! Lock the mutex, counting the acquisition
+    void lock();
+
+    //! Unlock the mutex, counting the time it was held
+    void unLock();
+
+  PRIVATE:
+    ProfiledMutex(const ProfiledMutex&);
+    ProfiledMutex& operator=(const ProfiledMutex&);
+
+    pthread_mutex_t m_mutex;             //!< Mutex locked
+    MutexProfile::Counters* m_counters;  //!< Counters of the name, or nullptr when the table is full
+    U64 m_lockedAt;                      //!< Time of the current acquisition. Only the holder reads and writes it.
+};
+
+//! \class NamedMutex
+//! \brief Mutex of repo code that is profiled in builds configured with LEDBLINKER_MUTEX_PROFILE and is otherwise an
+//! Os::Mutex whose name is ignored
+#if LEDBLINKER_MUTEX_PROFILE
+class NamedMutex : public ProfiledMutex {
+  public:
+    explicit NamedMutex(const char* name) : ProfiledMutex(name) {}
+};
+#else
+class NamedMutex : public Os::Mutex {
+  public:
+    explicit NamedMutex(const char* name) { static_cast<void>(name); }
+};
+#endif
+
+}  // end namespace Utils
+
+#endif
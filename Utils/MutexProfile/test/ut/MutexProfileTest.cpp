@@ -0,0 +1,140 @@
+// ----------------------------------------------------------------------
+// MutexProfileTest.cpp
+// ----------------------------------------------------------------------
+
+#include <Utils/MutexProfile/MutexProfile.hpp>
+#include <Utils/TestFile/TestFile.hpp>
+#include <Os/Mutex.hpp>
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace {
+//! Statistics of a profiled name, failing the test when it is absent
+Utils::MutexProfile::Stats find(const char* name) {
+    Utils::MutexProfile::Stats stats = {};
+    for (U32 i = 0; i < Utils::MutexProfile::getCount(); i++) {
+        if (Utils::MutexProfile::getStats(i, stats) && (strcmp(stats.name, name) == 0)) {
+            return stats;
+        }
+    }
+    ADD_FAILURE() << "no statistics for " << name;
+    return Utils::MutexProfile::Stats();
+}
+}  // namespace
+
+//! Lock and unlock an Os::Mutex. Exported and not inlined, so that its name is the one the mutex is counted under.
+__attribute__((noinline)) void lockOsMutex(Os::Mutex& mutex) {
+    mutex.lock();
+    mutex.unLock();
+}
+
+TEST(Nominal, UncontendedAcquisitions) {
+    Utils::ProfiledMutex mutex("test.uncontended");
+    for (U32 i = 0; i < 100; i++) {
+        mutex.lock();
+        mutex.unLock();
+    }
+    const Utils::MutexProfile::Stats stats = find("test.uncontended");
+    ASSERT_EQ(stats.acquisitions, 100u);
+    ASSERT_EQ(stats.contended, 0u);
+    ASSERT_EQ(stats.waitNs, 0u);
+}
+
+TEST(Nominal, ContendedWaitAndHold) {
+    Utils::ProfiledMutex mutex("test.contended");
+    std::atomic<bool> held(false);
+    std::thread holder([&]() {
+        mutex.lock();
+        held.store(true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        mutex.unLock();
+    });
+    while (!held.load()) {
+        std::this_thread::yield();
+    }
+    mutex.lock();
+    mutex.unLock();
+    holder.join();
+
+    const Utils::MutexProfile::Stats stats = find("test.contended");
+    ASSERT_EQ(stats.acquisitions, 2u);
+    ASSERT_EQ(stats.contended, 1u);
+    ASSERT_GE(stats.maxWaitNs, 10000000u);
+    ASSERT_GE(stats.maxHoldNs, 10000000u);
+    ASSERT_GE(stats.holdNs, stats.maxHoldNs);
+}
+
+TEST(Nominal, SharedNameAggregates) {
+    Utils::ProfiledMutex first("test.shared");
+    Utils::ProfiledMutex second("test.shared");
+    const U32 count = Utils::MutexProfile::getCount();
+    Utils::ProfiledMutex third("test.shared");
+    ASSERT_EQ(Utils::MutexProfile::getCount(), count);
+    first.lock();
+    first.unLock();
+    second.lock();
+    second.unLock();
+    ASSERT_EQ(find("test.shared").acquisitions, 2u);
+}
+
+TEST(Nominal, DumpMostWaitedFirst) {
+    Utils::ProfiledMutex mutex("test.dump");
+    mutex.lock();
+    mutex.unLock();
+
+    const Utils::TestFile dumpFile("MutexProfile.csv");
+
+    const char* const dump = dumpFile.get();
+    U32 mutexes = 0;
+    ASSERT_TRUE(Utils::MutexProfile::dump(dump, mutexes));
+    ASSERT_EQ(mutexes, Utils::MutexProfile::getCount());
+    FILE* file = fopen(dump, "r");
+    ASSERT_NE(file, nullptr);
+    char line[200] = {};
+    ASSERT_NE(fgets(line, sizeof(line), file), nullptr);
+    ASSERT_STREQ(line, "name,acquisitions,contended,wait_us,max_wait_us,hold_us,max_hold_us\n");
+    U32 rows = 0;
+    bool found = false;
+    unsigned long long previous = ~0ULL;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        char name[64] = {};
+        unsigned long long acquisitions = 0;
+        unsigned long long contended = 0;
+        unsigned long long wait = 0;
+        ASSERT_EQ(sscanf(line, "%63[^,],%llu,%llu,%llu", name, &acquisitions, &contended, &wait), 4);
+        ASSERT_LE(wait, previous);
+        previous = wait;
+        found = found || (strcmp(name, "test.dump") == 0);
+        rows++;
+    }
+    (void)fclose(file);
+    ASSERT_EQ(rows, mutexes);
+    ASSERT_TRUE(found);
+}
+
+TEST(Nominal, OsMutexNamedByCaller) {
+    // Only builds configured with LEDBLINKER_MUTEX_PROFILE wrap the pthread functions
+    if (!Utils::MutexProfile::isEnabled()) {
+        return;
+    }
+    Os::Mutex mutex;
+    for (U32 i = 0; i < 3; i++) {
+        lockOsMutex(mutex);
+    }
+    ASSERT_EQ(find("lockOsMutex").acquisitions, 3u);
+}
+
+TEST(OffNominal, DumpError) {
+    U32 mutexes = 0;
+    ASSERT_FALSE(Utils::MutexProfile::dump("/does-not-exist/mutexes.csv", mutexes));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
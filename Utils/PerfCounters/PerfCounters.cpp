@@ -0,0 +1,122 @@
+// ======================================================================
+// \title  PerfCounters.cpp
+// \brief  cpp file for reading hardware performance counters of the calling thread
+// ======================================================================
+
+#include <Utils/PerfCounters/PerfCounters.hpp>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace Utils {
+
+PerfCounters::Sample PerfCounters::Sample::operator-(const Sample& earlier) const {
+    Sample difference;
+    difference.cycles = this->cycles - earlier.cycles;
+    difference.instructions = this->instructions - earlier.instructions;
+    difference.cacheMisses = this->cacheMisses - earlier.cacheMisses;
+    difference.branchMisses = this->branchMisses - earlier.branchMisses;
+    difference.timeEnabled = this->timeEnabled - earlier.timeEnabled;
+    difference.timeRunning = this->timeRunning - earlier.timeRunning;
+    return difference;
+}
+
+PerfCounters::Sample& PerfCounters::Sample::operator+=(const Sample& other) {
+    this->cycles = this->cycles + other.cycles;
+    this->instructions = this->instructions + other.instructions;
+    this->cacheMisses = this->cacheMisses + other.cacheMisses;
+    this->branchMisses = this->branchMisses + other.branchMisses;
+    this->timeEnabled = this->timeEnabled + other.timeEnabled;
+    this->timeRunning = this->timeRunning + other.timeRunning;
+    return *this;
+}
+
+bool PerfCounters::Sample::scale() {
+    if (this->timeRunning >= this->timeEnabled) {
+        return true;
+    }
+    if (0 == this->timeRunning) {
+        return false;
+    }
+    const F64 factor = static_cast<F64>(this->timeEnabled) / static_cast<F64>(this->timeRunning);
+    this->cycles = static_cast<U64>(static_cast<F64>(this->cycles) * factor);
+    this->instructions = static_cast<U64>(static_cast<F64>(this->instructions) * factor);
+    this->cacheMisses = static_cast<U64>(static_cast<F64>(this->cacheMisses) * factor);
+    this->branchMisses = static_cast<U64>(static_cast<F64>(this->branchMisses) * factor);
+    this->timeRunning = this->timeEnabled;
+    return true;
+}
+
+PerfCounters ::PerfCounters() {
+    for (U32 i = 0; i < COUNTERS; i++) {
+        this->m_fds[i] = -1;
+    }
+}
+
+PerfCounters ::~PerfCounters() {
+    this->close();
+}
+
+I32 PerfCounters ::open() {
+    this->close();
+    // Group order matches the fields of Sample
+    const U64 configs[COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+                                   PERF_COUNT_HW_BRANCH_MISSES};
+    for (U32 i = 0; i < COUNTERS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Calling thread on any CPU, the first counter leading the group
+        const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, (0 == i) ? -1 : this->m_fds[0], 0);
+        if (fd < 0) {
+            const I32 error = errno;
+            this->close();
+            return error;
+        }
+        this->m_fds[i] = static_cast<int>(fd);
+    }
+    return 0;
+}
+
+void PerfCounters ::close() {
+    // Members before the leader, which closes the group
+    for (U32 i = COUNTERS; i > 0; i--) {
+        if (this->m_fds[i - 1] >= 0) {
+            (void)::close(this->m_fds[i - 1]);
+            this->m_fds[i - 1] = -1;
+        }
+    }
+}
+
+bool PerfCounters ::isOpen() const {
+    return this->m_fds[0] >= 0;
+}
+
+bool PerfCounters ::read(Sample& sample) const {
+    if (!this->isOpen()) {
+        return false;
+    }
+    // Group layout: the number of counters, the times enabled and running, then each value in group order
+    U64 values[3 + COUNTERS];
+    if (::read(this->m_fds[0], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) {
+        return false;
+    }
+    sample.timeEnabled = values[1];
+    sample.timeRunning = values[2];
+    sample.cycles = values[3];
+    sample.instructions = values[4];
+    sample.cacheMisses = values[5];
+    sample.branchMisses = values[6];
+    return true;
+}
+
+}  // end namespace Utils
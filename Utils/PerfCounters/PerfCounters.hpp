@@ -0,0 +1,77 @@
+// ======================================================================
+// \title  PerfCounters.hpp
+// \brief  hpp file for reading hardware performance counters of the calling thread
+// ======================================================================
+
+#ifndef Utils_PerfCounters_HPP
+#define Utils_PerfCounters_HPP
+
+#include <FpConfig.hpp>
+
+namespace Utils {
+
+//! \class PerfCounters
+//! \brief CPU cycles, instructions, cache misses and branch misses of one thread, from perf_event_open
+//!
+//! The four counters are opened as one group on the thread calling open, counting in user space only so that the
+//! default perf_event_paranoid setting of 2 allows them, and are read together with one system call. Only that thread
+//! may read them. When other events compete for the PMU the kernel multiplexes the group, which then counts for only
+//! part of the time it is enabled: each sample carries both times so that its counts can be scaled.
+class PerfCounters {
+  public:
+    //! Counter values, accumulated since open or taken as a difference of two reads
+    struct Sample {
+        U64 cycles;        //!< CPU cycles
+        U64 instructions;  //!< Instructions retired
+        U64 cacheMisses;   //!< Last level cache misses
+        U64 branchMisses;  //!< Mispredicted branches
+        U64 timeEnabled;   //!< Nanoseconds the counters were enabled
+        U64 timeRunning;   //!< Nanoseconds the counters were counting, less than timeEnabled when multiplexed
+
+        //! Counts between an earlier sample and this one
+        Sample operator-(const Sample& earlier) const;
+
+        //! Add the counts of another sample
+        Sample& operator+=(const Sample& other);
+
+        //! Scale counts taken while multiplexed to the time the counters were enabled, estimating the counts had they
+        //! run throughout. Meant for a difference of two reads. Counts that ran throughout are unchanged.
+        //!
+        //! \return false when the counters did not run at all while enabled, so that no estimate can be made
+        bool scale();
+    };
+
+    PerfCounters();
+
+    //! Destroy the counters, closing them
+    //!
+    ~PerfCounters();
+
+    //! Open the counters on the calling thread, enabled and starting from zero
+    //!
+    //! \return 0 on success, otherwise the errno of the failed perf_event_open
+    I32 open();
+
+    //! Close the counters
+    //!
+    void close();
+
+    //! \return true when the counters are open
+    bool isOpen() const;
+
+    //! Read every counter
+    //!
+    //! \return true when the counters are open and were read
+    bool read(Sample& sample /*!< Out: counts since open*/
+    ) const;
+
+  PRIVATE:
+    //! Number of counters in the group
+    static const U32 COUNTERS = 4;
+
+    int m_fds[COUNTERS];  //!< Counter file descriptors, the first leading the group. -1 when closed.
+};
+
+}  // end namespace Utils
+
+#endif
@@ -0,0 +1,71 @@
+// ----------------------------------------------------------------------
+// PerfCountersBenchmark.cpp
+// ----------------------------------------------------------------------
+
+#include <Utils/PerfCounters/PerfCounters.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+//! Iterations of the loop whose counts are reported
+const U32 LOOP_ITERATIONS = 1000000;
+
+//! One operation is one read of the counter group, as the rate group takes around each cycle and member call
+void readCounters(benchmark::State& state) {
+    Utils::PerfCounters counters;
+    if (counters.open() != 0) {
+        state.SkipWithError("perf_event_open unavailable");
+        return;
+    }
+    Utils::PerfCounters::Sample sample;
+    for (auto _ : state) {
+        if (!counters.read(sample)) {
+            state.SkipWithError("read failed");
+            break;
+        }
+        benchmark::DoNotOptimize(sample);
+    }
+}
+
+//! One operation is a loop of LOOP_ITERATIONS additions, reporting its cycles, instructions and IPC as counted
+void countedLoop(benchmark::State& state) {
+    Utils::PerfCounters counters;
+    if (counters.open() != 0) {
+        state.SkipWithError("perf_event_open unavailable");
+        return;
+    }
+    Utils::PerfCounters::Sample total = {};
+    for (auto _ : state) {
+        Utils::PerfCounters::Sample before;
+        Utils::PerfCounters::Sample after;
+        if (!counters.read(before)) {
+            state.SkipWithError("read failed");
+            break;
+        }
+        U64 sum = 0;
+        for (U32 i = 0; i < LOOP_ITERATIONS; i++) {
+            benchmark::DoNotOptimize(sum += i);
+        }
+        if (!counters.read(after)) {
+            state.SkipWithError("read failed");
+            break;
+        }
+        Utils::PerfCounters::Sample loop = after - before;
+        if (loop.scale()) {
+            total += loop;
+        }
+    }
+    state.counters["cycles"] =
+        benchmark::Counter(static_cast<double>(total.cycles), benchmark::Counter::kAvgIterations);
+    state.counters["instructions"] =
+        benchmark::Counter(static_cast<double>(total.instructions), benchmark::Counter::kAvgIterations);
+    state.counters["IPC"] = (total.cycles > 0) ? static_cast<double>(total.instructions) / total.cycles : 0.0;
+}
+
+}  // namespace
+
+BENCHMARK(readCounters);
+BENCHMARK(countedLoop);
+
+BENCHMARK_MAIN();
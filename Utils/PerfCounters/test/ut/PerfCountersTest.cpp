@@ -0,0 +1,66 @@
+// ----------------------------------------------------------------------
+// PerfCountersTest.cpp
+// ----------------------------------------------------------------------
+
+#include <Utils/PerfCounters/PerfCounters.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(OffNominal, ClosedCountersAreNotRead) {
+    Utils::PerfCounters counters;
+    Utils::PerfCounters::Sample sample;
+    ASSERT_FALSE(counters.isOpen());
+    ASSERT_FALSE(counters.read(sample));
+}
+
+TEST(Nominal, MultiplexedCountsAreScaled) {
+    // Counted for a quarter of the time enabled
+    Utils::PerfCounters::Sample partial = {100, 400, 8, 4, 2000, 500};
+    ASSERT_TRUE(partial.scale());
+    ASSERT_EQ(partial.cycles, 400u);
+    ASSERT_EQ(partial.instructions, 1600u);
+    ASSERT_EQ(partial.cacheMisses, 32u);
+    ASSERT_EQ(partial.branchMisses, 16u);
+    ASSERT_EQ(partial.timeRunning, partial.timeEnabled);
+
+    // Counted throughout: unchanged
+    Utils::PerfCounters::Sample full = {100, 400, 8, 4, 2000, 2000};
+    ASSERT_TRUE(full.scale());
+    ASSERT_EQ(full.cycles, 100u);
+    ASSERT_EQ(full.instructions, 400u);
+}
+
+TEST(OffNominal, UnscheduledCountsAreNotScaled) {
+    Utils::PerfCounters::Sample idle = {0, 0, 0, 0, 2000, 0};
+    ASSERT_FALSE(idle.scale());
+}
+
+TEST(Nominal, CountersAdvanceWithWork) {
+    Utils::PerfCounters counters;
+    const I32 error = counters.open();
+    if (error != 0) {
+        GTEST_SKIP() << "perf_event_open unavailable, errno " << error;
+    }
+    Utils::PerfCounters::Sample before;
+    Utils::PerfCounters::Sample after;
+    ASSERT_TRUE(counters.read(before));
+    volatile U64 sum = 0;
+    for (U32 i = 0; i < 1000000; i++) {
+        sum = sum + i;
+    }
+    ASSERT_TRUE(counters.read(after));
+    Utils::PerfCounters::Sample work = after - before;
+    ASSERT_GT(work.timeEnabled, 0u);
+    ASSERT_TRUE(work.scale());
+    // Each iteration retires several instructions
+    ASSERT_GT(work.instructions, 1000000u);
+    ASSERT_GT(work.cycles, 0u);
+
+    counters.close();
+    ASSERT_FALSE(counters.isOpen());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,166 @@
+// ======================================================================
+// \title  PortRecorder.cpp
+// \brief  cpp file for recording and reading back component input port invocations
+// ======================================================================
+
+#include <Fw/Types/Assert.hpp>
+#include <Utils/PortRecorder/PortRecorder.hpp>
+
+#include <cstring>
+
+namespace Utils {
+
+// ----------------------------------------------------------------------
+// PortArgs
+// ----------------------------------------------------------------------
+
+NATIVE_UINT_TYPE PortArgs ::getBuffCapacity() const {
+    return sizeof(this->m_data);
+}
+
+U8* PortArgs ::getBuffAddr() {
+    return this->m_data;
+}
+
+const U8* PortArgs ::getBuffAddr() const {
+    return this->m_data;
+}
+
+// ----------------------------------------------------------------------
+// PortRecorder
+// ----------------------------------------------------------------------
+
+PortRecorder ::PortRecorder() : m_lock("PortRecorder.lock"), m_open(false), m_staged(0) {}
+
+PortRecorder ::~PortRecorder() {
+    this->close();
+}
+
+bool PortRecorder ::open(const char* fileName) {
+    FW_ASSERT(fileName != nullptr);
+    this->close();
+    this->m_lock.lock();
+    this->m_open = (Os::File::OP_OK == this->m_file.open(fileName, Os::File::OPEN_WRITE));
+    if (this->m_open) {
+        Fw::ExternalSerializeBuffer header(this->m_staging, sizeof(this->m_staging));
+        Fw::SerializeStatus status = header.serialize(MAGIC);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+        this->m_staged = header.getBuffLength();
+    }
+    this->m_lock.unLock();
+    return this->m_open;
+}
+
+void PortRecorder ::close() {
+    this->m_lock.lock();
+    if (this->m_open) {
+        this->flushLocked();
+        this->m_file.close();
+        this->m_open = false;
+    }
+    this->m_lock.unLock();
+}
+
+bool PortRecorder ::isOpen() const {
+    return this->m_open;
+}
+
+void PortRecorder ::record(U8 port, const Fw::Time& time, const PortArgs& args) {
+    const NATIVE_UINT_TYPE length = args.getBuffLength();
+    FW_ASSERT(length <= PortArgs::CAPACITY, length);
+
+    this->m_lock.lock();
+    if (this->m_open) {
+        if ((this->m_staged + RECORD_HEADER_SIZE + length) > sizeof(this->m_staging)) {
+            this->flushLocked();
+        }
+        Fw::ExternalSerializeBuffer record(this->m_staging + this->m_staged, sizeof(this->m_staging) - this->m_staged);
+        Fw::SerializeStatus status = record.serialize(port);
+        status = (Fw::FW_SERIALIZE_OK == status) ? record.serialize(time.getSeconds()) : status;
+        status = (Fw::FW_SERIALIZE_OK == status) ? record.serialize(time.getUSeconds()) : status;
+        status = (Fw::FW_SERIALIZE_OK == status) ? record.serialize(static_cast<U16>(length)) : status;
+        status = (Fw::FW_SERIALIZE_OK == status) ? record.serialize(args.getBuffAddr(), length, true) : status;
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+        this->m_staged += record.getBuffLength();
+    }
+    this->m_lock.unLock();
+}
+
+void PortRecorder ::flush() {
+    this->m_lock.lock();
+    if (this->m_open) {
+        this->flushLocked();
+    }
+    this->m_lock.unLock();
+}
+
+void PortRecorder ::flushLocked() {
+    NATIVE_INT_TYPE size = static_cast<NATIVE_INT_TYPE>(this->m_staged);
+    Os::File::Status status = this->m_file.write(this->m_staging, size);
+    // A failed write loses the staged records but recording continues
+    (void)status;
+    this->m_staged = 0;
+}
+
+// ----------------------------------------------------------------------
+// PortLogReader
+// ----------------------------------------------------------------------
+
+PortLogReader ::PortLogReader() {}
+
+PortLogReader ::~PortLogReader() {
+    this->close();
+}
+
+bool PortLogReader ::open(const char* fileName) {
+    FW_ASSERT(fileName != nullptr);
+    if (Os::File::OP_OK != this->m_file.open(fileName, Os::File::OPEN_READ)) {
+        return false;
+    }
+    U8 data[sizeof(U32)];
+    NATIVE_INT_TYPE size = sizeof(data);
+    Os::File::Status status = this->m_file.read(data, size);
+    U32 magic = 0;
+    Fw::ExternalSerializeBuffer header(data, sizeof(data));
+    header.setBuffLen(static_cast<NATIVE_UINT_TYPE>(size));
+    if ((Os::File::OP_OK != status) || (Fw::FW_SERIALIZE_OK != header.deserialize(magic)) ||
+        (PortRecorder::MAGIC != magic)) {
+        this->m_file.close();
+        return false;
+    }
+    return true;
+}
+
+void PortLogReader ::close() {
+    this->m_file.close();
+}
+
+bool PortLogReader ::next(U8& port, Fw::Time& time, PortArgs& args) {
+    U8 data[PortRecorder::RECORD_HEADER_SIZE];
+    NATIVE_INT_TYPE size = sizeof(data);
+    if ((Os::File::OP_OK != this->m_file.read(data, size)) || (sizeof(data) != static_cast<NATIVE_UINT_TYPE>(size))) {
+        return false;
+    }
+    U32 seconds = 0;
+    U32 useconds = 0;
+    U16 length = 0;
+    Fw::ExternalSerializeBuffer header(data, sizeof(data));
+    header.setBuffLen(sizeof(data));
+    Fw::SerializeStatus status = header.deserialize(port);
+    status = (Fw::FW_SERIALIZE_OK == status) ? header.deserialize(seconds) : status;
+    status = (Fw::FW_SERIALIZE_OK == status) ? header.deserialize(useconds) : status;
+    status = (Fw::FW_SERIALIZE_OK == status) ? header.deserialize(length) : status;
+    if ((Fw::FW_SERIALIZE_OK != status) || (length > PortArgs::CAPACITY)) {
+        return false;
+    }
+    time.set(seconds, useconds);
+
+    args.resetSer();
+    size = length;
+    if ((length > 0) && ((Os::File::OP_OK != this->m_file.read(args.getBuffAddr(), size)) || (size != length))) {
+        return false;
+    }
+    return (Fw::FW_SERIALIZE_OK == args.setBuffLen(length));
+}
+
+}  // end namespace Utils
@@ -0,0 +1,124 @@
+// ======================================================================
+// \title  PortRecorder.hpp
+// \brief  hpp file for recording and reading back component input port invocations
+// ======================================================================
+
+#ifndef Utils_PortRecorder_HPP
+#define Utils_PortRecorder_HPP
+
+#include <FpConfig.hpp>
+#include <Fw/Cmd/CmdArgBuffer.hpp>
+#include <Fw/Time/Time.hpp>
+#include <Fw/Types/Serializable.hpp>
+#include <Os/File.hpp>
+#include <Utils/MutexProfile/MutexProfile.hpp>
+
+namespace Utils {
+
+//! \class PortArgs
+//! \brief Serialization buffer holding the arguments of one recorded port invocation
+class PortArgs : public Fw::SerializeBufferBase {
+  public:
+    //! Largest serialized argument list that may be recorded: a full command argument buffer, with its length, opcode
+    //! and sequence number
+    static const NATIVE_UINT_TYPE CAPACITY = FW_CMD_ARG_BUFFER_MAX_SIZE + sizeof(FwBuffSizeType) + 2 * sizeof(U32);
+
+    NATIVE_UINT_TYPE getBuffCapacity() const override;
+    U8* getBuffAddr() override;
+    const U8* getBuffAddr() const override;
+
+  PRIVATE:
+    U8 m_data[CAPACITY];
+};
+
+//! \class PortRecorder
+//! \brief Appends port invocations to a compact binary log
+//!
+//! Each record holds the component-defined port identifier, the time of the invocation and the serialized port
+//! arguments. Records are staged in memory and written to the log when the staging buffer fills and on close, so that
+//! recording rarely touches the file system. Recording is safe from multiple threads.
+//!
+//! Log layout: a U32 MAGIC header, then records of U8 port, U32 seconds, U32 microseconds, U16 argument length and the
+//! argument bytes, all big-endian.
+class PortRecorder {
+  public:
+    //! Header identifying a port log
+    static const U32 MAGIC = 0x46505231;
+    //! Size of the record header preceding the arguments
+    static const NATIVE_UINT_TYPE RECORD_HEADER_SIZE = sizeof(U8) + 2 * sizeof(U32) + sizeof(U16);
+    //! Bytes staged in memory before being written to the log
+    static const NATIVE_UINT_TYPE STAGING_SIZE = 4096;
+
+    PortRecorder();
+
+    //! Destroy the recorder, closing the log
+    //!
+    ~PortRecorder();
+
+    //! Create the log, replacing any existing file
+    //!
+    //! \return true on success
+    bool open(const char* fileName /*!< Path of the log*/
+    );
+
+    //! Write staged records and close the log
+    //!
+    void close();
+
+    //! \return true when a log is open
+    bool isOpen() const;
+
+    //! Append a port invocation to the log
+    //!
+    void record(U8 port,                  /*!< Component-defined identifier of the port*/
+                const Fw::Time& time,     /*!< Time of the invocation*/
+                const PortArgs& args      /*!< Serialized port arguments*/
+    );
+
+    //! Write staged records to the log
+    //!
+    void flush();
+
+  PRIVATE:
+    //! Write staged records to the log. Caller holds m_lock.
+    void flushLocked();
+
+    NamedMutex m_lock;             //!< Protects the staging buffer and log
+    Os::File m_file;               //!< The log
+    bool m_open;                   //!< A log is open
+    U8 m_staging[STAGING_SIZE];    //!< Records not yet written
+    NATIVE_UINT_TYPE m_staged;     //!< Bytes in m_staging
+};
+
+//! \class PortLogReader
+//! \brief Reads back the records of a log written by PortRecorder
+class PortLogReader {
+  public:
+    PortLogReader();
+    ~PortLogReader();
+
+    //! Open a log and validate its header
+    //!
+    //! \return true when the file is a port log
+    bool open(const char* fileName /*!< Path of the log*/
+    );
+
+    //! Close the log
+    //!
+    void close();
+
+    //! Read the next record
+    //!
+    //! \return true when a record was read, false at the end of the log or on a truncated record
+    bool next(U8& port,         /*!< Out: identifier of the port*/
+              Fw::Time& time,   /*!< Out: time of the invocation*/
+              PortArgs& args    /*!< Out: serialized arguments, ready to deserialize*/
+    );
+
+  PRIVATE:
+    Os::File m_file;  //!< The log
+};
+
+}  // end namespace Utils
+
+#endif
@@ -0,0 +1,253 @@
+// ======================================================================
+// \title  PortTrace.cpp
+// \brief  cpp file for a timeline of port calls viewable in Chrome and Perfetto trace viewers
+// ======================================================================
+
+#include <Utils/PortTrace/PortTrace.hpp>
+#include <Os/File.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdio>
+
+namespace Utils {
+namespace PortTrace {
+
+static_assert((THREAD_EVENTS & (THREAD_EVENTS - 1)) == 0, "THREAD_EVENTS must be a power of two");
+
+namespace {
+
+#if LEDBLINKER_PORT_TRACE
+//! Storage of one event. The sequence is odd while the slot is being written.
+struct Slot {
+    std::atomic<U64> sequence;
+    std::atomic<U64> timestamp;  //!< Counter ticks when the event was recorded
+    std::atomic<const char*> name;
+    std::atomic<U32> arg;
+};
+
+//! States of a ring
+enum RingState : U32 {
+    RING_FREE,      //!< Never claimed
+    RING_CLAIMING,  //!< Being handed to a thread
+    RING_OWNED,     //!< Recording the events of a live thread
+    RING_RELEASED,  //!< Owner exited. Its events are dumped until another thread reuses the ring.
+};
+
+//! Events of one thread. Only the owning thread writes, so claiming a slot needs no atomic increment.
+struct Ring {
+    std::atomic<U32> state;     //!< RingState, owned or released once the owner's id and name are written
+    U32 tid;                    //!< Kernel id of the owning thread
+    char threadName[16];        //!< Name of the owning thread
+    std::atomic<U64> next;      //!< Sequence number of the next event
+    Slot slots[THREAD_EVENTS];  //!< Ring storage
+};
+
+//! Monotonic time in nanoseconds
+U64 monotonicNs() {
+    struct timespec now;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (static_cast<U64>(now.tv_sec) * 1000000000) + static_cast<U64>(now.tv_nsec);
+}
+
+//! Free-running counter timestamping events. Cheaper than clock_gettime; converted to nanoseconds when dumped.
+inline U64 readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    U64 ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return monotonicNs();
+#endif
+}
+
+//! Counter and monotonic time read together, relating the two
+struct Anchor {
+    U64 ticks;
+    U64 ns;
+    Anchor() : ticks(readTicks()), ns(monotonicNs()) {}
+};
+
+const Anchor start;
+Ring rings[MAX_THREADS];
+std::atomic<U32> ringsUsed(0);
+thread_local Ring* threadRing = nullptr;
+thread_local bool threadDropped = false;
+
+//! Releases the ring of a thread when the thread exits, so that short-lived threads do not use up the pool
+struct RingOwner {
+    Ring* ring = nullptr;
+    ~RingOwner() {
+        if (this->ring != nullptr) {
+            this->ring->state.store(RING_RELEASED, std::memory_order_release);
+        }
+    }
+};
+thread_local RingOwner threadOwner;
+
+//! Take a ring for the calling thread: one never used, else the ring of a thread that has exited
+Ring* takeRing() {
+    const U32 index = ringsUsed.fetch_add(1, std::memory_order_relaxed);
+    if (index < MAX_THREADS) {
+        rings[index].state.store(RING_CLAIMING, std::memory_order_relaxed);
+        return &rings[index];
+    }
+    for (U32 i = 0; i < MAX_THREADS; i++) {
+        U32 state = RING_RELEASED;
+        if (rings[i].state.compare_exchange_strong(state, RING_CLAIMING, std::memory_order_acq_rel)) {
+            return &rings[i];
+        }
+    }
+    return nullptr;
+}
+
+//! Ring of the calling thread, claimed on first use. nullptr when every ring is held by a live thread.
+Ring* getRing() {
+    if ((threadRing == nullptr) && !threadDropped) {
+        Ring* ring = takeRing();
+        if (ring == nullptr) {
+            threadDropped = true;
+            return nullptr;
+        }
+        // The events of a previous owner are dropped with the ring
+        ring->next.store(0, std::memory_order_relaxed);
+        ring->tid = static_cast<U32>(syscall(SYS_gettid));
+        ring->threadName[0] = '\0';
+        (void)pthread_getname_np(pthread_self(), ring->threadName, sizeof(ring->threadName));
+        ring->state.store(RING_OWNED, std::memory_order_release);
+        threadRing = ring;
+        threadOwner.ring = ring;
+    }
+    return threadRing;
+}
+
+void record(const char* name, U32 arg) {
+    Ring* ring = getRing();
+    if (ring == nullptr) {
+        return;
+    }
+    const U64 ticks = readTicks();
+    const U64 sequence = ring->next.load(std::memory_order_relaxed);
+    Slot& slot = ring->slots[sequence & (THREAD_EVENTS - 1)];
+
+    // Slot sequence is 2n + 1 while event n is written and 2n + 2 once it is complete
+    slot.sequence.store((2 * sequence) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp.store(ticks, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.arg.store(arg, std::memory_order_relaxed);
+    slot.sequence.store((2 * sequence) + 2, std::memory_order_release);
+    ring->next.store(sequence + 1, std::memory_order_release);
+}
+#endif
+
+bool writeText(Os::File& file, const char* text, NATIVE_INT_TYPE length) {
+    return (length > 0) && (Os::File::OP_OK == file.write(text, length));
+}
+
+}  // namespace
+
+void begin(const char* name, U32 arg) {
+#if LEDBLINKER_PORT_TRACE
+    record(name, arg);
+#else
+    static_cast<void>(name);
+    static_cast<void>(arg);
+#endif
+}
+
+void end() {
+#if LEDBLINKER_PORT_TRACE
+    // A null name marks the end of the call begun last
+    record(nullptr, 0);
+#endif
+}
+
+bool isEnabled() {
+#if LEDBLINKER_PORT_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool dump(const char* fileName, U32& events) {
+    events = 0;
+    Os::File file;
+    if (Os::File::OP_OK != file.open(fileName, Os::File::OPEN_WRITE)) {
+        return false;
+    }
+
+    bool ok = writeText(file, "{\"traceEvents\":[\n", 17);
+#if LEDBLINKER_PORT_TRACE
+    // Counter ticks are scaled to nanoseconds by their rate since the process started
+    const Anchor now;
+    const F64 nsPerTick =
+        (now.ticks > start.ticks) ? (static_cast<F64>(now.ns - start.ns) / (now.ticks - start.ticks)) : 1.0;
+
+    const unsigned int pid = static_cast<unsigned int>(getpid());
+    bool first = true;
+    const U32 threads = ringsUsed.load(std::memory_order_acquire);
+    for (U32 i = 0; ok && (i < threads) && (i < MAX_THREADS); i++) {
+        const Ring& ring = rings[i];
+        const U32 state = ring.state.load(std::memory_order_acquire);
+        if ((RING_OWNED != state) && (RING_RELEASED != state)) {
+            continue;
+        }
+        char row[160];
+        NATIVE_INT_TYPE length = snprintf(row, sizeof(row),
+                                          "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,"
+                                          "\"args\":{\"name\":\"%s\"}}",
+                                          first ? "" : ",\n", pid, ring.tid, ring.threadName);
+        ok = writeText(file, row, length);
+        first = false;
+
+        // Only the most recent THREAD_EVENTS events are retained
+        const U64 total = ring.next.load(std::memory_order_acquire);
+        const U64 oldest = (total > THREAD_EVENTS) ? (total - THREAD_EVENTS) : 0;
+        for (U64 sequence = oldest; ok && (sequence < total); sequence++) {
+            const Slot& slot = ring.slots[sequence & (THREAD_EVENTS - 1)];
+            const U64 complete = (2 * sequence) + 2;
+            if (slot.sequence.load(std::memory_order_acquire) != complete) {
+                continue;
+            }
+            const U64 ticks = slot.timestamp.load(std::memory_order_relaxed);
+            const char* name = slot.name.load(std::memory_order_relaxed);
+            const U32 arg = slot.arg.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != complete) {
+                continue;
+            }
+            // Timestamps are in microseconds, kept to the nanosecond
+            const U64 timestamp = start.ns + static_cast<U64>(static_cast<F64>(ticks - start.ticks) * nsPerTick);
+            const unsigned long long usec = static_cast<unsigned long long>(timestamp / 1000);
+            const unsigned int nsec = static_cast<unsigned int>(timestamp % 1000);
+            if (name != nullptr) {
+                length = snprintf(row, sizeof(row),
+                                  ",\n{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%llu.%03u,\"pid\":%u,\"tid\":%u,"
+                                  "\"args\":{\"arg\":%u}}",
+                                  name, usec, nsec, pid, ring.tid, arg);
+            } else {
+                length = snprintf(row, sizeof(row), ",\n{\"ph\":\"E\",\"ts\":%llu.%03u,\"pid\":%u,\"tid\":%u}", usec,
+                                  nsec, pid, ring.tid);
+            }
+            ok = writeText(file, row, length);
+            events++;
+        }
+    }
+#endif
+    ok = ok && writeText(file, "\n]}\n", 4);
+    file.close();
+    return ok;
+}
+
+}  // end namespace PortTrace
+}  // end namespace Utils
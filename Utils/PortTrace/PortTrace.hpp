@@ -0,0 +1,73 @@
+// ======================================================================
+// \title  PortTrace.hpp
+// \brief  hpp file for a timeline of port calls viewable in Chrome and Perfetto trace viewers
+// ======================================================================
+
+#ifndef Utils_PortTrace_HPP
+#define Utils_PortTrace_HPP
+
+#include <FpConfig.hpp>
+
+namespace Utils {
+
+//! \namespace PortTrace
+//! \brief Timeline of port handler calls, written as Chrome trace JSON
+//!
+//! Each thread appends begin and end events to a ring of its own, claimed on its first event from a fixed pool, so
+//! recording takes no lock and no allocation. A ring returns to the pool when its thread exits; its events are dumped
+//! until another thread claims it. Events are stamped with the CPU's free-running counter (TSC, or CNTVCT on
+//! Arm) and scaled to nanoseconds when dumped. Once a ring is full its oldest events are overwritten. dump writes every
+//! ring as a Chrome trace JSON file, which Perfetto (ui.perfetto.dev) and chrome://tracing both open.
+//!
+//! Handlers are instrumented with the PORT_TRACE_* macros, which only record when built with LEDBLINKER_PORT_TRACE
+//! defined and otherwise compile to nothing. Without it the rings are not built either: begin and end do nothing and
+//! dump writes a trace without events.
+namespace PortTrace {
+
+//! Events retained per thread, a power of two
+static const U32 THREAD_EVENTS = 4096;
+//! Threads that may record at once. Events of any further thread are dropped.
+static const U32 MAX_THREADS = 32;
+
+//! Record the start of a call on the calling thread
+//!
+void begin(const char* name, /*!< Name of the call. Must outlive the trace, e.g. a string literal.*/
+           U32 arg           /*!< Value shown with the call, such as a port number*/
+);
+
+//! Record the end of the call last begun on the calling thread
+//!
+void end();
+
+//! Records a call from construction to destruction
+class Scope {
+  public:
+    Scope(const char* name, U32 arg) { begin(name, arg); }
+    ~Scope() { end(); }
+};
+
+//! \return true when handlers are instrumented in this build
+bool isEnabled();
+
+//! Write the events of every thread to a Chrome trace JSON file. Threads keep recording while the dump runs; events
+//! overwritten while being read are skipped.
+//!
+//! \return true when the file was written
+bool dump(const char* fileName, /*!< Path of the file written*/
+          U32& events           /*!< Out: number of events written*/
+);
+
+}  // end namespace PortTrace
+}  // end namespace Utils
+
+#if LEDBLINKER_PORT_TRACE
+#define PORT_TRACE_SCOPE(name, arg) Utils::PortTrace::Scope portTraceScope(name, arg)
+#define PORT_TRACE_BEGIN(name, arg) Utils::PortTrace::begin(name, arg)
+#define PORT_TRACE_END() Utils::PortTrace::end()
+#else
+#define PORT_TRACE_SCOPE(name, arg) static_cast<void>(0)
+#define PORT_TRACE_BEGIN(name, arg) static_cast<void>(0)
+#define PORT_TRACE_END() static_cast<void>(0)
+#endif
+
+#endif
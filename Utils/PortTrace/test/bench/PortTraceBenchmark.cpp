@@ -0,0 +1,23 @@
+// ----------------------------------------------------------------------
+// PortTraceBenchmark.cpp
+// ----------------------------------------------------------------------
+
+#include <Utils/PortTrace/PortTrace.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+//! One operation is the begin and end events of one traced call, as PORT_TRACE_SCOPE records them
+void tracedCall(benchmark::State& state) {
+    U32 arg = 0;
+    for (auto _ : state) {
+        Utils::PortTrace::Scope scope("bench.tracedCall", arg++);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(tracedCall);
+
+BENCHMARK_MAIN();
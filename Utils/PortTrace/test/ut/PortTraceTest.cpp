@@ -0,0 +1,136 @@
+// ----------------------------------------------------------------------
+// PortTraceTest.cpp
+// ----------------------------------------------------------------------
+
+#include <Utils/PortTrace/PortTrace.hpp>
+#include <Utils/TestFile/TestFile.hpp>
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace {
+//! Contents of a file, empty when it cannot be read
+std::string readFile(const char* fileName) {
+    std::string contents;
+    FILE* file = fopen(fileName, "r");
+    if (file != nullptr) {
+        char buffer[4096];
+        size_t read = 0;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            contents.append(buffer, read);
+        }
+        (void)fclose(file);
+    }
+    return contents;
+}
+
+//! Occurrences of text in contents
+U32 count(const std::string& contents, const char* text) {
+    U32 found = 0;
+    for (size_t at = contents.find(text); at != std::string::npos; at = contents.find(text, at + 1)) {
+        found++;
+    }
+    return found;
+}
+}  // namespace
+
+TEST(Nominal, NestedCallsOnTwoThreads) {
+    if (!Utils::PortTrace::isEnabled()) {
+        GTEST_SKIP() << "Built without LEDBLINKER_PORT_TRACE, so no events are recorded";
+    }
+    {
+        Utils::PortTrace::Scope outer("test.outer", 1);
+        Utils::PortTrace::Scope inner("test.inner", 2);
+    }
+    std::thread worker([]() {
+        (void)pthread_setname_np(pthread_self(), "TraceWorker");
+        Utils::PortTrace::begin("test.worker", 3);
+        Utils::PortTrace::end();
+    });
+    worker.join();
+
+    const Utils::TestFile dumpFile("PortTraceNested.json");
+
+    const char* const dump = dumpFile.get();
+    U32 events = 0;
+    ASSERT_TRUE(Utils::PortTrace::dump(dump, events));
+    ASSERT_GE(events, 6u);
+    const std::string contents = readFile(dump);
+    ASSERT_EQ(contents.compare(0, 15, "{\"traceEvents\":"), 0);
+    ASSERT_EQ(contents.compare(contents.size() - 4, 4, "\n]}\n"), 0);
+    ASSERT_EQ(count(contents, "\"name\":\"test.outer\",\"ph\":\"B\""), 1u);
+    ASSERT_EQ(count(contents, "\"name\":\"test.inner\",\"ph\":\"B\""), 1u);
+    ASSERT_EQ(count(contents, "\"name\":\"test.worker\",\"ph\":\"B\""), 1u);
+    ASSERT_EQ(count(contents, "\"args\":{\"name\":\"TraceWorker\"}"), 1u);
+    ASSERT_EQ(count(contents, "\"ph\":\"B\""), count(contents, "\"ph\":\"E\""));
+}
+
+TEST(Nominal, FullRingKeepsNewestEvents) {
+    if (!Utils::PortTrace::isEnabled()) {
+        GTEST_SKIP() << "Built without LEDBLINKER_PORT_TRACE, so no events are recorded";
+    }
+    std::thread worker([]() {
+        for (U32 i = 0; i < Utils::PortTrace::THREAD_EVENTS; i++) {
+            Utils::PortTrace::Scope scope("test.wrap", i);
+        }
+    });
+    worker.join();
+
+    const Utils::TestFile dumpFile("PortTraceWrap.json");
+
+    const char* const dump = dumpFile.get();
+    U32 events = 0;
+    ASSERT_TRUE(Utils::PortTrace::dump(dump, events));
+    const std::string contents = readFile(dump);
+    // Twice as many events were recorded as retained: only the second half of the calls remain
+    ASSERT_EQ(count(contents, "\"name\":\"test.wrap\""), Utils::PortTrace::THREAD_EVENTS / 2);
+    ASSERT_EQ(count(contents, "\"args\":{\"arg\":0}"), 0u);
+}
+
+TEST(Nominal, ExitedThreadsReleaseRings) {
+    if (!Utils::PortTrace::isEnabled()) {
+        GTEST_SKIP() << "Built without LEDBLINKER_PORT_TRACE, so no events are recorded";
+    }
+    // Twice as many threads as rings, one after another: each exits before the next starts, so every one records
+    for (U32 i = 0; i < (2 * Utils::PortTrace::MAX_THREADS); i++) {
+        std::thread worker([i]() { Utils::PortTrace::Scope scope("test.shortLived", i); });
+        worker.join();
+    }
+
+    const Utils::TestFile dumpFile("PortTraceRelease.json");
+    const char* const dump = dumpFile.get();
+    U32 events = 0;
+    ASSERT_TRUE(Utils::PortTrace::dump(dump, events));
+    const std::string contents = readFile(dump);
+    const std::string last = "\"args\":{\"arg\":" + std::to_string((2 * Utils::PortTrace::MAX_THREADS) - 1) + "}";
+    ASSERT_EQ(count(contents, last.c_str()), 1u);
+}
+
+TEST(Nominal, DisabledDumpIsEmpty) {
+    if (Utils::PortTrace::isEnabled()) {
+        GTEST_SKIP() << "Built with LEDBLINKER_PORT_TRACE";
+    }
+    Utils::PortTrace::begin("test.disabled", 1);
+    Utils::PortTrace::end();
+    const Utils::TestFile dumpFile("PortTraceDisabled.json");
+    const char* const dump = dumpFile.get();
+    U32 events = 1;
+    ASSERT_TRUE(Utils::PortTrace::dump(dump, events));
+    ASSERT_EQ(events, 0u);
+    ASSERT_EQ(readFile(dump), "{\"traceEvents\":[\n\n]}\n");
+}
+
+TEST(OffNominal, DumpToMissingDirectoryFails) {
+    U32 events = 1;
+    ASSERT_FALSE(Utils::PortTrace::dump("/does-not-exist/trace.json", events));
+    ASSERT_EQ(events, 0u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
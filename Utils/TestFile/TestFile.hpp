@@ -0,0 +1,54 @@
+// ======================================================================
+// \title  TestFile.hpp
+// \brief  hpp file for files written by unit tests, kept out of the working directory
+// ======================================================================
+
+#ifndef Utils_TestFile_HPP
+#define Utils_TestFile_HPP
+
+#include <FpConfig.hpp>
+
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace Utils {
+
+//! \class TestFile
+//! \brief Path of a file written by a unit test, in a directory of its own under /tmp, removed with the object
+//!
+//! The directory has a short fixed prefix rather than following TMPDIR so that the path fits a command string
+//! argument (FW_CMD_STRING_MAX_SIZE, 40 characters by default) for names of up to 24 characters. Being a local of the
+//! test, the file is removed however the test ends, including on a failed assertion.
+class TestFile {
+  public:
+    explicit TestFile(const char* name /*!< File name, without a directory*/
+    ) {
+        char directory[] = "/tmp/lbXXXXXX";
+        this->ownDirectory = (mkdtemp(directory) != nullptr);
+        (void)snprintf(this->path, sizeof(this->path), "%s/%s", this->ownDirectory ? directory : "/tmp", name);
+    }
+
+    ~TestFile() {
+        (void)remove(this->path);
+        if (this->ownDirectory) {
+            *strrchr(this->path, '/') = '\0';
+            (void)rmdir(this->path);
+        }
+    }
+
+    TestFile(const TestFile&) = delete;
+    TestFile& operator=(const TestFile&) = delete;
+
+    //! \return path of the file
+    const char* get() const { return this->path; }
+
+  private:
+    char path[256];     //!< Path of the file
+    bool ownDirectory;  //!< Flag: if true the file is in a directory created for it
+};
+
+}  // end namespace Utils
+
+#endif